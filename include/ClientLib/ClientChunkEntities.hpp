@@ -11,6 +11,8 @@
 #include <CommonLib/ChunkEntities.hpp>
 #include <Nazara/Core/Color.hpp>
 #include <tsl/hopscotch_map.h>
+#include <tsl/hopscotch_set.h>
+#include <optional>
 
 namespace Nz
 {
@@ -40,6 +42,8 @@ namespace tsom
 			ClientChunkEntities(ClientChunkEntities&&) = delete;
 			~ClientChunkEntities() = default;
 
+			void Update() override;
+
 			ClientChunkEntities& operator=(const ClientChunkEntities&) = delete;
 			ClientChunkEntities& operator=(ClientChunkEntities&&) = delete;
 
@@ -48,12 +52,28 @@ namespace tsom
 			{
 				std::shared_ptr<Nz::Collider3D> collider;
 				std::shared_ptr<Nz::Mesh> mesh;
+				Nz::EnumArray<Direction, DirectionMask> faceConnectivity;
+				bool updateCollider;
 			};
 
-			std::shared_ptr<Nz::Mesh> BuildMesh(const Chunk& chunk);
+			std::shared_ptr<Nz::Mesh> BuildMesh(const Chunk& chunk, const Chunk::Snapshot& snapshot, unsigned int lodLevel);
+			std::optional<Nz::Vector3f> ComputeCameraPosition() const;
+			unsigned int ComputeLodLevel(const ChunkIndices& chunkIndices, unsigned int currentLodLevel) const;
 			ColliderModelUpdateJob* ProcessChunkUpdate(const Chunk& chunk, DirectionMask neighborMask) override;
+			ColliderModelUpdateJob* StartChunkUpdate(const Chunk& chunk, DirectionMask neighborMask, bool updateCollider);
 			void UpdateChunkDebugCollider(const ChunkIndices& chunkIndices);
+			void UpdateLodLevels(const Nz::Vector3f& cameraPosition);
+			void UpdateVisibility(const std::optional<Nz::Vector3f>& cameraPosition);
+
+			static constexpr float LodDistance = 128.f; //< chunks further than this are meshed at LOD 1, distance doubles for each level
+			static constexpr float LodUpdateDistance = 8.f;
+			static constexpr unsigned int MaxLodLevel = 3; //< 8x8x8 blocks cells
 
+			tsl::hopscotch_map<ChunkIndices, Nz::EnumArray<Direction, DirectionMask>> m_chunkFaceConnectivity;
+			tsl::hopscotch_map<ChunkIndices, unsigned int> m_chunkLodLevels;
+			tsl::hopscotch_set<ChunkIndices> m_hiddenChunks; //< chunks whose graphics component is currently hidden
+			tsl::hopscotch_set<ChunkIndices> m_visibleChunks;
+			std::optional<Nz::Vector3f> m_lodOrigin;
 			std::shared_ptr<Nz::MaterialInstance> m_chunkMaterial;
 			std::shared_ptr<Nz::VertexDeclaration> m_chunkVertexDeclaration;
 	};
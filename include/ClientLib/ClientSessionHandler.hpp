@@ -56,6 +56,7 @@ namespace tsom
 			void HandlePacket(Packets::DebugDrawLineList&& debugDrawLineList);
 			void HandlePacket(Packets::EntitiesCreation&& entitiesCreation);
 			void HandlePacket(Packets::EntitiesDelete&& entitiesDelete);
+			void HandlePacket(Packets::EntitiesPropertyUpdate&& propertyUpdate);
 			void HandlePacket(Packets::EntitiesStateUpdate&& stateUpdate);
 			void HandlePacket(Packets::EntityEnvironmentUpdate&& environmentUpdate);
 			void HandlePacket(Packets::EntityProcedureCall&& procedureCall);
@@ -64,6 +65,7 @@ namespace tsom
 			void HandlePacket(Packets::EnvironmentDestroy&& envDestroy);
 			void HandlePacket(Packets::EnvironmentUpdate&& envUpdate);
 			void HandlePacket(Packets::GameData&& gameData);
+			void HandlePacket(Packets::InputAck&& inputAck);
 			void HandlePacket(Packets::NetworkStrings&& networkStrings);
 			void HandlePacket(Packets::PlayerJoin&& playerJoin);
 			void HandlePacket(Packets::PlayerLeave&& playerLeave);
@@ -76,6 +78,7 @@ namespace tsom
 			NazaraSignal(OnChatMessage, const std::string& /*message*/);
 			NazaraSignal(OnControlledEntityChanged, entt::handle /*newEntity*/);
 			NazaraSignal(OnControlledEntityStateUpdate, InputIndex /*lastInputIndex*/, const Packets::EntitiesStateUpdate::ControlledCharacter& /*characterData*/);
+			NazaraSignal(OnInputAcknowledged, InputIndex /*lastInputIndex*/);
 			NazaraSignal(OnPlayerChatMessage, const std::string& /*message*/, const PlayerInfo& /*playerInfo*/);
 			NazaraSignal(OnPlayerJoined, const PlayerInfo& /*playerInfo*/);
 			NazaraSignal(OnPlayerLeave, const PlayerInfo& /*playerInfo*/);
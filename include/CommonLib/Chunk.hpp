@@ -9,6 +9,7 @@
 
 #include <CommonLib/Export.hpp>
 #include <CommonLib/BlockIndex.hpp>
+#include <CommonLib/ChunkBlocks.hpp>
 #include <CommonLib/Direction.hpp>
 #include <Nazara/Core/Color.hpp>
 #include <Nazara/Math/Matrix4.hpp>
@@ -19,7 +20,6 @@
 #include <NazaraUtils/SparsePtr.hpp>
 #include <memory>
 #include <optional>
-#include <shared_mutex>
 #include <vector>
 
 namespace Nz
@@ -41,6 +41,7 @@ namespace tsom
 	{
 		public:
 			struct HitBlock;
+			struct Snapshot;
 			struct VertexAttributes;
 
 			inline Chunk(const BlockLibrary& blockLibrary, ChunkContainer& owner, const ChunkIndices& indices, const Nz::Vector3ui& size, float blockSize);
@@ -49,9 +50,10 @@ namespace tsom
 			virtual ~Chunk();
 
 			virtual std::pair<std::shared_ptr<Nz::Collider3D>, Nz::Vector3f> BuildBlockCollider(const Nz::Vector3ui& blockIndices, float scale = 1.f) const = 0;
-			virtual std::shared_ptr<Nz::Collider3D> BuildCollider() const = 0;
-			virtual void BuildMesh(std::vector<Nz::UInt32>& indices, const Nz::Vector3f& center, const Nz::FunctionRef<VertexAttributes(const Nz::Vector3ui& blockIndices, Direction direction)>& addFace) const;
+			virtual std::shared_ptr<Nz::Collider3D> BuildCollider(const Snapshot& snapshot) const = 0;
+			virtual void BuildMesh(const Snapshot& snapshot, unsigned int lodLevel, std::vector<Nz::UInt32>& indices, const Nz::Vector3f& center, const Nz::FunctionRef<VertexAttributes(const Nz::Vector3ui& blockIndices, Direction direction)>& addFace) const;
 
+			Nz::EnumArray<Direction, DirectionMask> ComputeFaceConnectivity(const Snapshot& snapshot) const;
 			virtual std::optional<HitBlock> ComputeHitCoordinates(const Nz::Vector3f& hitPos, const Nz::Vector3f& hitNormal, const Nz::Collider3D& collider, std::uint32_t hitSubshapeId) const = 0;
 			virtual Nz::EnumArray<Nz::BoxCorner, Nz::Vector3f> ComputeVoxelCorners(const Nz::Vector3ui& indices) const;
 
@@ -67,6 +69,7 @@ namespace tsom
 			inline BlockIndex GetBlockContent(unsigned int blockIndex) const;
 			inline BlockIndex GetBlockContent(const Nz::Vector3ui& indices) const;
 			inline std::size_t GetBlockCount() const;
+			inline std::shared_ptr<const ChunkBlocks> GetBlocks() const;
 			inline float GetBlockSize() const;
 			inline ChunkContainer& GetContainer();
 			inline const ChunkContainer& GetContainer() const;
@@ -77,16 +80,12 @@ namespace tsom
 			inline bool HasContent() const;
 			inline bool HasPerFaceCollisions() const;
 
-			inline void LockRead() const;
-			inline void LockWrite();
-
 			inline void Reset();
 			template<typename F> void Reset(F&& func);
 
 			virtual void Serialize(Nz::ByteStream& byteStream) const;
 
-			inline void UnlockRead() const;
-			inline void UnlockWrite();
+			Snapshot TakeSnapshot() const;
 
 			void UpdateBlock(const Nz::Vector3ui& indices, BlockIndex cellType);
 
@@ -102,6 +101,13 @@ namespace tsom
 				Nz::Vector3ui blockIndices;
 			};
 
+			// Blocks of a chunk and its neighbors at a given time, which can be read from any thread without locking
+			struct Snapshot
+			{
+				std::shared_ptr<const ChunkBlocks> blocks;
+				Nz::EnumArray<Direction, std::shared_ptr<const ChunkBlocks>> neighborBlocks;
+			};
+
 			struct VertexAttributes
 			{
 				Nz::UInt32 firstIndex;
@@ -113,13 +119,12 @@ namespace tsom
 			};
 
 		protected:
+			inline ChunkBlocks& EditBlocks();
 			void OnChunkReset();
 			inline void SetPerFaceCollision();
 
-			mutable std::shared_mutex m_mutex;
-			std::vector<BlockIndex> m_blocks;
+			std::shared_ptr<ChunkBlocks> m_blocks;
 			std::vector<Nz::UInt16> m_blockTypeCount;
-			Nz::Bitset<Nz::UInt64> m_collisionCellMask;
 			Nz::Vector3ui m_size;
 			ChunkIndices m_indices;
 			const BlockLibrary& m_blockLibrary;
@@ -2,6 +2,7 @@
 // This file is part of the "This Space Of Mine" project
 // For conditions of distribution and use, see copyright notice in LICENSE
 
+#include <atomic>
 #include <cassert>
 
 namespace tsom
@@ -18,8 +19,8 @@ namespace tsom
 
 	inline const Nz::Bitset<Nz::UInt64>& Chunk::GetCollisionCellMask() const
 	{
-		NazaraAssertMsg(!m_blocks.empty(), "chunk has not been reset");
-		return m_collisionCellMask;
+		NazaraAssertMsg(m_blocks, "chunk has not been reset");
+		return m_blocks->GetCollisionCellMask();
 	}
 
 	inline unsigned int Chunk::GetBlockLocalIndex(const Nz::Vector3ui& indices) const
@@ -43,8 +44,8 @@ namespace tsom
 
 	inline BlockIndex Chunk::GetBlockContent(unsigned int blockIndex) const
 	{
-		NazaraAssertMsg(!m_blocks.empty(), "chunk has not been reset");
-		return m_blocks[blockIndex];
+		NazaraAssertMsg(m_blocks, "chunk has not been reset");
+		return m_blocks->GetBlockContent(blockIndex);
 	}
 
 	inline BlockIndex Chunk::GetBlockContent(const Nz::Vector3ui& indices) const
@@ -54,8 +55,14 @@ namespace tsom
 
 	inline std::size_t Chunk::GetBlockCount() const
 	{
-		NazaraAssertMsg(!m_blocks.empty(), "chunk has not been reset");
-		return m_blocks.size();
+		NazaraAssertMsg(m_blocks, "chunk has not been reset");
+		return m_blocks->GetBlockCount();
+	}
+
+	inline std::shared_ptr<const ChunkBlocks> Chunk::GetBlocks() const
+	{
+		// Once shared, blocks will be copied by the next modification instead of being modified in place
+		return m_blocks;
 	}
 
 	inline float Chunk::GetBlockSize() const
@@ -75,8 +82,8 @@ namespace tsom
 
 	inline const BlockIndex* Chunk::GetContent() const
 	{
-		NazaraAssertMsg(!m_blocks.empty(), "chunk has not been reset");
-		return m_blocks.data();
+		NazaraAssertMsg(m_blocks, "chunk has not been reset");
+		return m_blocks->GetContent();
 	}
 
 	inline const ChunkIndices& Chunk::GetIndices() const
@@ -91,7 +98,7 @@ namespace tsom
 
 	inline bool Chunk::HasContent() const
 	{
-		return !m_blocks.empty();
+		return m_blocks != nullptr;
 	}
 
 	inline bool Chunk::HasPerFaceCollisions() const
@@ -101,14 +108,12 @@ namespace tsom
 
 	inline void Chunk::Reset()
 	{
-		m_blocks.clear();
-		m_blocks.resize(m_size.x * m_size.y * m_size.z, EmptyBlockIndex);
-
-		m_collisionCellMask.Clear();
-		m_collisionCellMask.Resize(m_blocks.size(), false);
+		// Don't bother copying blocks which are going to be replaced
+		m_blocks = std::make_shared<ChunkBlocks>(m_size);
 
+		m_blockTypeCount.clear();
 		m_blockTypeCount.resize(EmptyBlockIndex + 1);
-		m_blockTypeCount[EmptyBlockIndex] = m_blocks.size();
+		m_blockTypeCount[EmptyBlockIndex] = m_blocks->GetBlockCount();
 	}
 
 	template<typename F>
@@ -117,34 +122,26 @@ namespace tsom
 		// Chunks don't have any block until they are reset
 		if (!HasContent())
 		{
-			m_blocks.resize(m_size.x * m_size.y * m_size.z, EmptyBlockIndex);
-			m_collisionCellMask.Resize(m_blocks.size(), false),
+			m_blocks = std::make_shared<ChunkBlocks>(m_size);
 			m_blockTypeCount.resize(EmptyBlockIndex + 1);
-			m_blockTypeCount[EmptyBlockIndex] = m_blocks.size();
+			m_blockTypeCount[EmptyBlockIndex] = m_blocks->GetBlockCount();
 		}
 
-		func(m_blocks.data());
+		func(EditBlocks().m_blocks.data());
 		OnChunkReset();
 	}
 
-	inline void Chunk::LockRead() const
+	inline ChunkBlocks& Chunk::EditBlocks()
 	{
-		m_mutex.lock_shared();
-	}
+		NazaraAssertMsg(m_blocks, "chunk has not been reset");
 
-	inline void Chunk::LockWrite()
-	{
-		m_mutex.lock();
-	}
+		// Blocks are still referenced by a snapshot (which may be read by another thread), copy them before any modification
+		if (m_blocks.use_count() > 1)
+			m_blocks = std::make_shared<ChunkBlocks>(*m_blocks);
+		else
+			std::atomic_thread_fence(std::memory_order_acquire); //< synchronize with the release of the last snapshot
 
-	inline void Chunk::UnlockRead() const
-	{
-		m_mutex.unlock_shared();
-	}
-
-	inline void Chunk::UnlockWrite()
-	{
-		m_mutex.unlock();
+		return *m_blocks;
 	}
 
 	inline void Chunk::SetPerFaceCollision()
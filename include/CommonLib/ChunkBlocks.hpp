@@ -0,0 +1,51 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_COMMONLIB_CHUNKBLOCKS_HPP
+#define TSOM_COMMONLIB_CHUNKBLOCKS_HPP
+
+#include <CommonLib/BlockIndex.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <NazaraUtils/Bitset.hpp>
+#include <vector>
+
+namespace tsom
+{
+	class Chunk;
+
+	// Block content of a chunk, shared with worker threads as an immutable snapshot (chunks copy it before modifying it if it's still referenced)
+	class ChunkBlocks
+	{
+		friend Chunk;
+
+		public:
+			inline ChunkBlocks(const Nz::Vector3ui& size);
+			ChunkBlocks(const ChunkBlocks&) = default;
+			ChunkBlocks(ChunkBlocks&&) = default;
+			~ChunkBlocks() = default;
+
+			inline unsigned int GetBlockLocalIndex(const Nz::Vector3ui& indices) const;
+			inline Nz::Vector3ui GetBlockLocalIndices(unsigned int blockIndex) const;
+			inline BlockIndex GetBlockContent(unsigned int blockIndex) const;
+			inline BlockIndex GetBlockContent(const Nz::Vector3ui& indices) const;
+			inline std::size_t GetBlockCount() const;
+			inline const Nz::Bitset<Nz::UInt64>& GetCollisionCellMask() const;
+			inline const BlockIndex* GetContent() const;
+			inline const Nz::Vector3ui& GetSize() const;
+
+			ChunkBlocks& operator=(const ChunkBlocks&) = delete;
+			ChunkBlocks& operator=(ChunkBlocks&&) = delete;
+
+		private:
+			std::vector<BlockIndex> m_blocks;
+			Nz::Bitset<Nz::UInt64> m_collisionCellMask;
+			Nz::Vector3ui m_size;
+	};
+}
+
+#include <CommonLib/ChunkBlocks.inl>
+
+#endif // TSOM_COMMONLIB_CHUNKBLOCKS_HPP
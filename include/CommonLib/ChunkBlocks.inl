@@ -0,0 +1,65 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <cassert>
+
+namespace tsom
+{
+	inline ChunkBlocks::ChunkBlocks(const Nz::Vector3ui& size) :
+	m_blocks(size.x * size.y * size.z, EmptyBlockIndex),
+	m_collisionCellMask(m_blocks.size(), false),
+	m_size(size)
+	{
+	}
+
+	inline unsigned int ChunkBlocks::GetBlockLocalIndex(const Nz::Vector3ui& indices) const
+	{
+		assert(indices.x < m_size.x);
+		assert(indices.y < m_size.y);
+		assert(indices.z < m_size.z);
+
+		return m_size.x * (m_size.y * indices.z + indices.y) + indices.x;
+	}
+
+	inline Nz::Vector3ui ChunkBlocks::GetBlockLocalIndices(unsigned int blockIndex) const
+	{
+		Nz::Vector3ui indices;
+		indices.x = blockIndex % m_size.x;
+		indices.y = (blockIndex / m_size.x) % m_size.y;
+		indices.z = blockIndex / (m_size.x * m_size.y);
+
+		return indices;
+	}
+
+	inline BlockIndex ChunkBlocks::GetBlockContent(unsigned int blockIndex) const
+	{
+		assert(blockIndex < m_blocks.size());
+		return m_blocks[blockIndex];
+	}
+
+	inline BlockIndex ChunkBlocks::GetBlockContent(const Nz::Vector3ui& indices) const
+	{
+		return GetBlockContent(GetBlockLocalIndex(indices));
+	}
+
+	inline std::size_t ChunkBlocks::GetBlockCount() const
+	{
+		return m_blocks.size();
+	}
+
+	inline const Nz::Bitset<Nz::UInt64>& ChunkBlocks::GetCollisionCellMask() const
+	{
+		return m_collisionCellMask;
+	}
+
+	inline const BlockIndex* ChunkBlocks::GetContent() const
+	{
+		return m_blocks.data();
+	}
+
+	inline const Nz::Vector3ui& ChunkBlocks::GetSize() const
+	{
+		return m_size;
+	}
+}
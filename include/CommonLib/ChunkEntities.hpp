@@ -14,6 +14,9 @@
 #include <tsl/hopscotch_map.h>
 #include <tsl/hopscotch_set.h>
 #include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace Nz
@@ -32,11 +35,15 @@ namespace tsom
 			ChunkEntities(Nz::ApplicationBase& app, Nz::EnttWorld& world, ChunkContainer& chunkContainer, const BlockLibrary& blockLibrary);
 			ChunkEntities(const ChunkEntities&) = delete;
 			ChunkEntities(ChunkEntities&&) = delete;
-			~ChunkEntities();
+			virtual ~ChunkEntities();
 
+			inline float GetColliderActivationDistance() const;
+
+			void SetColliderActivationDistance(float distance);
 			void SetParentEntity(entt::handle entity);
 
-			void Update();
+			// Feeds the task scheduler, only call it from the tick thread (e.g. ServerEnvironment::OnTick) and not from a world update which may run on a worker
+			virtual void Update();
 
 			ChunkEntities& operator=(const ChunkEntities&) = delete;
 			ChunkEntities& operator=(ChunkEntities&&) = delete;
@@ -47,25 +54,52 @@ namespace tsom
 
 			ChunkEntities(Nz::ApplicationBase& app, Nz::EnttWorld& world, ChunkContainer& chunkContainer, const BlockLibrary& blockLibrary, NoInit);
 
+			void CommitFinishedJobs();
 			void CreateChunkEntity(const ChunkIndices& chunkIndices, Chunk& chunk);
 			void DestroyChunkEntity(const ChunkIndices& chunkIndices);
 			void FillChunks();
+			inline bool IsChunkUpdateScheduled(const ChunkIndices& chunkIndices) const;
 			virtual UpdateJob* ProcessChunkUpdate(const Chunk& chunk, DirectionMask neighborMask);
 			void OnParentNodeInvalidated(const Nz::Node* node);
+			template<typename T> std::shared_ptr<T> PrepareUpdateJob(const ChunkIndices& chunkIndices, unsigned int taskCount);
+			inline void RegisterUpdateJob(const ChunkIndices& chunkIndices, std::shared_ptr<UpdateJob> updateJob);
+			void UpdateActiveChunks();
 			inline void UpdateChunkEntity(const ChunkIndices& chunkIndices, DirectionMask neighborMask);
 
+			static constexpr Nz::UInt32 ColliderReleaseDelay = 60; //< in updates
+
+			// Shared with tasks so they can signal completion even if ChunkEntities was destroyed meanwhile
+			struct FinishedJobQueue
+			{
+				std::mutex mutex;
+				std::vector<ChunkIndices> chunkIndices;
+			};
+
 			struct UpdateJob
 			{
 				std::function<void(const ChunkIndices& chunkIndices, UpdateJob&& job)> applyFunc;
+				std::shared_ptr<FinishedJobQueue> finishedJobQueue;
 				std::atomic_bool cancelled = false;
 				std::atomic_uint jobDone = 0;
+				std::vector<ChunkIndices> dependentJobs; //< jobs waiting for this one to finish before being committed
 				Nz::FixedVector<ChunkIndices, 3 * 3 * 3> chunkDependencies; //< 27 to be able to have all neighbor
+				ChunkIndices chunkIndices;
 				unsigned int taskCount;
 
 				inline bool HasFinished() const
 				{
 					return jobDone == taskCount;
 				}
+
+				// Must be called by every task of the job once it's done, from any thread
+				inline void NotifyTaskDone()
+				{
+					if (++jobDone == taskCount)
+					{
+						std::lock_guard lock(finishedJobQueue->mutex);
+						finishedJobQueue->chunkIndices.push_back(chunkIndices);
+					}
+				}
 			};
 
 			struct ColliderUpdateJob : UpdateJob
@@ -79,15 +113,21 @@ namespace tsom
 			NazaraSlot(Nz::Node, OnNodeInvalidation, m_onParentNodeInvalidated);
 
 			std::mutex m_invalidatedChunkMutex;
+			std::shared_ptr<FinishedJobQueue> m_finishedJobQueue;
 			entt::handle m_parentEntity;
 			tsl::hopscotch_map<ChunkIndices, DirectionMask> m_invalidatedChunks;
 			tsl::hopscotch_map<ChunkIndices, std::shared_ptr<UpdateJob>> m_updateJobs;
 			tsl::hopscotch_map<ChunkIndices, entt::handle> m_chunkEntities;
-			std::vector<ChunkIndices> m_finishedJobs;
+			tsl::hopscotch_map<ChunkIndices, Nz::UInt32> m_chunkLastUse;
+			tsl::hopscotch_set<ChunkIndices> m_updatedChunks;
+			std::vector<ChunkIndices> m_readyJobs;
+			std::vector<Nz::Vector3f> m_bodyPositions;
 			Nz::ApplicationBase& m_application;
 			Nz::EnttWorld& m_world;
 			const BlockLibrary& m_blockLibrary;
 			ChunkContainer& m_chunkContainer;
+			Nz::UInt32 m_updateCounter;
+			float m_colliderActivationDistance;
 	};
 }
 
@@ -4,6 +4,42 @@
 
 namespace tsom
 {
+	inline float ChunkEntities::GetColliderActivationDistance() const
+	{
+		return m_colliderActivationDistance;
+	}
+
+	inline bool ChunkEntities::IsChunkUpdateScheduled(const ChunkIndices& chunkIndices) const
+	{
+		// Chunks either got a new job during this update or will get one when processing invalidated chunks
+		return m_updatedChunks.contains(chunkIndices) || m_invalidatedChunks.contains(chunkIndices);
+	}
+
+	template<typename T>
+	std::shared_ptr<T> ChunkEntities::PrepareUpdateJob(const ChunkIndices& chunkIndices, unsigned int taskCount)
+	{
+		std::shared_ptr<T> updateJob = std::make_shared<T>();
+		updateJob->chunkIndices = chunkIndices;
+		updateJob->finishedJobQueue = m_finishedJobQueue;
+		updateJob->taskCount = taskCount;
+
+		// Try to cancel current update job to avoid useless work, jobs waiting for it will wait for the new one
+		if (auto it = m_updateJobs.find(chunkIndices); it != m_updateJobs.end())
+		{
+			UpdateJob& previousJob = *it->second;
+			previousJob.cancelled = true;
+			updateJob->dependentJobs = std::move(previousJob.dependentJobs);
+		}
+
+		return updateJob;
+	}
+
+	inline void ChunkEntities::RegisterUpdateJob(const ChunkIndices& chunkIndices, std::shared_ptr<UpdateJob> updateJob)
+	{
+		m_updateJobs.insert_or_assign(chunkIndices, std::move(updateJob));
+		m_updatedChunks.insert(chunkIndices);
+	}
+
 	inline void ChunkEntities::UpdateChunkEntity(const ChunkIndices& chunkIndices, DirectionMask neighborMask)
 	{
 		assert(m_chunkEntities.contains(chunkIndices));
@@ -7,14 +7,21 @@
 #ifndef TSOM_COMMONLIB_COMPONENTS_CLASSINSTANCECOMPONENT_HPP
 #define TSOM_COMMONLIB_COMPONENTS_CLASSINSTANCECOMPONENT_HPP
 
+#include <CommonLib/EntityClass.hpp>
 #include <CommonLib/EntityProperties.hpp>
 #include <NazaraUtils/Signal.hpp>
+#include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
+namespace Nz
+{
+	class ByteStream;
+}
+
 namespace tsom
 {
-	class EntityClass;
 	class ServerPlayer;
 
 	class TSOM_COMMONLIB_API ClassInstanceComponent
@@ -31,16 +38,18 @@ namespace tsom
 			Nz::UInt32 FindPropertyIndex(std::string_view propertyName) const;
 
 			inline const std::shared_ptr<const EntityClass>& GetClass() const;
-			inline const EntityProperty& GetProperty(Nz::UInt32 propertyIndex) const;
-			template<EntityPropertyType Property> auto GetProperty(Nz::UInt32 propertyIndex) const;
-			template<EntityPropertyType Property> auto GetProperty(std::string_view propertyName) const;
+			template<EntityPropertyType Property> const EntityPropertyUnderlyingType_t<Property>& GetProperty(Nz::UInt32 propertyIndex) const;
+			template<EntityPropertyType Property> const EntityPropertyUnderlyingType_t<Property>& GetProperty(std::string_view propertyName) const;
+			template<EntityPropertyType Property> std::span<const EntityPropertyUnderlyingType_t<Property>> GetPropertyArray(Nz::UInt32 propertyIndex) const;
 
 			Nz::UInt32 GetPropertyIndex(std::string_view propertyName) const;
 
+			void SerializeProperty(Nz::ByteStream& byteStream, Nz::UInt32 propertyIndex) const;
+
 			void TriggerClientRpc(Nz::UInt32 rpcIndex, ServerPlayer* targetPlayer);
 
 			void UpdateClass(std::shared_ptr<const EntityClass> entityClass);
-			inline void UpdateProperty(Nz::UInt32 propertyIndex, EntityProperty&& value);
+			void UpdateProperty(Nz::UInt32 propertyIndex, EntityProperty&& value);
 			template<EntityPropertyType Property, typename T> void UpdateProperty(Nz::UInt32 propertyIndex, T&& value);
 			template<EntityPropertyType Property, typename T> void UpdateProperty(std::string_view propertyName, T&& value);
 
@@ -51,8 +60,14 @@ namespace tsom
 			NazaraSignal(OnPropertyUpdate, ClassInstanceComponent* /*classInstance*/, Nz::UInt32 /*propertyIndex*/, const EntityProperty& /*newValue*/);
 
 		private:
+			template<EntityPropertyType Property> std::span<const EntityPropertyUnderlyingType_t<Property>> GetPropertyValues(Nz::UInt32 propertyIndex) const;
+			void StoreProperty(Nz::UInt32 propertyIndex, const EntityProperty& value);
+
+			static void CompactArrays(const EntityClass& entityClass, EntityClass::PropertyStorage& propertyStorage);
+			template<EntityPropertyType Property> static void StorePropertyValues(const EntityClass& entityClass, EntityClass::PropertyStorage& propertyStorage, Nz::UInt32 propertyIndex, std::span<const EntityPropertyUnderlyingType_t<Property>> values);
+
 			std::shared_ptr<const EntityClass> m_entityClass;
-			std::vector<EntityProperty> m_properties;
+			EntityClass::PropertyStorage m_propertyStorage;
 	};
 }
 
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in LICENSE
 
 #include <cassert>
+#include <new>
 
 namespace tsom
 {
@@ -11,30 +12,24 @@ namespace tsom
 		return m_entityClass;
 	}
 
-	inline const EntityProperty& ClassInstanceComponent::GetProperty(Nz::UInt32 propertyIndex) const
-	{
-		assert(propertyIndex < m_properties.size());
-		return m_properties[propertyIndex];
-	}
-
 	template<EntityPropertyType Property>
-	auto ClassInstanceComponent::GetProperty(Nz::UInt32 propertyIndex) const
+	auto ClassInstanceComponent::GetProperty(Nz::UInt32 propertyIndex) const -> const EntityPropertyUnderlyingType_t<Property>&
 	{
-		assert(propertyIndex < m_properties.size());
-		return std::get<EntityPropertySingleValue<Property>>(m_properties[propertyIndex]);
+		assert(!m_entityClass->GetProperty(propertyIndex).isArray);
+		return GetPropertyValues<Property>(propertyIndex).front();
 	}
 
 	template<EntityPropertyType Property>
-	auto ClassInstanceComponent::GetProperty(std::string_view propertyName) const
+	auto ClassInstanceComponent::GetProperty(std::string_view propertyName) const -> const EntityPropertyUnderlyingType_t<Property>&
 	{
 		return GetProperty<Property>(GetPropertyIndex(propertyName));
 	}
 
-	inline void ClassInstanceComponent::UpdateProperty(Nz::UInt32 propertyIndex, EntityProperty&& value)
+	template<EntityPropertyType Property>
+	auto ClassInstanceComponent::GetPropertyArray(Nz::UInt32 propertyIndex) const -> std::span<const EntityPropertyUnderlyingType_t<Property>>
 	{
-		assert(propertyIndex < m_properties.size());
-		OnPropertyUpdate(this, propertyIndex, value);
-		m_properties[propertyIndex] = std::move(value);
+		assert(m_entityClass->GetProperty(propertyIndex).isArray);
+		return GetPropertyValues<Property>(propertyIndex);
 	}
 
 	template<EntityPropertyType Property, typename T>
@@ -48,4 +43,30 @@ namespace tsom
 	{
 		return UpdateProperty<Property>(GetPropertyIndex(propertyName), std::forward<T>(value));
 	}
+
+	template<EntityPropertyType Property>
+	auto ClassInstanceComponent::GetPropertyValues(Nz::UInt32 propertyIndex) const -> std::span<const EntityPropertyUnderlyingType_t<Property>>
+	{
+		using UnderlyingType = EntityPropertyUnderlyingType_t<Property>;
+
+		assert(propertyIndex < m_entityClass->GetPropertyCount());
+		assert(m_entityClass->GetProperty(propertyIndex).type == Property);
+
+		const EntityClass::PropertyLayout& layout = m_entityClass->GetPropertyLayout(propertyIndex);
+		if (m_entityClass->GetProperty(propertyIndex).isArray)
+		{
+			const EntityClass::ArrayRange& arrayRange = m_propertyStorage.arrays[layout.offset];
+			if constexpr (Property == EntityPropertyType::String)
+				return std::span<const UnderlyingType>(m_propertyStorage.arrayStrings.data() + arrayRange.offset, arrayRange.size);
+			else
+				return std::span<const UnderlyingType>(std::launder(reinterpret_cast<const UnderlyingType*>(m_propertyStorage.arrayData.data() + arrayRange.offset)), arrayRange.size);
+		}
+		else
+		{
+			if constexpr (Property == EntityPropertyType::String)
+				return std::span<const UnderlyingType>(m_propertyStorage.strings.data() + layout.offset, 1);
+			else
+				return std::span<const UnderlyingType>(std::launder(reinterpret_cast<const UnderlyingType*>(m_propertyStorage.data.data() + layout.offset)), 1);
+		}
+	}
 }
@@ -0,0 +1,24 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_COMMONLIB_COMPONENTS_GRAVITYCACHECOMPONENT_HPP
+#define TSOM_COMMONLIB_COMPONENTS_GRAVITYCACHECOMPONENT_HPP
+
+#include <CommonLib/Export.hpp>
+#include <CommonLib/GravityForce.hpp>
+#include <Nazara/Math/Vector3.hpp>
+
+namespace tsom
+{
+	struct GravityCacheComponent
+	{
+		GravityForce gravity;
+		Nz::Vector3f position;
+		bool isValid = false;
+	};
+}
+
+#endif // TSOM_COMMONLIB_COMPONENTS_GRAVITYCACHECOMPONENT_HPP
@@ -8,13 +8,31 @@
 #define TSOM_COMMONLIB_COMPONENTS_SCRIPTEDENTITYCOMPONENT_HPP
 
 #include <CommonLib/Export.hpp>
+#include <sol/function.hpp>
 #include <sol/table.hpp>
+#include <memory>
+#include <vector>
 
 namespace tsom
 {
-	struct ScriptedEntityComponent
+	// Script callbacks of an entity class, resolved once when the class is registered instead of being looked up on each call
+	struct ScriptedClass
 	{
+		struct Callback
+		{
+			sol::protected_function function;
+			std::size_t profilerIndex = 0;
+		};
+
 		sol::table classMetatable;
+		std::vector<Callback> propertyUpdateCallbacks;
+		Callback initCallback;
+		Callback interactCallback; //< server-only
+	};
+
+	struct ScriptedEntityComponent
+	{
+		std::shared_ptr<const ScriptedClass> scriptedClass;
 		sol::table entityTable;
 	};
 }
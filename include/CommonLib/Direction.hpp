@@ -89,6 +89,15 @@ namespace tsom
 		Nz::Vector3i {  0,  1,  0 }, //< Up
 	};
 
+	constexpr Nz::EnumArray<Direction, Direction> s_oppositeDirections = {
+		Direction::Front, //< Back
+		Direction::Up,    //< Down
+		Direction::Back,  //< Front
+		Direction::Right, //< Left
+		Direction::Left,  //< Right
+		Direction::Down,  //< Up
+	};
+
 	constexpr Direction DirectionFromNormal(const Nz::Vector3f& outsideNormal);
 }
 
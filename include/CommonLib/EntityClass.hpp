@@ -22,8 +22,11 @@ namespace tsom
 	class TSOM_COMMONLIB_API EntityClass
 	{
 		public:
+			struct ArrayRange;
 			struct Callbacks;
 			struct Property;
+			struct PropertyLayout;
+			struct PropertyStorage;
 			struct RemoteProcedureCall;
 
 			EntityClass(std::string name, std::vector<Property> properties, Callbacks callbacks, std::vector<RemoteProcedureCall> clientRpcs);
@@ -36,17 +39,22 @@ namespace tsom
 			inline Nz::UInt32 FindClientRpc(std::string_view propertyName) const;
 			inline Nz::UInt32 FindProperty(std::string_view propertyName) const;
 
+			inline const Callbacks& GetCallbacks() const;
 			inline const RemoteProcedureCall& GetClientRpc(Nz::UInt32 rpcIndex) const;
 			inline Nz::UInt32 GetClientRpcCount() const;
+			inline const PropertyStorage& GetDefaultPropertyStorage() const;
 			inline const std::string& GetName() const;
+			inline Nz::UInt32 GetNetworkedPropertyCount() const;
 			inline const Property& GetProperty(Nz::UInt32 propertyIndex) const;
 			inline Nz::UInt32 GetPropertyCount() const;
+			inline const PropertyLayout& GetPropertyLayout(Nz::UInt32 propertyIndex) const;
 
 			EntityClass& operator=(const EntityClass&) = delete;
 			EntityClass& operator=(EntityClass&&) noexcept = default;
 
 			struct Callbacks
 			{
+				std::function<void(entt::handle)> onClassUpdate; //< called on existing entities when their class is reloaded
 				std::function<void(entt::handle)> onInit;
 			};
 
@@ -59,6 +67,32 @@ namespace tsom
 				bool isNetworked;
 			};
 
+			// Arrays can change size, their values are stored apart from other properties
+			struct ArrayRange
+			{
+				std::size_t capacity; //< in elements
+				std::size_t offset; //< in bytes in the array data, or index of the first string for string arrays
+				std::size_t size; //< in elements
+			};
+
+			// Where the values of a property are stored in ClassInstanceComponent
+			struct PropertyLayout
+			{
+				std::size_t offset; //< index of the array range for arrays, otherwise in bytes in the property data or index of the string for string properties
+			};
+
+			// Values of every property of an instance, starts as a copy of the class defaults
+			struct PropertyStorage
+			{
+				std::vector<ArrayRange> arrays;
+				std::vector<Nz::UInt8> arrayData;
+				std::vector<std::string> arrayStrings;
+				std::vector<Nz::UInt8> data;
+				std::vector<std::string> strings;
+				std::size_t unusedArrayDataSize = 0; //< in bytes, left by arrays moved to the end of arrayData
+				std::size_t unusedArrayStringCount = 0;
+			};
+
 			struct RemoteProcedureCall
 			{
 				std::function<void(entt::handle)> onCalled;
@@ -70,10 +104,13 @@ namespace tsom
 		private:
 			std::string m_name;
 			std::vector<Property> m_properties;
+			std::vector<PropertyLayout> m_propertyLayouts;
 			std::vector<RemoteProcedureCall> m_clientRpcs;
 			tsl::hopscotch_map<std::string, std::size_t, std::hash<std::string_view>, std::equal_to<>> m_clientRpcIndices;
 			tsl::hopscotch_map<std::string, std::size_t, std::hash<std::string_view>, std::equal_to<>> m_propertyIndices;
 			Callbacks m_callbacks;
+			PropertyStorage m_defaultPropertyStorage;
+			Nz::UInt32 m_networkedPropertyCount;
 	};
 }
 
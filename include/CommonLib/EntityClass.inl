@@ -22,6 +22,11 @@ namespace tsom
 		return it->second;
 	}
 
+	inline auto EntityClass::GetCallbacks() const -> const Callbacks&
+	{
+		return m_callbacks;
+	}
+
 	inline auto EntityClass::GetClientRpc(Nz::UInt32 rpcIndex) const -> const RemoteProcedureCall&
 	{
 		assert(rpcIndex < m_clientRpcs.size());
@@ -33,11 +38,21 @@ namespace tsom
 		return Nz::UInt32(m_clientRpcs.size());
 	}
 
+	inline auto EntityClass::GetDefaultPropertyStorage() const -> const PropertyStorage&
+	{
+		return m_defaultPropertyStorage;
+	}
+
 	inline const std::string& EntityClass::GetName() const
 	{
 		return m_name;
 	}
 
+	inline Nz::UInt32 EntityClass::GetNetworkedPropertyCount() const
+	{
+		return m_networkedPropertyCount;
+	}
+
 	inline auto EntityClass::GetProperty(Nz::UInt32 propertyIndex) const -> const Property&
 	{
 		assert(propertyIndex < m_properties.size());
@@ -48,4 +63,10 @@ namespace tsom
 	{
 		return Nz::UInt32(m_properties.size());
 	}
+
+	inline auto EntityClass::GetPropertyLayout(Nz::UInt32 propertyIndex) const -> const PropertyLayout&
+	{
+		assert(propertyIndex < m_propertyLayouts.size());
+		return m_propertyLayouts[propertyIndex];
+	}
 }
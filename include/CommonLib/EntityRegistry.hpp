@@ -45,7 +45,7 @@ namespace tsom
 		private:
 			std::vector<std::unique_ptr<EntityClassLibrary>> m_classLibraries;
 			tsl::hopscotch_map<std::string, std::shared_ptr<EntityClass>, std::hash<std::string_view>, std::equal_to<>> m_classes;
-			tsl::hopscotch_map<const EntityClass*, std::shared_ptr<const EntityClass>> m_refreshMap;
+			tsl::hopscotch_map<std::shared_ptr<const EntityClass>, std::shared_ptr<const EntityClass>> m_refreshMap; //< keeps previous classes alive until entities are updated
 			bool m_isRefreshing;
 	};
 }
@@ -9,6 +9,7 @@
 
 #include <CommonLib/Export.hpp>
 #include <CommonLib/GravityForce.hpp>
+#include <span>
 
 namespace tsom
 {
@@ -21,6 +22,9 @@ namespace tsom
 			virtual ~GravityController();
 
 			virtual GravityForce ComputeGravity(const Nz::Vector3f& position) const = 0;
+			virtual void ComputeGravityBatch(std::span<const Nz::Vector3f> positions, std::span<GravityForce> forces) const;
+
+			virtual bool HasUniformGravity() const;
 
 			GravityController& operator=(const GravityController&) = delete;
 			GravityController& operator=(GravityController&&) = delete;
@@ -21,6 +21,9 @@ namespace tsom::Constants
 
 	// Serialization constants
 	constexpr Nz::UInt32 ChunkBinaryVersion = 1;
+	constexpr Nz::UInt32 ChunkContentDictionaryVersion = 1; //< must be bumped when the chunk content dictionary is retrained (0 means no dictionary)
+	constexpr Nz::UInt32 ChunkSaveDictionaryVersion = 1; //< must be bumped when the chunk save dictionary is retrained (0 means no dictionary)
+	constexpr int ChunkSaveCompressionLevel = 9;
 }
 
 #endif // TSOM_COMMONLIB_INTERNALCONSTANTS_HPP
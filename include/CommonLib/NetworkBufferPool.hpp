@@ -0,0 +1,51 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_COMMONLIB_NETWORKBUFFERPOOL_HPP
+#define TSOM_COMMONLIB_NETWORKBUFFERPOOL_HPP
+
+#include <CommonLib/Export.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <concurrentqueue.h>
+#include <array>
+#include <atomic>
+
+namespace tsom
+{
+	// Size-classed pool of packet buffers, buffers can be acquired and released from any thread
+	class TSOM_COMMONLIB_API NetworkBufferPool
+	{
+		public:
+			inline NetworkBufferPool(std::size_t maxBufferPerClass = DefaultMaxBufferPerClass);
+			NetworkBufferPool(const NetworkBufferPool&) = delete;
+			NetworkBufferPool(NetworkBufferPool&&) = delete;
+			~NetworkBufferPool() = default;
+
+			Nz::ByteArray Acquire(std::size_t sizeHint = 0);
+
+			inline std::size_t GetSizeHint(Nz::UInt8 bufferType) const;
+
+			void Release(Nz::ByteArray&& buffer);
+
+			void UpdateSizeHint(Nz::UInt8 bufferType, std::size_t size);
+
+			NetworkBufferPool& operator=(const NetworkBufferPool&) = delete;
+			NetworkBufferPool& operator=(NetworkBufferPool&&) = delete;
+
+			static constexpr std::size_t DefaultMaxBufferPerClass = 1024;
+			static constexpr std::size_t SizeHintDecay = 4; //< hints lose 1/SizeHintDecay of their value every smaller buffer
+			static constexpr std::array<std::size_t, 6> SizeClasses = { 64, 256, 1024, 4096, 16384, 65536 };
+
+		private:
+			std::array<moodycamel::ConcurrentQueue<Nz::ByteArray>, SizeClasses.size()> m_freeBuffers;
+			std::array<std::atomic<std::size_t>, 256> m_sizeHints;
+			std::size_t m_maxBufferPerClass;
+	};
+}
+
+#include <CommonLib/NetworkBufferPool.inl>
+
+#endif // TSOM_COMMONLIB_NETWORKBUFFERPOOL_HPP
@@ -0,0 +1,18 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+namespace tsom
+{
+	inline NetworkBufferPool::NetworkBufferPool(std::size_t maxBufferPerClass) :
+	m_maxBufferPerClass(maxBufferPerClass)
+	{
+		for (auto& sizeHint : m_sizeHints)
+			sizeHint.store(0, std::memory_order_relaxed);
+	}
+
+	inline std::size_t NetworkBufferPool::GetSizeHint(Nz::UInt8 bufferType) const
+	{
+		return m_sizeHints[bufferType].load(std::memory_order_relaxed);
+	}
+}
@@ -8,7 +8,11 @@
 #define TSOM_COMMONLIB_NETWORKREACTOR_HPP
 
 #include <CommonLib/Export.hpp>
+#include <CommonLib/NetworkBufferPool.hpp>
+#include <CommonLib/NetworkStatistics.hpp>
+#include <Nazara/Core/Clock.hpp>
 #include <Nazara/Network/ENetHost.hpp>
+#include <Nazara/Network/ENetPacket.hpp>
 #include <concurrentqueue.h>
 #include <atomic>
 #include <functional>
@@ -29,6 +33,7 @@ namespace tsom
 	{
 		public:
 			struct PeerInfo;
+			using ConnectionCallback = std::function<void(std::size_t peerId)>;
 			using PeerInfoCallback = std::function<void(PeerInfo& peerInfo)>;
 
 			NetworkReactor(std::size_t idOffset, Nz::NetProtocol protocol, Nz::UInt16 port, std::size_t maxClient);
@@ -36,11 +41,14 @@ namespace tsom
 			NetworkReactor(NetworkReactor&&) = delete;
 			~NetworkReactor();
 
-			std::size_t ConnectTo(Nz::IpAddress address, Nz::UInt32 data = 0);
+			void ConnectTo(Nz::IpAddress address, Nz::UInt32 data, ConnectionCallback callback);
 			void DisconnectPeer(std::size_t peerId, Nz::UInt32 data = 0, DisconnectionType type = DisconnectionType::Normal);
 
+			inline NetworkBufferPool& GetBufferPool();
 			inline std::size_t GetIdOffset() const;
 			inline Nz::NetProtocol GetProtocol() const;
+			inline NetworkStatistics& GetStatistics();
+			inline const NetworkStatistics& GetStatistics() const;
 
 			template<typename ConnectCB, typename DisconnectCB, typename DataCB>
 			void Poll(ConnectCB&& onConnection, DisconnectCB&& onDisconnection, DataCB&& onData);
@@ -64,25 +72,30 @@ namespace tsom
 			};
 
 			static constexpr std::size_t InvalidPeerId = std::numeric_limits<std::size_t>::max();
+			static constexpr Nz::Time RecycleInterval = Nz::Time::Milliseconds(10);
 
 		private:
 			void EnsureProperDisconnection(const moodycamel::ProducerToken& producterToken, moodycamel::ConsumerToken& token);
-			void HandleConnectionRequests(moodycamel::ConsumerToken& token);
+			void HandleConnectionRequests(const moodycamel::ProducerToken& producterToken, moodycamel::ConsumerToken& token);
 			void ReceivePackets(const moodycamel::ProducerToken& producterToken);
+			void RecycleBuffers();
 			void SendPackets(const moodycamel::ProducerToken& producterToken, moodycamel::ConsumerToken& token);
 			void WorkerThread();
 
 			struct ConnectionRequest
 			{
-				using Callback = std::function<void(std::size_t clientId)>;
-
-				Callback callback;
+				ConnectionCallback callback;
 				Nz::IpAddress remoteAddress;
 				Nz::UInt32 data;
 			};
 
 			struct IncomingEvent
 			{
+				struct ConnectionResponse
+				{
+					ConnectionCallback callback;
+				};
+
 				struct ConnectEvent
 				{
 					bool outgoingConnection;
@@ -108,7 +121,7 @@ namespace tsom
 				};
 
 				std::size_t peerId = InvalidPeerId;
-				std::variant<ConnectEvent, DisconnectEvent, PacketEvent, PeerInfoResponse> data;
+				std::variant<ConnectionResponse, ConnectEvent, DisconnectEvent, PacketEvent, PeerInfoResponse> data;
 			};
 
 			struct OutgoingEvent
@@ -145,6 +158,10 @@ namespace tsom
 			moodycamel::ConcurrentQueue<OutgoingEvent> m_outgoingQueue;
 			Nz::ENetHost m_host;
 			Nz::NetProtocol m_protocol;
+			NetworkBufferPool m_bufferPool;
+			NetworkStatistics m_statistics; //< totals of all sessions using this reactor
+			Nz::MillisecondClock m_recycleClock;
+			std::vector<Nz::ENetPacketRef> m_inFlightPackets; //< must be destroyed before m_host
 	};
 }
 
@@ -4,6 +4,11 @@
 
 namespace tsom
 {
+	inline NetworkBufferPool& NetworkReactor::GetBufferPool()
+	{
+		return m_bufferPool;
+	}
+
 	inline std::size_t NetworkReactor::GetIdOffset() const
 	{
 		return m_idOffset;
@@ -14,6 +19,16 @@ namespace tsom
 		return m_protocol;
 	}
 
+	inline NetworkStatistics& NetworkReactor::GetStatistics()
+	{
+		return m_statistics;
+	}
+
+	inline const NetworkStatistics& NetworkReactor::GetStatistics() const
+	{
+		return m_statistics;
+	}
+
 	template<typename ConnectCB, typename DisconnectCB, typename DataCB>
 	void NetworkReactor::Poll(ConnectCB&& onConnection, DisconnectCB&& onDisconnection, DataCB&& onData)
 	{
@@ -23,7 +38,12 @@ namespace tsom
 			std::visit([&](auto&& arg)
 			{
 				using T = std::decay_t<decltype(arg)>;
-				if constexpr (std::is_same_v<T, IncomingEvent::ConnectEvent>)
+				if constexpr (std::is_same_v<T, IncomingEvent::ConnectionResponse>)
+				{
+					// peerId is InvalidPeerId if the peer couldn't be created
+					arg.callback(inEvent.peerId);
+				}
+				else if constexpr (std::is_same_v<T, IncomingEvent::ConnectEvent>)
 				{
 					onConnection(arg.outgoingConnection, inEvent.peerId, arg.remoteAddress, arg.data);
 				}
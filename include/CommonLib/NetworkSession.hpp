@@ -9,6 +9,7 @@
 
 #include <CommonLib/Export.hpp>
 #include <CommonLib/NetworkReactor.hpp>
+#include <CommonLib/NetworkStatistics.hpp>
 #include <CommonLib/SessionHandler.hpp>
 #include <CommonLib/Protocol/NetworkStringStore.hpp>
 #include <Nazara/Network/ENetPacket.hpp>
@@ -34,6 +35,8 @@ namespace tsom
 			inline std::size_t GetPeerId() const;
 			inline Nz::UInt32 GetProtocolVersion() const;
 			inline SessionHandler* GetSessionHandler();
+			inline NetworkStatistics& GetStatistics();
+			inline const NetworkStatistics& GetStatistics() const;
 			inline NetworkStringStore& GetStringStore();
 			inline const NetworkStringStore& GetStringStore() const;
 
@@ -59,6 +62,7 @@ namespace tsom
 			Nz::IpAddress m_remoteAddress;
 			Nz::UInt32 m_protocolVersion;
 			NetworkReactor& m_reactor;
+			NetworkStatistics m_statistics;
 			NetworkStringStore m_stringStore;
 	};
 }
@@ -22,6 +22,16 @@ namespace tsom
 		return m_sessionHandler.get();
 	}
 
+	inline NetworkStatistics& NetworkSession::GetStatistics()
+	{
+		return m_statistics;
+	}
+
+	inline const NetworkStatistics& NetworkSession::GetStatistics() const
+	{
+		return m_statistics;
+	}
+
 	inline NetworkStringStore& NetworkSession::GetStringStore()
 	{
 		return m_stringStore;
@@ -44,7 +54,10 @@ namespace tsom
 
 		const SessionHandler::SendAttributes& sendAttributes = m_sessionHandler->GetPacketAttributes<T>();
 
-		Nz::ByteArray byteArray;
+		// Use the recent sizes of this packet type to pick a pooled buffer which will probably not have to grow
+		NetworkBufferPool& bufferPool = m_reactor.GetBufferPool();
+
+		Nz::ByteArray byteArray = bufferPool.Acquire(bufferPool.GetSizeHint(PacketIndex<T>));
 		Nz::ByteStream byteStream(&byteArray, Nz::OpenMode::Write);
 		byteStream << Nz::UInt8(PacketIndex<T>);
 
@@ -53,6 +66,13 @@ namespace tsom
 
 		byteStream.FlushBits();
 
+		std::size_t byteCount = byteArray.GetSize();
+		bufferPool.UpdateSizeHint(PacketIndex<T>, byteCount);
+
+		std::size_t rawByteCount = byteCount - serializer.GetCompressedByteCount() + serializer.GetUncompressedByteCount();
+		m_statistics.RecordOutgoing(PacketIndex<T>, sendAttributes.channel, byteCount, rawByteCount);
+		m_reactor.GetStatistics().RecordOutgoing(PacketIndex<T>, sendAttributes.channel, byteCount, rawByteCount);
+
 		m_reactor.SendData(m_peerId, sendAttributes.channel, sendAttributes.flags, std::move(byteArray), std::move(acknowledgeCallback));
 	}
 
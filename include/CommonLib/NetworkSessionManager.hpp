@@ -10,10 +10,12 @@
 #include <CommonLib/Export.hpp>
 #include <CommonLib/NetworkReactor.hpp>
 #include <CommonLib/NetworkSession.hpp>
+#include <CommonLib/NetworkStatistics.hpp>
 #include <NazaraUtils/FunctionRef.hpp>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace tsom
@@ -21,28 +23,44 @@ namespace tsom
 	class TSOM_COMMONLIB_API NetworkSessionManager
 	{
 		public:
-			inline NetworkSessionManager(Nz::UInt16 port, Nz::NetProtocol protocol = Nz::NetProtocol::Any, std::size_t maxSessions = MaxSessionPerManager);
+			NetworkSessionManager(Nz::UInt16 port, Nz::NetProtocol protocol = Nz::NetProtocol::Any, std::size_t maxSessions = MaxSessionPerReactor, std::size_t reactorCount = 1);
 			NetworkSessionManager(const NetworkSessionManager&) = delete;
 			NetworkSessionManager(NetworkSessionManager&&) = delete;
 			~NetworkSessionManager() = default;
 
+			inline std::size_t GetReactorCount() const;
+
 			void Poll();
 
+			void ResetStatistics();
+
 			inline void SendData(std::size_t peerId, Nz::UInt8 channelId, Nz::ENetPacketFlags flags, Nz::ByteArray&& payload);
 
 			template<typename T, typename... Args> void SetDefaultHandler(Args&&... args);
 
+			NetworkStatistics::Snapshot TakeStatisticsSnapshot() const;
+
 			NetworkSessionManager& operator=(const NetworkSessionManager&) = delete;
 			NetworkSessionManager& operator=(NetworkSessionManager&&) = delete;
 
-			static constexpr std::size_t MaxSessionPerManager = 4095;
+			static inline Nz::UInt32 BuildRedirectData(Nz::UInt16 portOffset);
+			static inline std::optional<Nz::UInt16> ExtractRedirectPortOffset(Nz::UInt32 disconnectionData);
+			static std::size_t PickReactor(std::span<const std::size_t> reactorSessionCounts);
+
+			static constexpr std::size_t MaxSessionPerReactor = 4095; //< ENet peer limit
+			static constexpr Nz::UInt32 RedirectDataMarker = 0x52440000; //< "RD", lower 16 bits are the port offset to reconnect to
 
 		private:
 			using HandlerFactory = std::function<std::unique_ptr<SessionHandler>(NetworkSession* session)>;
 
+			inline NetworkReactor& GetPeerReactor(std::size_t peerId);
+
+			std::size_t m_maxSessionPerReactor;
+			std::vector<std::size_t> m_reactorSessionCounts;
 			std::vector<std::optional<NetworkSession>> m_sessions; //< TODO: Nz::SparseVector
+			std::vector<std::unique_ptr<NetworkReactor>> m_reactors; //< peers are sharded between reactors (each one running its own thread)
 			HandlerFactory m_handlerFactory;
-			NetworkReactor m_reactor;
+			bool m_redirectPeers;
 	};
 }
 
@@ -2,20 +2,32 @@
 // This file is part of the "This Space Of Mine" project
 // For conditions of distribution and use, see copyright notice in LICENSE
 
+#include <cassert>
 #include <type_traits>
 
 namespace tsom
 {
-	inline NetworkSessionManager::NetworkSessionManager(Nz::UInt16 port, Nz::NetProtocol protocol, std::size_t maxSessions) :
-	m_sessions(maxSessions),
-	m_handlerFactory(nullptr),
-	m_reactor(0, protocol, port, maxSessions)
+	inline std::size_t NetworkSessionManager::GetReactorCount() const
 	{
+		return m_reactors.size();
 	}
 
-	void NetworkSessionManager::SendData(std::size_t peerId, Nz::UInt8 channelId, Nz::ENetPacketFlags flags, Nz::ByteArray&& payload)
+	inline void NetworkSessionManager::SendData(std::size_t peerId, Nz::UInt8 channelId, Nz::ENetPacketFlags flags, Nz::ByteArray&& payload)
 	{
-		m_reactor.SendData(peerId, channelId, flags, std::move(payload));
+		GetPeerReactor(peerId).SendData(peerId, channelId, flags, std::move(payload));
+	}
+
+	inline Nz::UInt32 NetworkSessionManager::BuildRedirectData(Nz::UInt16 portOffset)
+	{
+		return RedirectDataMarker | portOffset;
+	}
+
+	inline std::optional<Nz::UInt16> NetworkSessionManager::ExtractRedirectPortOffset(Nz::UInt32 disconnectionData)
+	{
+		if ((disconnectionData & 0xFFFF0000) != RedirectDataMarker)
+			return std::nullopt;
+
+		return static_cast<Nz::UInt16>(disconnectionData & 0xFFFF);
 	}
 
 	template<typename T, typename... Args>
@@ -25,4 +37,13 @@ namespace tsom
 
 		m_handlerFactory = [=](NetworkSession* session) mutable -> std::unique_ptr<SessionHandler> { return std::make_unique<T>(std::forward<Args>(args)..., session); };
 	}
+
+	inline NetworkReactor& NetworkSessionManager::GetPeerReactor(std::size_t peerId)
+	{
+		// Each reactor is given a contiguous peer id range (see idOffset)
+		std::size_t reactorIndex = peerId / m_maxSessionPerReactor;
+		assert(reactorIndex < m_reactors.size());
+
+		return *m_reactors[reactorIndex];
+	}
 }
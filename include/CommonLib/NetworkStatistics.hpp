@@ -0,0 +1,81 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_COMMONLIB_NETWORKSTATISTICS_HPP
+#define TSOM_COMMONLIB_NETWORKSTATISTICS_HPP
+
+#include <CommonLib/Export.hpp>
+#include <CommonLib/Protocol/Packets.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <nlohmann/json_fwd.hpp>
+#include <array>
+#include <atomic>
+#include <string>
+
+namespace tsom
+{
+	// Counts packets and bytes per packet type, counters can be incremented from any thread
+	class TSOM_COMMONLIB_API NetworkStatistics
+	{
+		public:
+			struct PacketStats;
+			struct Snapshot;
+
+			NetworkStatistics();
+			NetworkStatistics(const NetworkStatistics&) = delete;
+			NetworkStatistics(NetworkStatistics&&) = delete;
+			~NetworkStatistics() = default;
+
+			inline void RecordIncoming(std::size_t packetIndex, std::size_t byteCount);
+			inline void RecordOutgoing(std::size_t packetIndex, Nz::UInt8 channel, std::size_t byteCount, std::size_t rawByteCount);
+
+			void Reset();
+
+			Snapshot TakeSnapshot() const;
+
+			NetworkStatistics& operator=(const NetworkStatistics&) = delete;
+			NetworkStatistics& operator=(NetworkStatistics&&) = delete;
+
+			struct PacketStats
+			{
+				Nz::UInt64 byteCount = 0;
+				Nz::UInt64 packetCount = 0;
+				Nz::UInt64 rawByteCount = 0; //< before compression
+				Nz::UInt8 channel = 0xFF;
+			};
+
+			struct TSOM_COMMONLIB_API Snapshot
+			{
+				std::string BuildReport(std::size_t maxPacketTypes) const;
+
+				void Merge(const Snapshot& snapshot);
+
+				nlohmann::json ToJson() const;
+
+				std::array<PacketStats, PacketCount> incoming;
+				std::array<PacketStats, PacketCount> outgoing;
+				Nz::Time elapsedTime = Nz::Time::Zero();
+			};
+
+		private:
+			struct Counters
+			{
+				std::atomic<Nz::UInt64> byteCount = 0;
+				std::atomic<Nz::UInt64> packetCount = 0;
+				std::atomic<Nz::UInt64> rawByteCount = 0;
+				std::atomic<Nz::UInt8> channel = 0xFF;
+			};
+
+			std::array<Counters, PacketCount> m_incoming;
+			std::array<Counters, PacketCount> m_outgoing;
+			Nz::HighPrecisionClock m_clock;
+	};
+}
+
+#include <CommonLib/NetworkStatistics.inl>
+
+#endif // TSOM_COMMONLIB_NETWORKSTATISTICS_HPP
@@ -0,0 +1,30 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <cassert>
+
+namespace tsom
+{
+	inline void NetworkStatistics::RecordIncoming(std::size_t packetIndex, std::size_t byteCount)
+	{
+		assert(packetIndex < PacketCount);
+
+		// Incoming packets are counted before deserialization, their raw size is unknown
+		Counters& counters = m_incoming[packetIndex];
+		counters.byteCount.fetch_add(byteCount, std::memory_order_relaxed);
+		counters.packetCount.fetch_add(1, std::memory_order_relaxed);
+		counters.rawByteCount.fetch_add(byteCount, std::memory_order_relaxed);
+	}
+
+	inline void NetworkStatistics::RecordOutgoing(std::size_t packetIndex, Nz::UInt8 channel, std::size_t byteCount, std::size_t rawByteCount)
+	{
+		assert(packetIndex < PacketCount);
+
+		Counters& counters = m_outgoing[packetIndex];
+		counters.byteCount.fetch_add(byteCount, std::memory_order_relaxed);
+		counters.packetCount.fetch_add(1, std::memory_order_relaxed);
+		counters.rawByteCount.fetch_add(rawByteCount, std::memory_order_relaxed);
+		counters.channel.store(channel, std::memory_order_relaxed);
+	}
+}
@@ -35,7 +35,9 @@ namespace tsom
 			Chunk& AddChunk(const BlockLibrary& blockLibrary, const ChunkIndices& indices, const Nz::FunctionRef<void(BlockIndex* blocks)>& initCallback = nullptr);
 
 			GravityForce ComputeGravity(const Nz::Vector3f& position) const override;
+			void ComputeGravityBatch(std::span<const Nz::Vector3f> positions, std::span<GravityForce> forces) const override;
 			Nz::Vector3f ComputeUpDirection(const Nz::Vector3f& position) const;
+			void ComputeUpDirectionBatch(std::span<const Nz::Vector3f> positions, std::span<Nz::Vector3f> upDirections) const;
 
 			void ForEachChunk(Nz::FunctionRef<void(const ChunkIndices& chunkIndices, Chunk& chunk)> callback) override;
 			void ForEachChunk(Nz::FunctionRef<void(const ChunkIndices& chunkIndices, const Chunk& chunk)> callback) const override;
@@ -61,6 +63,8 @@ namespace tsom
 			static constexpr unsigned int ChunkSize = 32;
 
 		protected:
+			GravityForce BuildGravityForce(const Nz::Vector3f& position, float distSq, const Nz::Vector3f& up) const;
+
 			struct ChunkData
 			{
 				std::shared_ptr<Chunk> chunk;
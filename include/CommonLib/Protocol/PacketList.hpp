@@ -44,7 +44,11 @@ TSOM_NETWORK_PACKET(PlayerJoin)
 TSOM_NETWORK_PACKET(PlayerNameUpdate)
 TSOM_NETWORK_PACKET(SendChatMessage)
 TSOM_NETWORK_PACKET(UpdateRootEnvironment)
-TSOM_NETWORK_PACKET_LAST(UpdatePlayerInputs)
+TSOM_NETWORK_PACKET(UpdatePlayerInputs)
+
+// Packets added after 0.6.0 are appended to keep the opcodes of older packets stable
+TSOM_NETWORK_PACKET(InputAck)
+TSOM_NETWORK_PACKET_LAST(EntitiesPropertyUpdate)
 
 #undef TSOM_NETWORK_PACKET
 #undef TSOM_NETWORK_PACKET_LAST
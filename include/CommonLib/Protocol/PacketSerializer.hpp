@@ -28,12 +28,16 @@ namespace tsom
 
 			inline BinaryCompressor& GetBinaryCompressor();
 			inline Nz::ByteStream& GetByteStream();
+			inline std::size_t GetCompressedByteCount() const;
 			inline Nz::UInt32 GetProtocolVersion() const;
+			inline std::size_t GetUncompressedByteCount() const;
 
 			inline void Read(void* ptr, std::size_t size);
 
 			inline bool IsWriting() const;
 
+			inline void RegisterCompression(std::size_t uncompressedSize, std::size_t compressedSize);
+
 			inline void SetBinaryCompressor(BinaryCompressor& binaryCompressor);
 
 			inline void Write(const void* ptr, std::size_t size);
@@ -60,6 +64,8 @@ namespace tsom
 			template<typename DataType> void operator&=(const DataType& data) const;
 
 		private:
+			std::size_t m_compressedByteCount;
+			std::size_t m_uncompressedByteCount;
 			Nz::ByteStream& m_stream;
 			Nz::UInt32 m_protocolVersion;
 			BinaryCompressor* m_binaryCompressor;
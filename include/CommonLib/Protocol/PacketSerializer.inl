@@ -45,6 +45,8 @@ namespace tsom
 	}
 
 	inline PacketSerializer::PacketSerializer(Nz::ByteStream& packetStream, bool isWriting, Nz::UInt32 protocolVersion, BinaryCompressor& binaryCompressor) :
+	m_compressedByteCount(0),
+	m_uncompressedByteCount(0),
 	m_stream(packetStream),
 	m_protocolVersion(protocolVersion),
 	m_binaryCompressor(&binaryCompressor),
@@ -62,11 +64,21 @@ namespace tsom
 		return m_stream;
 	}
 
+	inline std::size_t PacketSerializer::GetCompressedByteCount() const
+	{
+		return m_compressedByteCount;
+	}
+
 	inline Nz::UInt32 PacketSerializer::GetProtocolVersion() const
 	{
 		return m_protocolVersion;
 	}
 
+	inline std::size_t PacketSerializer::GetUncompressedByteCount() const
+	{
+		return m_uncompressedByteCount;
+	}
+
 	inline void PacketSerializer::Read(void* ptr, std::size_t size)
 	{
 		if (m_stream.Read(ptr, size) != size)
@@ -78,6 +90,13 @@ namespace tsom
 		return m_isWriting;
 	}
 
+	inline void PacketSerializer::RegisterCompression(std::size_t uncompressedSize, std::size_t compressedSize)
+	{
+		// Used by network statistics to know the size a packet would have had without compression
+		m_compressedByteCount += compressedSize;
+		m_uncompressedByteCount += uncompressedSize;
+	}
+
 	inline void PacketSerializer::SetBinaryCompressor(BinaryCompressor& binaryCompressor)
 	{
 		m_binaryCompressor = &binaryCompressor;
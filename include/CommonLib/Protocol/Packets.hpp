@@ -25,6 +25,8 @@
 
 namespace tsom
 {
+	class ClassInstanceComponent;
+
 	namespace Packets
 	{
 #define TSOM_NETWORK_PACKET(Name) struct Name;
@@ -182,6 +184,7 @@ namespace tsom
 				std::optional<Helper::PlayerControlledData> playerControlled;
 				std::vector<EntityProperty> properties;
 				CompressedUnsigned<Nz::UInt32> entityClass;
+				const ClassInstanceComponent* propertySource = nullptr; //< if set, networked property values are written from it instead of properties
 			};
 
 			Nz::UInt16 tickIndex;
@@ -194,6 +197,25 @@ namespace tsom
 			std::vector<Helper::EntityId> entities;
 		};
 
+		struct EntitiesPropertyUpdate
+		{
+			struct PropertyData
+			{
+				CompressedUnsigned<Nz::UInt32> propertyIndex;
+				EntityProperty propertyValue;
+			};
+
+			struct EntityData
+			{
+				Helper::EntityId entityId;
+				std::vector<PropertyData> properties;
+				const ClassInstanceComponent* propertySource = nullptr; //< if set, property values are written from it (only property indices are used)
+			};
+
+			Nz::UInt16 tickIndex;
+			std::vector<EntityData> entities;
+		};
+
 		struct EntitiesStateUpdate
 		{
 			struct ControlledCharacter
@@ -236,6 +258,7 @@ namespace tsom
 			Helper::EntityId entity;
 			CompressedUnsigned<Nz::UInt32> propertyIndex;
 			EntityProperty propertyValue;
+			const ClassInstanceComponent* propertySource = nullptr; //< if set, the value is written from it instead of propertyValue
 		};
 
 		struct EnvironmentCreate
@@ -262,6 +285,12 @@ namespace tsom
 		{
 		};
 
+		struct InputAck
+		{
+			Nz::UInt16 tickIndex;
+			InputIndex lastInputIndex;
+		};
+
 		struct Interact
 		{
 			Helper::EntityId entityId;
@@ -301,14 +330,19 @@ namespace tsom
 
 		struct PlayerLeave
 		{
-			PlayerIndex index;
+			std::vector<PlayerIndex> indices;
 		};
 
 		struct PlayerJoin
 		{
-			PlayerIndex index;
-			SecuredString<Constants::PlayerMaxNicknameLength * 2> nickname;
-			bool isAuthenticated;
+			struct PlayerData
+			{
+				PlayerIndex index;
+				SecuredString<Constants::PlayerMaxNicknameLength * 2> nickname;
+				bool isAuthenticated;
+			};
+
+			std::vector<PlayerData> players;
 		};
 
 		struct PlayerNameUpdate
@@ -342,6 +376,7 @@ namespace tsom
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, DebugDrawLineList& data);
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, EntitiesCreation& data);
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, EntitiesDelete& data);
+		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, EntitiesPropertyUpdate& data);
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, EntitiesStateUpdate& data);
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, EntityEnvironmentUpdate& data);
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, EntityProcedureCall& data);
@@ -351,6 +386,7 @@ namespace tsom
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, EnvironmentUpdate& data);
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, ExitShipControl& data);
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, GameData& data);
+		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, InputAck& data);
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, Interact& data);
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, MineBlock& data);
 		TSOM_COMMONLIB_API void Serialize(PacketSerializer& serializer, NetworkStrings& data);
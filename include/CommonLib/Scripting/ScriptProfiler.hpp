@@ -0,0 +1,83 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_COMMONLIB_SCRIPTING_SCRIPTPROFILER_HPP
+#define TSOM_COMMONLIB_SCRIPTING_SCRIPTPROFILER_HPP
+
+#include <CommonLib/Export.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <sol/sol.hpp>
+#include <tsl/hopscotch_map.h>
+#include <string>
+#include <vector>
+
+namespace tsom
+{
+	// Measures script callbacks and aborts them when they run longer than the configured budget
+	class TSOM_COMMONLIB_API ScriptProfiler
+	{
+		public:
+			struct CallbackStats;
+
+			ScriptProfiler(lua_State* L);
+			ScriptProfiler(const ScriptProfiler&) = delete;
+			ScriptProfiler(ScriptProfiler&&) = delete;
+			~ScriptProfiler() = default;
+
+			std::string BuildReport() const;
+
+			template<typename F, typename... Args> sol::protected_function_result Call(std::size_t callbackIndex, F&& callback, Args&&... args);
+
+			inline Nz::Time GetCallbackBudget() const;
+			inline const CallbackStats& GetCallbackStats(std::size_t callbackIndex) const;
+
+			std::size_t RegisterCallback(std::string_view className, std::string_view callbackName);
+
+			void ResetStats();
+
+			inline void SetCallbackBudget(Nz::Time budget);
+
+			ScriptProfiler& operator=(const ScriptProfiler&) = delete;
+			ScriptProfiler& operator=(ScriptProfiler&&) = delete;
+
+			struct CallbackStats
+			{
+				std::string className;
+				std::string callbackName;
+				Nz::Time maxTime = Nz::Time::Zero();
+				Nz::Time totalTime = Nz::Time::Zero();
+				Nz::UInt64 abortCount = 0;
+				Nz::UInt64 callCount = 0;
+			};
+
+			static constexpr int HookInstructionInterval = 1000;
+
+		private:
+			struct CallContext
+			{
+				Nz::Time startTime;
+				bool removeHook;
+			};
+
+			CallContext BeginCall(lua_State* L);
+			void EndCall(lua_State* L, std::size_t callbackIndex, const CallContext& callContext, bool succeeded);
+
+			static void BudgetHook(lua_State* L, lua_Debug* ar);
+
+			std::vector<CallbackStats> m_callbacks;
+			tsl::hopscotch_map<std::string, std::size_t> m_callbackIndices;
+			Nz::HighPrecisionClock m_clock;
+			Nz::Time m_budget;
+			Nz::Time m_deadline;
+			unsigned int m_callDepth;
+			bool m_budgetExceeded;
+	};
+}
+
+#include <CommonLib/Scripting/ScriptProfiler.inl>
+
+#endif // TSOM_COMMONLIB_SCRIPTING_SCRIPTPROFILER_HPP
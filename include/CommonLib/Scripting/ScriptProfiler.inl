@@ -0,0 +1,39 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <cassert>
+
+namespace tsom
+{
+	template<typename F, typename... Args>
+	sol::protected_function_result ScriptProfiler::Call(std::size_t callbackIndex, F&& callback, Args&&... args)
+	{
+		// Coroutines run on their own thread, the hook has to be set on it
+		lua_State* L = callback.lua_state();
+
+		CallContext callContext = BeginCall(L);
+		sol::protected_function_result result = callback(std::forward<Args>(args)...);
+		EndCall(L, callbackIndex, callContext, result.valid());
+
+		return result;
+	}
+
+	inline Nz::Time ScriptProfiler::GetCallbackBudget() const
+	{
+		return m_budget;
+	}
+
+	inline auto ScriptProfiler::GetCallbackStats(std::size_t callbackIndex) const -> const CallbackStats&
+	{
+		assert(callbackIndex < m_callbacks.size());
+		return m_callbacks[callbackIndex];
+	}
+
+	inline void ScriptProfiler::SetCallbackBudget(Nz::Time budget)
+	{
+		// Changing the budget in the middle of a callback would leave the hook in an inconsistent state
+		assert(m_callDepth == 0);
+		m_budget = budget;
+	}
+}
@@ -0,0 +1,97 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_COMMONLIB_SCRIPTING_SCRIPTSCHEDULER_HPP
+#define TSOM_COMMONLIB_SCRIPTING_SCRIPTSCHEDULER_HPP
+
+#include <CommonLib/Export.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <NazaraUtils/Prerequisites.hpp>
+#include <entt/entt.hpp>
+#include <sol/sol.hpp>
+#include <array>
+#include <optional>
+#include <vector>
+
+namespace tsom
+{
+	class ScriptProfiler;
+
+	// Runs script timers and coroutines on a timing wheel, only the tasks due on a tick are visited
+	// Tasks scheduled while running an entity callback (see RunAsOwner) belong to that entity and can be cancelled with it
+	class TSOM_COMMONLIB_API ScriptScheduler
+	{
+		public:
+			using TaskId = Nz::UInt64;
+
+			ScriptScheduler(ScriptProfiler& profiler);
+			ScriptScheduler(const ScriptScheduler&) = delete;
+			ScriptScheduler(ScriptScheduler&&) = delete;
+			~ScriptScheduler() = default;
+
+			bool Cancel(TaskId taskId);
+			void CancelOwnedTasks(entt::handle owner);
+
+			inline entt::handle GetCurrentOwner() const;
+			inline Nz::UInt64 GetCurrentTick() const;
+			inline std::size_t GetPendingTaskCount() const;
+
+			void Register(sol::state& state);
+
+			template<typename F> decltype(auto) RunAsOwner(entt::handle owner, F&& func);
+
+			TaskId ScheduleTimer(sol::protected_function callback, Nz::UInt32 delayTicks, Nz::UInt32 intervalTicks = 0);
+
+			std::optional<TaskId> Spawn(sol::state_view state, sol::protected_function function);
+
+			void Tick();
+
+			ScriptScheduler& operator=(const ScriptScheduler&) = delete;
+			ScriptScheduler& operator=(ScriptScheduler&&) = delete;
+
+			static Nz::UInt32 ToTicks(Nz::Time duration);
+
+			static constexpr std::size_t WheelSize = 256;
+
+		private:
+			struct Task;
+
+			std::size_t AllocateTask();
+			void FreeTask(std::size_t taskIndex);
+			void HandleCoroutineResult(std::size_t taskIndex, sol::protected_function_result& result);
+			void Schedule(std::size_t taskIndex, Nz::UInt32 delayTicks);
+
+			static constexpr TaskId BuildTaskId(std::size_t taskIndex, Nz::UInt32 generation);
+
+			struct Task
+			{
+				sol::coroutine coroutine;
+				sol::protected_function callback;
+				sol::thread thread;
+				entt::handle owner;
+				Nz::UInt64 dueTick = 0;
+				Nz::UInt32 generation = 0;
+				Nz::UInt32 intervalTicks = 0;
+				bool isActive = false;
+			};
+
+			std::array<std::vector<std::size_t>, WheelSize> m_wheel;
+			std::vector<std::size_t> m_freeTasks;
+			std::vector<std::size_t> m_dueTasks;
+			std::vector<Task> m_tasks;
+			entt::handle m_currentOwner;
+			std::size_t m_coroutineProfilerIndex;
+			std::size_t m_ownedTaskCount;
+			std::size_t m_pendingTaskCount;
+			std::size_t m_timerProfilerIndex;
+			Nz::UInt64 m_currentTick;
+			ScriptProfiler& m_profiler;
+	};
+}
+
+#include <CommonLib/Scripting/ScriptScheduler.inl>
+
+#endif // TSOM_COMMONLIB_SCRIPTING_SCRIPTSCHEDULER_HPP
@@ -0,0 +1,39 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <NazaraUtils/CallOnExit.hpp>
+#include <utility>
+
+namespace tsom
+{
+	inline entt::handle ScriptScheduler::GetCurrentOwner() const
+	{
+		return m_currentOwner;
+	}
+
+	inline Nz::UInt64 ScriptScheduler::GetCurrentTick() const
+	{
+		return m_currentTick;
+	}
+
+	inline std::size_t ScriptScheduler::GetPendingTaskCount() const
+	{
+		return m_pendingTaskCount;
+	}
+
+	template<typename F>
+	decltype(auto) ScriptScheduler::RunAsOwner(entt::handle owner, F&& func)
+	{
+		entt::handle previousOwner = std::exchange(m_currentOwner, owner);
+		NAZARA_DEFER(m_currentOwner = previousOwner;);
+
+		return std::forward<F>(func)();
+	}
+
+	constexpr auto ScriptScheduler::BuildTaskId(std::size_t taskIndex, Nz::UInt32 generation) -> TaskId
+	{
+		// Generation makes ids of freed tasks invalid once their slot is reused
+		return (TaskId(generation) << 32) | TaskId(taskIndex);
+	}
+}
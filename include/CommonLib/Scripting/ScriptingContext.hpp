@@ -8,6 +8,8 @@
 #define TSOM_COMMONLIB_SCRIPTING_SCRIPTINGCONTEXT_HPP
 
 #include <CommonLib/Export.hpp>
+#include <CommonLib/Scripting/ScriptProfiler.hpp>
+#include <CommonLib/Scripting/ScriptScheduler.hpp>
 #include <NazaraUtils/Result.hpp>
 #include <sol/sol.hpp>
 #include <memory>
@@ -34,6 +36,11 @@ namespace tsom
 
 			Nz::Result<sol::object, std::string> Execute(std::string_view str, const std::string& origin);
 
+			inline ScriptProfiler& GetProfiler();
+			inline const ScriptProfiler& GetProfiler() const;
+			inline ScriptScheduler& GetScheduler();
+			inline const ScriptScheduler& GetScheduler() const;
+
 			void LoadDirectory(std::string_view directoryPath);
 			Nz::Result<sol::object, std::string> LoadFile(const std::string& filePath);
 
@@ -50,6 +57,8 @@ namespace tsom
 			std::vector<std::unique_ptr<ScriptingLibrary>> m_libraries;
 			PrintCallback m_printCallback;
 			Nz::ApplicationBase& m_app;
+			ScriptProfiler m_profiler;
+			ScriptScheduler m_scheduler;
 	};
 }
 
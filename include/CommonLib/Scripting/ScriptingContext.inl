@@ -4,6 +4,26 @@
 
 namespace tsom
 {
+	inline ScriptProfiler& ScriptingContext::GetProfiler()
+	{
+		return m_profiler;
+	}
+
+	inline const ScriptProfiler& ScriptingContext::GetProfiler() const
+	{
+		return m_profiler;
+	}
+
+	inline ScriptScheduler& ScriptingContext::GetScheduler()
+	{
+		return m_scheduler;
+	}
+
+	inline const ScriptScheduler& ScriptingContext::GetScheduler() const
+	{
+		return m_scheduler;
+	}
+
 	template<typename T, typename... Args>
 	T& ScriptingContext::RegisterLibrary(Args&&... args)
 	{
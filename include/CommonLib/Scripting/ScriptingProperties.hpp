@@ -13,8 +13,11 @@
 
 namespace tsom
 {
+	class ClassInstanceComponent;
+
 	TSOM_COMMONLIB_API EntityProperty TranslatePropertyFromLua(sol::object value, EntityPropertyType expectedType, bool isArray);
 	TSOM_COMMONLIB_API sol::object TranslatePropertyToLua(sol::state_view& lua, const EntityProperty& property);
+	TSOM_COMMONLIB_API sol::object TranslatePropertyToLua(sol::state_view& lua, const ClassInstanceComponent& classInstance, Nz::UInt32 propertyIndex);
 }
 
 #include <CommonLib/Scripting/ScriptingProperties.inl>
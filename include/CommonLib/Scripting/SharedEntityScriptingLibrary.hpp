@@ -15,11 +15,14 @@
 namespace tsom
 {
 	class EntityRegistry;
+	class ScriptProfiler;
+	class ScriptScheduler;
+	struct ScriptedClass;
 
 	class TSOM_COMMONLIB_API SharedEntityScriptingLibrary : public ScriptingLibrary
 	{
 		public:
-			inline SharedEntityScriptingLibrary(EntityRegistry& entityRegistry);
+			inline SharedEntityScriptingLibrary(EntityRegistry& entityRegistry, ScriptProfiler& profiler, ScriptScheduler& scheduler);
 			SharedEntityScriptingLibrary(const SharedEntityScriptingLibrary&) = delete;
 			SharedEntityScriptingLibrary(SharedEntityScriptingLibrary&&) = delete;
 			virtual ~SharedEntityScriptingLibrary();
@@ -48,13 +51,18 @@ namespace tsom
 			virtual void FillConstants(sol::state& state, sol::table constants);
 			virtual void FillEntityMetatable(sol::state& state, sol::table entityMetatable);
 
-			virtual void HandleInit(sol::table classMetatable, entt::handle entity);
+			inline ScriptProfiler& GetProfiler();
+			inline ScriptScheduler& GetScheduler();
+
+			virtual void HandleInit(const ScriptedClass& scriptedClass, entt::handle entity);
 			virtual bool RegisterEvent(sol::table classMetatable, std::string_view eventName, sol::protected_function callback);
+			virtual void ResolveCallbacks(std::string_view className, ScriptedClass& scriptedClass);
 
 			virtual AddComponentFunc RetrieveAddComponentHandler(std::string_view componentType);
 			virtual GetComponentFunc RetrieveGetComponentHandler(std::string_view componentType);
 
 		private:
+			void OnScriptedEntityDestroy(entt::registry& registry, entt::entity entity);
 			void RegisterComponents(sol::state& state);
 			void RegisterConstants(sol::state& state);
 			void RegisterEntityBuilder(sol::state& state);
@@ -63,6 +71,8 @@ namespace tsom
 			void RegisterPhysics(sol::state& state);
 
 			EntityRegistry& m_entityRegistry;
+			ScriptProfiler& m_profiler;
+			ScriptScheduler& m_scheduler;
 			sol::table m_entityMetatable;
 	};
 }
@@ -4,11 +4,23 @@
 
 namespace tsom
 {
-	inline SharedEntityScriptingLibrary::SharedEntityScriptingLibrary(EntityRegistry& entityRegistry) :
-	m_entityRegistry(entityRegistry)
+	inline SharedEntityScriptingLibrary::SharedEntityScriptingLibrary(EntityRegistry& entityRegistry, ScriptProfiler& profiler, ScriptScheduler& scheduler) :
+	m_entityRegistry(entityRegistry),
+	m_profiler(profiler),
+	m_scheduler(scheduler)
 	{
 	}
 
+	inline ScriptProfiler& SharedEntityScriptingLibrary::GetProfiler()
+	{
+		return m_profiler;
+	}
+
+	inline ScriptScheduler& SharedEntityScriptingLibrary::GetScheduler()
+	{
+		return m_scheduler;
+	}
+
 	template<typename T>
 	constexpr auto SharedEntityScriptingLibrary::ComponentEntry::DefaultAdd() -> AddComponentFunc
 	{
@@ -38,7 +38,7 @@ namespace tsom
 			Nz::UInt32 GetProtocolVersion() const;
 			inline NetworkSession* GetSession() const;
 
-			void HandlePacket(Nz::ByteArray&& byteArray);
+			virtual void HandlePacket(Nz::ByteArray&& byteArray);
 
 			virtual void OnDeserializationError(std::size_t packetIndex);
 			virtual void OnUnexpectedPacket(std::size_t packetIndex);
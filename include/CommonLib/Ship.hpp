@@ -34,6 +34,7 @@ namespace tsom
 			std::shared_ptr<Nz::Collider3D> BuildHullCollider() const;
 
 			GravityForce ComputeGravity(const Nz::Vector3f& position) const override;
+			void ComputeGravityBatch(std::span<const Nz::Vector3f> positions, std::span<GravityForce> forces) const override;
 
 			void ForEachChunk(Nz::FunctionRef<void(const ChunkIndices& chunkIndices, Chunk& chunk)> callback) override;
 			void ForEachChunk(Nz::FunctionRef<void(const ChunkIndices& chunkIndices, const Chunk& chunk)> callback) const override;
@@ -45,6 +46,8 @@ namespace tsom
 			inline const FlatChunk* GetChunk(const ChunkIndices& chunkIndices) const override;
 			inline std::size_t GetChunkCount() const override;
 
+			bool HasUniformGravity() const override;
+
 			void RemoveChunk(const ChunkIndices& indices) override;
 
 			inline void UpdateUpDirection(const Nz::Vector3f& upDirection);
@@ -23,6 +23,7 @@ namespace tsom
 			ShipController(ShipController&&) = delete;
 			~ShipController() = default;
 
+			inline entt::handle GetEntity() const;
 			inline const Nz::Quaternionf& GetReferenceRotation() const;
 
 			void PostSimulate(CharacterController& characterOwner, float elapsedTime);
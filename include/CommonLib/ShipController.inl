@@ -10,6 +10,11 @@ namespace tsom
 	{
 	}
 
+	inline entt::handle ShipController::GetEntity() const
+	{
+		return m_entity;
+	}
+
 	inline const Nz::Quaternionf& ShipController::GetReferenceRotation() const
 	{
 		return m_rotation;
@@ -8,19 +8,23 @@
 #define TSOM_COMMONLIB_SYSTEMS_GRAVITYPHYSICSSYSTEM_HPP
 
 #include <CommonLib/Export.hpp>
+#include <CommonLib/GravityForce.hpp>
 #include <Nazara/Core/Time.hpp>
 #include <Nazara/Physics3D/PhysWorld3DStepListener.hpp>
 #include <NazaraUtils/TypeList.hpp>
-#include <entt/fwd.hpp>
+#include <entt/entt.hpp>
+#include <vector>
 
 namespace Nz
 {
 	class PhysWorld3D;
+	class RigidBody3DComponent;
 }
 
 namespace tsom
 {
 	class GravityController;
+	struct GravityCacheComponent;
 
 	class TSOM_COMMONLIB_API GravityPhysicsSystem : public Nz::PhysWorld3DStepListener
 	{
@@ -35,8 +39,23 @@ namespace tsom
 			GravityPhysicsSystem& operator=(const GravityPhysicsSystem&) = delete;
 			GravityPhysicsSystem& operator=(GravityPhysicsSystem&&) = delete;
 
+			static constexpr float GravityRefreshDistance = 0.25f;
+
 		private:
+			void OnCharacterConstruct(entt::registry& registry, entt::entity entity);
+
+			struct RigidBodyGravity
+			{
+				Nz::RigidBody3DComponent* rigidBody;
+				GravityCacheComponent* gravityCache;
+			};
+
+			std::vector<GravityForce> m_refreshedGravities;
+			std::vector<RigidBodyGravity> m_rigidBodies;
+			std::vector<std::size_t> m_refreshedBodyIndices;
+			std::vector<Nz::Vector3f> m_refreshedPositions;
 			entt::registry& m_registry;
+			entt::scoped_connection m_characterConstructConnection;
 			const GravityController& m_gravityController;
 			Nz::PhysWorld3D& m_physWorld;
 	};
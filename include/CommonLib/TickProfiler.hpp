@@ -0,0 +1,69 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_COMMONLIB_TICKPROFILER_HPP
+#define TSOM_COMMONLIB_TICKPROFILER_HPP
+
+#include <CommonLib/Export.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace tsom
+{
+	// Records scoped zones from any thread in per-thread ring buffers, to find out which part of a tick is slow
+	class TSOM_COMMONLIB_API TickProfiler
+	{
+		public:
+			class Zone;
+			struct ZoneStats;
+
+			TickProfiler() = delete;
+
+			static std::string BuildReport(Nz::Time window);
+
+			static std::vector<ZoneStats> ComputeStats(Nz::Time window);
+
+			static bool DumpChromeTrace(const std::filesystem::path& filePath);
+
+			struct ZoneStats
+			{
+				std::string name;
+				std::size_t sampleCount = 0;
+				Nz::Time maxTime = Nz::Time::Zero();
+				Nz::Time p50Time = Nz::Time::Zero();
+				Nz::Time p99Time = Nz::Time::Zero();
+				Nz::Time totalTime = Nz::Time::Zero();
+			};
+
+			static constexpr std::size_t MaxEventPerThread = 32 * 1024;
+
+		private:
+			static void RecordZone(const char* name, Nz::Time startTime, Nz::Time endTime);
+	};
+
+	class TickProfiler::Zone
+	{
+		public:
+			inline explicit Zone(const char* name);
+			Zone(const Zone&) = delete;
+			Zone(Zone&&) = delete;
+			inline ~Zone();
+
+			Zone& operator=(const Zone&) = delete;
+			Zone& operator=(Zone&&) = delete;
+
+		private:
+			const char* m_name;
+			Nz::Time m_startTime;
+	};
+}
+
+#include <CommonLib/TickProfiler.inl>
+
+#endif // TSOM_COMMONLIB_TICKPROFILER_HPP
@@ -0,0 +1,17 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+namespace tsom
+{
+	inline TickProfiler::Zone::Zone(const char* name) :
+	m_name(name),
+	m_startTime(Nz::GetElapsedNanoseconds())
+	{
+	}
+
+	inline TickProfiler::Zone::~Zone()
+	{
+		RecordZone(m_name, m_startTime, Nz::GetElapsedNanoseconds());
+	}
+}
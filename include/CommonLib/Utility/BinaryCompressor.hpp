@@ -14,9 +14,19 @@
 #include <vector>
 
 typedef union LZ4_stream_u LZ4_stream_t;
+typedef union LZ4_streamHC_u LZ4_streamHC_t;
 
 namespace tsom
 {
+	class CompressionDictionary;
+
+	struct CompressionSettings
+	{
+		const CompressionDictionary* dictionary = nullptr;
+		int acceleration = 1; //< LZ4 fast mode acceleration, ignored in high compression mode
+		int highCompressionLevel = 0; //< 0 for fast mode, LZ4HC compression level otherwise
+	};
+
 	class TSOM_COMMONLIB_API BinaryCompressor
 	{
 		public:
@@ -25,8 +35,9 @@ namespace tsom
 			BinaryCompressor(BinaryCompressor&&) noexcept = default;
 			~BinaryCompressor();
 
-			std::optional<std::span<Nz::UInt8>> Compress(const void* data, std::size_t size);
-			std::optional<std::size_t> Decompress(const void* compressedData, std::size_t compressedSize, void* output, std::size_t maxOutputSize);
+			inline std::optional<std::span<Nz::UInt8>> Compress(const void* data, std::size_t size);
+			std::optional<std::span<Nz::UInt8>> Compress(const void* data, std::size_t size, const CompressionSettings& settings);
+			std::optional<std::size_t> Decompress(const void* compressedData, std::size_t compressedSize, void* output, std::size_t maxOutputSize, const CompressionDictionary* dictionary = nullptr);
 
 			BinaryCompressor& operator=(const BinaryCompressor&) = delete;
 			BinaryCompressor& operator=(BinaryCompressor&&) noexcept = default;
@@ -34,8 +45,14 @@ namespace tsom
 			static BinaryCompressor& GetThreadCompressor();
 
 		private:
+			int CompressFast(const char* src, char* dst, int srcSize, int dstCapacity, const CompressionSettings& settings);
+			int CompressHC(const char* src, char* dst, int srcSize, int dstCapacity, const CompressionSettings& settings);
+
 			std::vector<Nz::UInt8> m_compressedData;
+			Nz::MovablePtr<const CompressionDictionary> m_loadedDictionary;
+			Nz::MovablePtr<LZ4_stream_t> m_dictionaryState;
 			Nz::MovablePtr<LZ4_stream_t> m_state;
+			Nz::MovablePtr<LZ4_streamHC_t> m_stateHC;
 	};
 }
 
@@ -4,4 +4,8 @@
 
 namespace tsom
 {
+	inline std::optional<std::span<Nz::UInt8>> BinaryCompressor::Compress(const void* data, std::size_t size)
+	{
+		return Compress(data, size, CompressionSettings{});
+	}
 }
@@ -0,0 +1,51 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_COMMONLIB_UTILITY_COMPRESSIONDICTIONARY_HPP
+#define TSOM_COMMONLIB_UTILITY_COMPRESSIONDICTIONARY_HPP
+
+#include <CommonLib/Export.hpp>
+#include <NazaraUtils/Prerequisites.hpp>
+#include <filesystem>
+#include <vector>
+
+namespace tsom
+{
+	enum class CompressionDictionaryType
+	{
+		ChunkContent, //< raw block indices, as sent by ChunkReset
+		ChunkSave,    //< Chunk::Serialize output, as stored in ship saves
+
+		Max = ChunkSave
+	};
+
+	class TSOM_COMMONLIB_API CompressionDictionary
+	{
+		public:
+			inline CompressionDictionary(Nz::UInt32 id, std::vector<Nz::UInt8> data);
+			CompressionDictionary(const CompressionDictionary&) = delete;
+			CompressionDictionary(CompressionDictionary&&) noexcept = default;
+			~CompressionDictionary() = default;
+
+			inline const Nz::UInt8* GetData() const;
+			inline Nz::UInt32 GetId() const;
+			inline std::size_t GetSize() const;
+
+			CompressionDictionary& operator=(const CompressionDictionary&) = delete;
+			CompressionDictionary& operator=(CompressionDictionary&&) noexcept = default;
+
+			static const CompressionDictionary* Get(CompressionDictionaryType type);
+			static void LoadDirectory(const std::filesystem::path& directory);
+
+		private:
+			std::vector<Nz::UInt8> m_data;
+			Nz::UInt32 m_id;
+	};
+}
+
+#include <CommonLib/Utility/CompressionDictionary.inl>
+
+#endif // TSOM_COMMONLIB_UTILITY_COMPRESSIONDICTIONARY_HPP
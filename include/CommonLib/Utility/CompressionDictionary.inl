@@ -0,0 +1,27 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+namespace tsom
+{
+	inline CompressionDictionary::CompressionDictionary(Nz::UInt32 id, std::vector<Nz::UInt8> data) :
+	m_data(std::move(data)),
+	m_id(id)
+	{
+	}
+
+	inline const Nz::UInt8* CompressionDictionary::GetData() const
+	{
+		return m_data.data();
+	}
+
+	inline Nz::UInt32 CompressionDictionary::GetId() const
+	{
+		return m_id;
+	}
+
+	inline std::size_t CompressionDictionary::GetSize() const
+	{
+		return m_data.size();
+	}
+}
@@ -0,0 +1,60 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_COMMONLIB_UTILITY_RINGBUFFER_HPP
+#define TSOM_COMMONLIB_UTILITY_RINGBUFFER_HPP
+
+#include <array>
+#include <cstddef>
+
+namespace tsom
+{
+	// Fixed-capacity FIFO queue, elements are stored inline and never reallocated
+	template<typename T, std::size_t Capacity>
+	class RingBuffer
+	{
+		static_assert(Capacity > 0);
+
+		public:
+			RingBuffer();
+			RingBuffer(const RingBuffer&) = default;
+			RingBuffer(RingBuffer&&) = default;
+			~RingBuffer() = default;
+
+			T& Back();
+			const T& Back() const;
+
+			void Clear();
+
+			T& Front();
+			const T& Front() const;
+
+			std::size_t GetSize() const;
+
+			bool IsEmpty() const;
+			bool IsFull() const;
+
+			T PopFront();
+			void PushBack(T value);
+
+			T& operator[](std::size_t index);
+			const T& operator[](std::size_t index) const;
+
+			RingBuffer& operator=(const RingBuffer&) = default;
+			RingBuffer& operator=(RingBuffer&&) = default;
+
+			static constexpr std::size_t GetCapacity();
+
+		private:
+			std::array<T, Capacity> m_values;
+			std::size_t m_first;
+			std::size_t m_size;
+	};
+}
+
+#include <CommonLib/Utility/RingBuffer.inl>
+
+#endif // TSOM_COMMONLIB_UTILITY_RINGBUFFER_HPP
@@ -0,0 +1,108 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <cassert>
+#include <utility>
+
+namespace tsom
+{
+	template<typename T, std::size_t Capacity>
+	RingBuffer<T, Capacity>::RingBuffer() :
+	m_first(0),
+	m_size(0)
+	{
+	}
+
+	template<typename T, std::size_t Capacity>
+	T& RingBuffer<T, Capacity>::Back()
+	{
+		assert(!IsEmpty());
+		return operator[](m_size - 1);
+	}
+
+	template<typename T, std::size_t Capacity>
+	const T& RingBuffer<T, Capacity>::Back() const
+	{
+		assert(!IsEmpty());
+		return operator[](m_size - 1);
+	}
+
+	template<typename T, std::size_t Capacity>
+	void RingBuffer<T, Capacity>::Clear()
+	{
+		m_first = 0;
+		m_size = 0;
+	}
+
+	template<typename T, std::size_t Capacity>
+	T& RingBuffer<T, Capacity>::Front()
+	{
+		assert(!IsEmpty());
+		return m_values[m_first];
+	}
+
+	template<typename T, std::size_t Capacity>
+	const T& RingBuffer<T, Capacity>::Front() const
+	{
+		assert(!IsEmpty());
+		return m_values[m_first];
+	}
+
+	template<typename T, std::size_t Capacity>
+	std::size_t RingBuffer<T, Capacity>::GetSize() const
+	{
+		return m_size;
+	}
+
+	template<typename T, std::size_t Capacity>
+	bool RingBuffer<T, Capacity>::IsEmpty() const
+	{
+		return m_size == 0;
+	}
+
+	template<typename T, std::size_t Capacity>
+	bool RingBuffer<T, Capacity>::IsFull() const
+	{
+		return m_size == Capacity;
+	}
+
+	template<typename T, std::size_t Capacity>
+	T RingBuffer<T, Capacity>::PopFront()
+	{
+		assert(!IsEmpty());
+		T value = std::move(m_values[m_first]);
+		m_first = (m_first + 1) % Capacity;
+		m_size--;
+
+		return value;
+	}
+
+	template<typename T, std::size_t Capacity>
+	void RingBuffer<T, Capacity>::PushBack(T value)
+	{
+		assert(!IsFull());
+		m_values[(m_first + m_size) % Capacity] = std::move(value);
+		m_size++;
+	}
+
+	template<typename T, std::size_t Capacity>
+	T& RingBuffer<T, Capacity>::operator[](std::size_t index)
+	{
+		assert(index < m_size);
+		return m_values[(m_first + index) % Capacity];
+	}
+
+	template<typename T, std::size_t Capacity>
+	const T& RingBuffer<T, Capacity>::operator[](std::size_t index) const
+	{
+		assert(index < m_size);
+		return m_values[(m_first + index) % Capacity];
+	}
+
+	template<typename T, std::size_t Capacity>
+	constexpr std::size_t RingBuffer<T, Capacity>::GetCapacity()
+	{
+		return Capacity;
+	}
+}
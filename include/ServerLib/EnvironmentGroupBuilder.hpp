@@ -0,0 +1,47 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_SERVERLIB_ENVIRONMENTGROUPBUILDER_HPP
+#define TSOM_SERVERLIB_ENVIRONMENTGROUPBUILDER_HPP
+
+#include <ServerLib/Export.hpp>
+#include <span>
+#include <vector>
+
+namespace tsom
+{
+	// Splits environments (by index) into groups which can be updated concurrently, linked environments end up in the same group
+	class TSOM_SERVERLIB_API EnvironmentGroupBuilder
+	{
+		public:
+			EnvironmentGroupBuilder() = default;
+			EnvironmentGroupBuilder(const EnvironmentGroupBuilder&) = delete;
+			EnvironmentGroupBuilder(EnvironmentGroupBuilder&&) = delete;
+			~EnvironmentGroupBuilder() = default;
+
+			void Begin(std::size_t environmentCount);
+			std::size_t Build();
+
+			inline std::span<const std::size_t> GetGroup(std::size_t groupIndex) const;
+			inline std::size_t GetGroupCount() const;
+
+			void Link(std::size_t firstEnvironment, std::size_t secondEnvironment);
+
+			EnvironmentGroupBuilder& operator=(const EnvironmentGroupBuilder&) = delete;
+			EnvironmentGroupBuilder& operator=(EnvironmentGroupBuilder&&) = delete;
+
+		private:
+			std::size_t FindRoot(std::size_t environmentIndex);
+
+			std::size_t m_groupCount = 0;
+			std::vector<std::size_t> m_parentIndices;
+			std::vector<std::vector<std::size_t>> m_groups; //< kept between builds to reuse their memory
+	};
+}
+
+#include <ServerLib/EnvironmentGroupBuilder.inl>
+
+#endif // TSOM_SERVERLIB_ENVIRONMENTGROUPBUILDER_HPP
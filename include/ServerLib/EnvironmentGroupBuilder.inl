@@ -0,0 +1,19 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <cassert>
+
+namespace tsom
+{
+	inline std::span<const std::size_t> EnvironmentGroupBuilder::GetGroup(std::size_t groupIndex) const
+	{
+		assert(groupIndex < m_groupCount);
+		return m_groups[groupIndex];
+	}
+
+	inline std::size_t EnvironmentGroupBuilder::GetGroupCount() const
+	{
+		return m_groupCount;
+	}
+}
@@ -20,9 +20,10 @@ namespace tsom
 		private:
 			void FillEntityMetatable(sol::state& state, sol::table entityMetatable) override;
 
-			void HandleInit(sol::table classMetatable, entt::handle entity) override;
+			void HandleInit(const ScriptedClass& scriptedClass, entt::handle entity) override;
 
 			bool RegisterEvent(sol::table classMetatable, std::string_view eventName, sol::protected_function callback) override;
+			void ResolveCallbacks(std::string_view className, ScriptedClass& scriptedClass) override;
 	};
 }
 
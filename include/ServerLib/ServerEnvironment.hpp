@@ -13,7 +13,9 @@
 #include <Nazara/Core/EnttWorld.hpp>
 #include <Nazara/Core/Node.hpp>
 #include <tsl/hopscotch_map.h>
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace Nz
 {
@@ -43,6 +45,10 @@ namespace tsom
 			virtual entt::handle CreateEntity() = 0;
 			void Disconnect(ServerEnvironment& environment);
 
+			template<typename F> void ExecuteSerialized(F&& callback);
+
+			void FlushSerializedCallbacks();
+
 			template<typename F> void ForEachConnectedEnvironment(F&& callback) const;
 			template<typename F> void ForEachPlayer(F&& callback);
 			template<typename F> void ForEachPlayer(F&& callback) const;
@@ -60,6 +66,7 @@ namespace tsom
 			void UnregisterPlayer(ServerPlayer* player);
 
 			inline void UpdateConnectedTransform(ServerEnvironment& environment, const EnvironmentTransform& transform);
+			void UpdateWorld(Nz::Time elapsedTime);
 
 			ServerEnvironment& operator=(const ServerEnvironment&) = delete;
 			ServerEnvironment& operator=(ServerEnvironment&&) = delete;
@@ -68,10 +75,12 @@ namespace tsom
 			ServerEnvironment(ServerInstance& serverInstance, ServerEnvironmentType type);
 
 			std::unique_ptr<Nz::EnttWorld> m_world;
+			std::vector<std::function<void()>> m_serializedCallbacks;
 			tsl::hopscotch_map<ServerEnvironment*, EnvironmentTransform> m_connectedEnvironments;
 			Nz::Bitset<Nz::UInt64> m_registeredPlayers;
 			ServerEnvironmentType m_type;
 			ServerInstance& m_serverInstance;
+			bool m_isUpdatingWorld;
 	};
 }
 
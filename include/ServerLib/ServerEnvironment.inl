@@ -18,6 +18,17 @@ namespace tsom
 		return true;
 	}
 
+	template<typename F>
+	void ServerEnvironment::ExecuteSerialized(F&& callback)
+	{
+		// World updates of independent environments may run concurrently, anything touching another environment
+		// or a player has to wait for the serial phase of the tick
+		if (m_isUpdatingWorld)
+			m_serializedCallbacks.emplace_back(std::forward<F>(callback));
+		else
+			callback();
+	}
+
 	template<typename F>
 	void ServerEnvironment::ForEachConnectedEnvironment(F&& callback) const
 	{
@@ -12,13 +12,17 @@
 #include <CommonLib/EntityRegistry.hpp>
 #include <CommonLib/NetworkSessionManager.hpp>
 #include <CommonLib/Scripting/ScriptingContext.hpp>
+#include <ServerLib/EnvironmentGroupBuilder.hpp>
 #include <ServerLib/ServerPlayer.hpp>
 #include <Nazara/Core/Clock.hpp>
 #include <NazaraUtils/Bitset.hpp>
 #include <NazaraUtils/MemoryPool.hpp>
 #include <NazaraUtils/PathUtils.hpp>
+#include <tsl/hopscotch_map.h>
 #include <array>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
@@ -31,11 +35,14 @@ namespace Nz
 namespace tsom
 {
 	class ServerPlanetEnvironment;
+	class ServerRecorder;
 	class ServerShipEnvironment;
 
 	class TSOM_SERVERLIB_API ServerInstance
 	{
 		friend class ServerEnvironment;
+		friend class ServerPlayer;
+		friend class ServerReplayer;
 
 		public:
 			struct Config;
@@ -54,8 +61,12 @@ namespace tsom
 			ServerPlayer* CreateAuthenticatedPlayer(NetworkSession* session, const Nz::Uuid& uuid, std::string nickname, PlayerPermissionFlags permissions);
 			void DestroyPlayer(PlayerIndex playerIndex);
 
+			void DumpNetworkStatistics(std::filesystem::path filePath);
+
 			inline ServerPlayer* FindPlayerByNickname(std::string_view nickname);
 			inline const ServerPlayer* FindPlayerByNickname(std::string_view nickname) const;
+			inline ServerPlayer* FindPlayerBySession(const NetworkSession* session);
+			inline const ServerPlayer* FindPlayerBySession(const NetworkSession* session) const;
 			inline ServerPlayer* FindPlayerByUuid(const Nz::Uuid& uuid);
 			inline const ServerPlayer* FindPlayerByUuid(const Nz::Uuid& uuid) const;
 
@@ -64,17 +75,27 @@ namespace tsom
 
 			inline Nz::ApplicationBase& GetApplication();
 			inline const BlockLibrary& GetBlockLibrary() const;
+			inline float GetChunkColliderDistance() const;
 			inline const std::array<std::uint8_t, 32>& GetConnectionTokenEncryptionKey() const;
 			inline const Spawnpoint& GetDefaultSpawnpoint() const;
 			inline EntityRegistry& GetEntityRegistry();
 			inline const EntityRegistry& GetEntityRegistry() const;
+			inline std::size_t GetMaxInputBacklog() const;
 			inline ServerPlayer* GetPlayer(PlayerIndex playerIndex);
 			inline const ServerPlayer* GetPlayer(PlayerIndex playerIndex) const;
+			inline ServerRecorder* GetRecorder();
+			inline ScriptingContext& GetScriptingContext();
+			inline const ScriptingContext& GetScriptingContext() const;
 			inline Nz::Time GetTickDuration() const;
 
 			std::unique_ptr<Nz::EnttWorld> RegisterEnvironment(ServerEnvironment* environment);
 
+			void ResetNetworkStatistics();
+
 			inline void SetDefaultSpawnpoint(ServerEnvironment* environment, Nz::Vector3f position, Nz::Quaternionf rotation);
+			void SetRecorder(std::unique_ptr<ServerRecorder> recorder);
+
+			NetworkStatistics::Snapshot TakeNetworkStatisticsSnapshot() const;
 
 			void UnregisterEnvironment(ServerEnvironment* environment, std::unique_ptr<Nz::EnttWorld>&& world);
 
@@ -87,6 +108,10 @@ namespace tsom
 			{
 				std::array<std::uint8_t, 32> connectionTokenEncryptionKey;
 				Nz::Time saveInterval = Nz::Time::Seconds(30);
+				Nz::Time scriptCallbackBudget = Nz::Time::Milliseconds(10); //< below a tick duration so a single callback can't make the server miss ticks
+				float chunkColliderDistance = 64.f;
+				std::size_t maxInputBacklog = 6;
+				bool parallelWorldUpdate = true;
 				bool pauseWhenEmpty = true;
 			};
 
@@ -98,10 +123,25 @@ namespace tsom
 			};
 
 		private:
+			struct NetworkStatisticsDump;
+
 			void LoadScripts(bool isReloading = false);
 			void OnNetworkTick();
 			void OnSave();
 			void OnTick(Nz::Time elapsedTime);
+			void UpdateEnvironmentWorlds(Nz::Time elapsedTime);
+			void UpdateNetworkStatisticsDumps();
+			void UpdatePlayerNickname(ServerPlayer& player, std::string_view previousNickname);
+
+			struct NicknameHash
+			{
+				using is_transparent = void;
+
+				std::size_t operator()(std::string_view nickname) const
+				{
+					return std::hash<std::string_view>{}(nickname);
+				}
+			};
 
 			struct PlayerRename
 			{
@@ -111,22 +151,31 @@ namespace tsom
 
 			std::array<std::uint8_t, 32> m_connectionTokenEncryptionKey;
 			std::vector<std::unique_ptr<NetworkSessionManager>> m_sessionManagers;
+			std::size_t m_maxInputBacklog;
 			std::vector<PlayerRename> m_pendingPlayerRename;
 			std::vector<ServerEnvironment*> m_environments;
+			EnvironmentGroupBuilder m_environmentGroupBuilder;
 			std::vector<std::unique_ptr<Nz::EnttWorld>> m_envWorldPool;
+			std::vector<std::shared_ptr<NetworkStatisticsDump>> m_pendingNetworkStatisticsDumps;
+			std::unique_ptr<ServerRecorder> m_recorder;
 			Nz::Bitset<> m_disconnectedPlayers;
 			Nz::Bitset<> m_newPlayers;
 			Nz::MemoryPool<ServerPlayer> m_players;
+			tsl::hopscotch_map<std::string, PlayerIndex, NicknameHash, std::equal_to<>> m_playerByNickname;
+			tsl::hopscotch_map<const NetworkSession*, PlayerIndex> m_playerBySession;
+			tsl::hopscotch_map<Nz::Uuid, PlayerIndex> m_playerByUuid;
 			Nz::MillisecondClock m_saveClock;
 			Nz::Time m_saveInterval;
 			Nz::Time m_tickAccumulator;
 			Nz::Time m_tickDuration;
 			Nz::UInt16 m_tickIndex;
+			float m_chunkColliderDistance;
 			Nz::ApplicationBase& m_application;
 			BlockLibrary m_blockLibrary;
 			ScriptingContext m_scriptingContext;
 			EntityRegistry m_entityRegistry;
 			Spawnpoint m_defaultSpawnpoint;
+			bool m_parallelWorldUpdate;
 			bool m_pauseWhenEmpty;
 	};
 }
@@ -12,46 +12,56 @@ namespace tsom
 
 	inline ServerPlayer* ServerInstance::FindPlayerByNickname(std::string_view nickname)
 	{
-		for (ServerPlayer& serverPlayer : m_players)
-		{
-			if (serverPlayer.GetNickname() == nickname)
-				return &serverPlayer;
-		}
+		auto it = m_playerByNickname.find(nickname);
+		if (it == m_playerByNickname.end())
+			return nullptr;
 
-		return nullptr;
+		return m_players.RetrieveFromIndex(it->second);
 	}
 
 	inline const ServerPlayer* ServerInstance::FindPlayerByNickname(std::string_view nickname) const
 	{
-		for (const ServerPlayer& serverPlayer : m_players)
-		{
-			if (serverPlayer.GetNickname() == nickname)
-				return &serverPlayer;
-		}
+		auto it = m_playerByNickname.find(nickname);
+		if (it == m_playerByNickname.end())
+			return nullptr;
+
+		return m_players.RetrieveFromIndex(it->second);
+	}
+
+	inline ServerPlayer* ServerInstance::FindPlayerBySession(const NetworkSession* session)
+	{
+		auto it = m_playerBySession.find(session);
+		if (it == m_playerBySession.end())
+			return nullptr;
+
+		return m_players.RetrieveFromIndex(it->second);
+	}
+
+	inline const ServerPlayer* ServerInstance::FindPlayerBySession(const NetworkSession* session) const
+	{
+		auto it = m_playerBySession.find(session);
+		if (it == m_playerBySession.end())
+			return nullptr;
 
-		return nullptr;
+		return m_players.RetrieveFromIndex(it->second);
 	}
 
 	inline ServerPlayer* ServerInstance::FindPlayerByUuid(const Nz::Uuid& uuid)
 	{
-		for (ServerPlayer& serverPlayer : m_players)
-		{
-			if (serverPlayer.GetUuid() == uuid)
-				return &serverPlayer;
-		}
+		auto it = m_playerByUuid.find(uuid);
+		if (it == m_playerByUuid.end())
+			return nullptr;
 
-		return nullptr;
+		return m_players.RetrieveFromIndex(it->second);
 	}
 
 	inline const ServerPlayer* ServerInstance::FindPlayerByUuid(const Nz::Uuid& uuid) const
 	{
-		for (const ServerPlayer& serverPlayer : m_players)
-		{
-			if (serverPlayer.GetUuid() == uuid)
-				return &serverPlayer;
-		}
+		auto it = m_playerByUuid.find(uuid);
+		if (it == m_playerByUuid.end())
+			return nullptr;
 
-		return nullptr;
+		return m_players.RetrieveFromIndex(it->second);
 	}
 
 	template<typename F> void ServerInstance::ForEachPlayer(F&& functor)
@@ -76,6 +86,11 @@ namespace tsom
 		return m_blockLibrary;
 	}
 
+	inline float ServerInstance::GetChunkColliderDistance() const
+	{
+		return m_chunkColliderDistance;
+	}
+
 	inline const std::array<std::uint8_t, 32>& ServerInstance::GetConnectionTokenEncryptionKey() const
 	{
 		return m_connectionTokenEncryptionKey;
@@ -96,6 +111,11 @@ namespace tsom
 		return m_entityRegistry;
 	}
 
+	inline std::size_t ServerInstance::GetMaxInputBacklog() const
+	{
+		return m_maxInputBacklog;
+	}
+
 	inline ServerPlayer* ServerInstance::GetPlayer(PlayerIndex playerIndex)
 	{
 		return m_players.RetrieveFromIndex(playerIndex);
@@ -106,6 +126,21 @@ namespace tsom
 		return m_players.RetrieveFromIndex(playerIndex);
 	}
 
+	inline ServerRecorder* ServerInstance::GetRecorder()
+	{
+		return m_recorder.get();
+	}
+
+	inline ScriptingContext& ServerInstance::GetScriptingContext()
+	{
+		return m_scriptingContext;
+	}
+
+	inline const ScriptingContext& ServerInstance::GetScriptingContext() const
+	{
+		return m_scriptingContext;
+	}
+
 	inline Nz::Time ServerInstance::GetTickDuration() const
 	{
 		return m_tickDuration;
@@ -35,6 +35,7 @@ namespace tsom
 			inline entt::handle GetPlanetEntity() const;
 
 			void OnSave() override;
+			void OnTick(Nz::Time elapsedTime) override;
 
 			ServerPlanetEnvironment& operator=(const ServerPlanetEnvironment&) = delete;
 			ServerPlanetEnvironment& operator=(ServerPlanetEnvironment&&) = delete;
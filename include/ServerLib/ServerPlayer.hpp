@@ -9,7 +9,9 @@
 
 #include <ServerLib/Export.hpp>
 #include <CommonLib/PlayerIndex.hpp>
+#include <CommonLib/PlayerInputs.hpp>
 #include <CommonLib/PlayerPermission.hpp>
+#include <CommonLib/Utility/RingBuffer.hpp>
 #include <ServerLib/SessionVisibilityHandler.hpp>
 #include <Nazara/Core/HandledObject.hpp>
 #include <Nazara/Core/ObjectHandle.hpp>
@@ -90,12 +92,14 @@ namespace tsom
 			void ClearEnvironments();
 			void HandleNewEnvironment(ServerEnvironment* environment, const EnvironmentTransform& transform);
 
+			static constexpr std::size_t InputQueueCapacity = 64;
+
 			std::optional<Nz::Uuid> m_uuid;
 			std::shared_ptr<CharacterController> m_controller;
 			std::string m_nickname;
 			std::unique_ptr<ServerShipEnvironment> m_ship;
-			std::vector<PlayerInputs> m_inputQueue;
 			std::vector<ServerEnvironment*> m_registeredEnvironments;
+			RingBuffer<PlayerInputs, InputQueueCapacity> m_inputQueue;
 			entt::handle m_controlledEntity;
 			NetworkSession* m_session;
 			ServerEnvironment* m_controlledEntityEnvironment;
@@ -0,0 +1,77 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_SERVERLIB_SERVERRECORDER_HPP
+#define TSOM_SERVERLIB_SERVERRECORDER_HPP
+
+#include <ServerLib/Export.hpp>
+#include <CommonLib/PlayerPermission.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/Uuid.hpp>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace tsom
+{
+	class ServerPlayer;
+
+	// Writes everything players send to the server along with the tick it was received at, so a session can be replayed offline (see ServerReplayer)
+	class TSOM_SERVERLIB_API ServerRecorder
+	{
+		public:
+			enum class EventType : Nz::UInt8;
+
+			ServerRecorder(const std::filesystem::path& filePath, Nz::UInt32 seed, const std::filesystem::path& saveDirectory);
+			ServerRecorder(const ServerRecorder&) = delete;
+			ServerRecorder(ServerRecorder&&) = delete;
+			~ServerRecorder();
+
+			void Flush();
+
+			inline Nz::UInt64 GetTickCount() const;
+
+			void OnTick();
+
+			void RecordPacket(std::size_t peerId, const Nz::ByteArray& packet);
+			void RecordPlayerJoin(std::size_t peerId, const ServerPlayer& player, Nz::UInt32 protocolVersion);
+			void RecordPlayerJoin(std::size_t peerId, const std::string& nickname, const std::optional<Nz::Uuid>& uuid, PlayerPermissionFlags permissions, Nz::UInt32 protocolVersion);
+			void RecordPlayerLeave(std::size_t peerId);
+
+			ServerRecorder& operator=(const ServerRecorder&) = delete;
+			ServerRecorder& operator=(ServerRecorder&&) = delete;
+
+			enum class EventType : Nz::UInt8
+			{
+				End,
+				Packet,
+				PlayerJoin,
+				PlayerLeave
+			};
+
+			static constexpr Nz::UInt32 FileMagic = 0x43455254; //< "TREC"
+			static constexpr Nz::UInt16 FileVersion = 1;
+			static constexpr Nz::Time FlushInterval = Nz::Time::Seconds(1);
+			static constexpr std::size_t FlushSize = 64 * 1024;
+
+		private:
+			void BeginEvent(EventType eventType, std::size_t peerId);
+
+			Nz::ByteArray m_buffer;
+			Nz::ByteStream m_bufferStream;
+			Nz::File m_file;
+			Nz::MillisecondClock m_flushClock;
+			Nz::UInt64 m_lastEventTick;
+			Nz::UInt64 m_tickCount;
+	};
+}
+
+#include <ServerLib/ServerRecorder.inl>
+
+#endif // TSOM_SERVERLIB_SERVERRECORDER_HPP
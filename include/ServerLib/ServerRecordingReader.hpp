@@ -0,0 +1,77 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_SERVERLIB_SERVERRECORDINGREADER_HPP
+#define TSOM_SERVERLIB_SERVERRECORDINGREADER_HPP
+
+#include <ServerLib/Export.hpp>
+#include <CommonLib/PlayerPermission.hpp>
+#include <ServerLib/ServerRecorder.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Uuid.hpp>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tsom
+{
+	// Parses a ServerRecorder recording, event by event
+	class TSOM_SERVERLIB_API ServerRecordingReader
+	{
+		public:
+			struct Event;
+
+			ServerRecordingReader(const std::filesystem::path& filePath);
+			ServerRecordingReader(const ServerRecordingReader&) = delete;
+			ServerRecordingReader(ServerRecordingReader&&) = delete;
+			~ServerRecordingReader() = default;
+
+			bool ExtractSaveFiles(const std::filesystem::path& directory) const;
+
+			inline Nz::UInt32 GetSeed() const;
+
+			void ReadEvent(Event& event);
+
+			ServerRecordingReader& operator=(const ServerRecordingReader&) = delete;
+			ServerRecordingReader& operator=(ServerRecordingReader&&) = delete;
+
+			struct Event
+			{
+				ServerRecorder::EventType type = ServerRecorder::EventType::End;
+				Nz::UInt64 tick = 0;
+				std::size_t peerId = 0;
+
+				// Packet
+				Nz::ByteArray packet;
+
+				// PlayerJoin
+				std::optional<Nz::Uuid> uuid;
+				std::string nickname;
+				PlayerPermissionFlags permissions;
+				Nz::UInt32 protocolVersion = 0;
+			};
+
+		private:
+			struct SaveFile
+			{
+				std::string filename;
+				std::size_t offset;
+				std::size_t size;
+			};
+
+			std::vector<Nz::UInt8> m_content;
+			std::vector<SaveFile> m_saveFiles;
+			std::optional<Nz::ByteStream> m_stream;
+			Nz::UInt32 m_seed;
+			Nz::UInt64 m_lastEventTick;
+	};
+}
+
+#include <ServerLib/ServerRecordingReader.inl>
+
+#endif // TSOM_SERVERLIB_SERVERRECORDINGREADER_HPP
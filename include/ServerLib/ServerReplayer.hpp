@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_SERVERLIB_SERVERREPLAYER_HPP
+#define TSOM_SERVERLIB_SERVERREPLAYER_HPP
+
+#include <ServerLib/Export.hpp>
+#include <CommonLib/NetworkReactor.hpp>
+#include <CommonLib/NetworkSession.hpp>
+#include <ServerLib/ServerRecordingReader.hpp>
+#include <tsl/hopscotch_map.h>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace tsom
+{
+	class ServerInstance;
+
+	// Feeds a ServerRecorder recording back to a server instance, tick by tick and without any connection
+	class TSOM_SERVERLIB_API ServerReplayer
+	{
+		public:
+			ServerReplayer(const std::filesystem::path& filePath);
+			ServerReplayer(const ServerReplayer&) = delete;
+			ServerReplayer(ServerReplayer&&) = delete;
+			~ServerReplayer() = default;
+
+			bool ExtractSnapshot(const std::filesystem::path& directory) const;
+
+			inline Nz::UInt64 GetReplayedTickCount() const;
+			inline Nz::UInt32 GetSeed() const;
+			inline std::size_t GetSessionCount() const;
+
+			bool Tick(ServerInstance& instance);
+
+			ServerReplayer& operator=(const ServerReplayer&) = delete;
+			ServerReplayer& operator=(ServerReplayer&&) = delete;
+
+			static constexpr std::size_t MaxSession = 4095; //< ENet peer limit
+
+		private:
+			void ApplyEvent(ServerInstance& instance);
+
+			tsl::hopscotch_map<std::size_t, std::size_t> m_sessionByPeerId;
+			Nz::UInt64 m_replayedTickCount;
+			ServerRecordingReader m_reader;
+			ServerRecordingReader::Event m_nextEvent;
+			NetworkReactor m_reactor; //< never connected, outgoing packets are serialized and dropped
+			std::vector<std::optional<NetworkSession>> m_sessions; //< destroyed before the reactor they reference
+	};
+}
+
+#include <ServerLib/ServerReplayer.inl>
+
+#endif // TSOM_SERVERLIB_SERVERREPLAYER_HPP
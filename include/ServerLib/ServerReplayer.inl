@@ -0,0 +1,21 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+namespace tsom
+{
+	inline Nz::UInt64 ServerReplayer::GetReplayedTickCount() const
+	{
+		return m_replayedTickCount;
+	}
+
+	inline Nz::UInt32 ServerReplayer::GetSeed() const
+	{
+		return m_reader.GetSeed();
+	}
+
+	inline std::size_t ServerReplayer::GetSessionCount() const
+	{
+		return m_sessionByPeerId.size();
+	}
+}
@@ -19,6 +19,7 @@ namespace Nz
 
 namespace tsom
 {
+	class ChunkBlocks;
 	class ChunkEntities;
 	class ServerPlayer;
 	class Ship;
@@ -61,9 +62,9 @@ namespace tsom
 			std::shared_ptr<Nz::Collider3D> BuildCombinedAreaCollider();
 			void UpdateProxyCollider();
 
-			static Area BuildArea(const Chunk& chunk, std::size_t firstBlockIndex, Nz::Bitset<Nz::UInt64>& remainingBlocks);
+			static Area BuildArea(const ChunkBlocks& blocks, std::size_t firstBlockIndex, Nz::Bitset<Nz::UInt64>& remainingBlocks);
 			static std::shared_ptr<Nz::Collider3D> BuildTriggerCollider(const Chunk& chunk, const AreaList& areaList, const Nz::Vector3f& sizeMargin, std::atomic_bool& isCancelled);
-			static std::shared_ptr<AreaList> GenerateChunkAreas(const Chunk& chunk, std::atomic_bool& isCancelled);
+			static std::shared_ptr<AreaList> GenerateChunkAreas(const ChunkBlocks& blocks, std::atomic_bool& isCancelled);
 
 			struct Area
 			{
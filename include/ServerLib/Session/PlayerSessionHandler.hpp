@@ -20,6 +20,7 @@ namespace tsom
 			PlayerSessionHandler(NetworkSession* session, ServerPlayer* player);
 			~PlayerSessionHandler();
 
+			void HandlePacket(Nz::ByteArray&& byteArray) override;
 			void HandlePacket(Packets::ExitShipControl&& exitShipControl);
 			void HandlePacket(Packets::Interact&& interact);
 			void HandlePacket(Packets::MineBlock&& mineBlock);
@@ -34,6 +35,7 @@ namespace tsom
 		private:
 			bool CheckCanMineBlock(const Chunk* chunk, const Nz::Vector3ui& blockIndices) const;
 			bool CheckCanPlaceBlock(ServerEnvironment* environment, const Chunk* chunk, const Nz::Vector3ui& blockIndices) const;
+			void SendReport(std::string_view report);
 
 			ServerPlayer* m_player;
 	};
@@ -56,7 +56,7 @@ namespace tsom
 			inline void TriggerEntityRpc(entt::handle entity, Nz::UInt32 rpcIndex);
 
 			inline void UpdateControlledEntity(entt::handle entity, CharacterController* controller);
-			inline void UpdateEntityProperty(entt::handle entity, Nz::UInt32 propertyIndex);
+			inline void UpdateEntityProperties(entt::handle entity, const Nz::Bitset<Nz::UInt64>& propertyMask);
 			void UpdateEntityEnvironment(ServerEnvironment& newEnvironment, entt::handle oldEntity, entt::handle newEntity);
 			inline void UpdateLastInputIndex(InputIndex inputIndex);
 			inline void UpdateRootEnvironment(ServerEnvironment& environment);
@@ -71,7 +71,6 @@ namespace tsom
 				Nz::Quaternionf initialRotation;
 				Nz::Vector3f initialPosition;
 				std::optional<Packets::Helper::PlayerControlledData> playerControlledData;
-				std::vector<EntityProperty> entityProperties;
 				bool isMoving;
 			};
 
@@ -142,7 +141,7 @@ namespace tsom
 
 			tsl::hopscotch_map<entt::handle, EntityId, HandlerHasher> m_entityIndices;
 			tsl::hopscotch_map<entt::handle, CreateEntityData, HandlerHasher> m_createdEntities;
-			tsl::hopscotch_map<entt::handle, Nz::UInt32, HandlerHasher> m_propertyUpdatedEntities;
+			tsl::hopscotch_map<entt::handle, Nz::Bitset<Nz::UInt64>, HandlerHasher> m_propertyUpdatedEntities;
 			tsl::hopscotch_map<entt::handle, std::vector<Nz::UInt32>, HandlerHasher> m_triggeredEntitiesRpc;
 			tsl::hopscotch_map<entt::handle, ChunkNetworkMap, HandlerHasher> m_chunkNetworkMaps;
 			tsl::hopscotch_map<const ServerEnvironment*, EnvironmentId> m_environmentIndices;
@@ -170,6 +169,7 @@ namespace tsom
 			CharacterController* m_controlledCharacter;
 			NetworkSession* m_networkSession;
 			ServerEnvironment* m_nextRootEnvironment;
+			bool m_hasUnacknowledgedInput;
 	};
 }
 
@@ -10,7 +10,8 @@ namespace tsom
 	m_currentEnvironmentId(Nz::MaxValue()),
 	m_lastInputIndex(0),
 	m_controlledCharacter(nullptr),
-	m_networkSession(networkSession)
+	m_networkSession(networkSession),
+	m_hasUnacknowledgedInput(false)
 	{
 		m_activeChunkUpdates = std::make_shared<std::size_t>(0);
 	}
@@ -83,14 +84,15 @@ namespace tsom
 		m_movingEntities.erase(m_controlledEntity);
 	}
 
-	inline void SessionVisibilityHandler::UpdateEntityProperty(entt::handle entity, Nz::UInt32 propertyIndex)
+	inline void SessionVisibilityHandler::UpdateEntityProperties(entt::handle entity, const Nz::Bitset<Nz::UInt64>& propertyMask)
 	{
-		m_propertyUpdatedEntities[entity] |= 1u << propertyIndex;
+		m_propertyUpdatedEntities[entity] |= propertyMask;
 	}
 
 	inline void SessionVisibilityHandler::UpdateLastInputIndex(InputIndex inputIndex)
 	{
 		m_lastInputIndex = inputIndex;
+		m_hasUnacknowledgedInput = true;
 	}
 
 	inline void SessionVisibilityHandler::UpdateRootEnvironment(ServerEnvironment& environment)
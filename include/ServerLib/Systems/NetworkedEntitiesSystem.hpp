@@ -11,11 +11,13 @@
 #include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <ServerLib/SessionVisibilityHandler.hpp>
 #include <Nazara/Core/Time.hpp>
+#include <NazaraUtils/Bitset.hpp>
 #include <NazaraUtils/FunctionRef.hpp>
 #include <NazaraUtils/TypeList.hpp>
 #include <entt/entt.hpp>
 #include <tsl/hopscotch_map.h>
 #include <tsl/hopscotch_set.h>
+#include <vector>
 
 namespace tsom
 {
@@ -46,14 +48,19 @@ namespace tsom
 		private:
 			SessionVisibilityHandler::CreateEntityData BuildCreateEntityData(entt::entity entity) const;
 			void CreateEntity(SessionVisibilityHandler& visibility, entt::handle entity, const SessionVisibilityHandler::CreateEntityData& createData) const;
+			void FlushPropertyUpdates();
+			void HandleNewEntities();
 			void OnNetworkedDestroy(entt::registry& registry, entt::entity entity);
 
 			struct EntityData
 			{
 				NazaraSlot(ClassInstanceComponent, OnClientRpc, onClientRpc);
 				NazaraSlot(ClassInstanceComponent, OnPropertyUpdate, onPropertyUpdate);
+
+				Nz::Bitset<Nz::UInt64> dirtyProperties;
 			};
 
+			std::vector<entt::entity> m_propertyUpdatedEntities;
 			tsl::hopscotch_map<entt::entity, EntityData> m_networkedEntities;
 			entt::observer m_networkedConstructObserver;
 			entt::scoped_connection m_disabledConstructConnection;
@@ -0,0 +1,35 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_BOT_BOTBEHAVIOR_HPP
+#define TSOM_BOT_BOTBEHAVIOR_HPP
+
+#include <NazaraUtils/Algorithm.hpp>
+#include <optional>
+#include <string_view>
+
+namespace tsom
+{
+	enum class BotBehavior
+	{
+		Builder, //< walks and places blocks
+		Flyer,   //< enables /fly and moves in every direction
+		Idle,    //< only sends empty inputs
+		Miner,   //< walks and mines blocks
+		Mixed,   //< walks, mines and places blocks
+		Walker,  //< walks and jumps around
+
+		Max = Walker
+	};
+
+	constexpr std::optional<BotBehavior> BotBehaviorFromString(std::string_view behaviorStr);
+
+	constexpr std::string_view ToString(BotBehavior behavior);
+}
+
+#include <Bot/BotBehavior.inl>
+
+#endif // TSOM_BOT_BOTBEHAVIOR_HPP
@@ -0,0 +1,33 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+namespace tsom
+{
+	constexpr std::optional<BotBehavior> BotBehaviorFromString(std::string_view behaviorStr)
+	{
+		for (std::size_t i = 0; i <= Nz::UnderlyingCast(BotBehavior::Max); ++i)
+		{
+			BotBehavior behavior = static_cast<BotBehavior>(i);
+			if (behaviorStr == ToString(behavior))
+				return behavior;
+		}
+
+		return {};
+	}
+
+	constexpr std::string_view ToString(BotBehavior behavior)
+	{
+		switch (behavior)
+		{
+			case BotBehavior::Builder: return "builder";
+			case BotBehavior::Flyer:   return "flyer";
+			case BotBehavior::Idle:    return "idle";
+			case BotBehavior::Miner:   return "miner";
+			case BotBehavior::Mixed:   return "mixed";
+			case BotBehavior::Walker:  return "walker";
+		}
+
+		NAZARA_UNREACHABLE();
+	}
+}
@@ -0,0 +1,345 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <Bot/BotSessionHandler.hpp>
+#include <Bot/BotStatistics.hpp>
+#include <CommonLib/NetworkSession.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace tsom
+{
+	constexpr SessionHandler::SendAttributeTable s_packetAttributes = SessionHandler::BuildAttributeTable({
+		{ PacketIndex<Packets::AuthRequest>,        { .channel = 0, .flags = Nz::ENetPacketFlag::Reliable } },
+		{ PacketIndex<Packets::MineBlock>,          { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
+		{ PacketIndex<Packets::PlaceBlock>,         { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
+		{ PacketIndex<Packets::SendChatMessage>,    { .channel = 0, .flags = Nz::ENetPacketFlag::Reliable } },
+		{ PacketIndex<Packets::UpdatePlayerInputs>, { .channel = 1, .flags = Nz::ENetPacketFlag_Unreliable } }
+	});
+
+	BotSessionHandler::BotSessionHandler(NetworkSession* session, BotBehavior behavior, BotStatistics& statistics, Nz::UInt32 seed) :
+	SessionHandler(session),
+	m_randomGenerator(seed),
+	m_behavior(behavior),
+	m_statistics(statistics),
+	m_placedBlock(EmptyBlockIndex),
+	m_lastAckedInputIndex(0),
+	m_nextInputIndex(1),
+	m_turnSpeed(Nz::DegreeAnglef::Zero()),
+	m_remainingTurnTicks(0),
+	m_tickCounter(0),
+	m_hasReceivedStateUpdate(false),
+	m_isAuthenticated(false)
+	{
+		SetupHandlerTable(this);
+		SetupAttributeTable(s_packetAttributes);
+
+		m_inputSendTimes.fill(Nz::Time::Zero());
+	}
+
+	void BotSessionHandler::HandlePacket(Packets::AuthResponse&& authResponse)
+	{
+		if (!authResponse.authResult.IsOk())
+		{
+			fmt::print(fg(fmt::color::red), "bot authentication failed: {}\n", ToString(authResponse.authResult.GetError()));
+			m_statistics.IncrementAuthFailureCount();
+			GetSession()->Disconnect();
+			return;
+		}
+
+		m_isAuthenticated = true;
+
+		if (m_behavior == BotBehavior::Flyer)
+		{
+			Packets::SendChatMessage chatMessage;
+			chatMessage.message = "/fly";
+
+			GetSession()->SendPacket(chatMessage);
+		}
+	}
+
+	void BotSessionHandler::HandlePacket(Packets::ChunkCreate&& chunkCreate)
+	{
+		ChunkData& chunkData = m_chunks[chunkCreate.chunkId];
+		chunkData.creationTime = Nz::GetElapsedNanoseconds();
+		chunkData.sizeX = chunkCreate.chunkSizeX;
+		chunkData.sizeY = chunkCreate.chunkSizeY;
+		chunkData.sizeZ = chunkCreate.chunkSizeZ;
+	}
+
+	void BotSessionHandler::HandlePacket(Packets::ChunkDestroy&& chunkDestroy)
+	{
+		auto it = m_chunks.find(chunkDestroy.chunkId);
+		if (it == m_chunks.end())
+			return;
+
+		if (it->second.isReady)
+		{
+			auto readyIt = std::find(m_readyChunks.begin(), m_readyChunks.end(), chunkDestroy.chunkId);
+			assert(readyIt != m_readyChunks.end());
+
+			std::swap(*readyIt, m_readyChunks.back());
+			m_readyChunks.pop_back();
+		}
+
+		m_chunks.erase(it);
+	}
+
+	void BotSessionHandler::HandlePacket(Packets::ChunkReset&& chunkReset)
+	{
+		auto it = m_chunks.find(chunkReset.chunkId);
+		if (it == m_chunks.end())
+		{
+			fmt::print(fg(fmt::color::red), "ChunkReset handler: unknown chunk {}\n", chunkReset.chunkId);
+			return;
+		}
+
+		ChunkData& chunkData = it.value();
+		if (chunkReset.content.size() != chunkData.sizeX * chunkData.sizeY * chunkData.sizeZ)
+		{
+			fmt::print(fg(fmt::color::red), "ChunkReset handler: chunk {} content size mismatch\n", chunkReset.chunkId);
+			return;
+		}
+
+		if (!chunkData.isReady)
+		{
+			m_statistics.RecordChunkDownload(Nz::GetElapsedNanoseconds() - chunkData.creationTime);
+			m_readyChunks.push_back(chunkReset.chunkId);
+			chunkData.isReady = true;
+		}
+
+		// Only keep a few random blocks of each kind, which is enough to pick targets without storing the whole chunk
+		chunkData.emptyBlocks.clear();
+		chunkData.filledBlocks.clear();
+
+		std::uniform_int_distribution<std::size_t> blockDis(0, chunkReset.content.size() - 1);
+		for (std::size_t i = 0; i < MaxSampledBlocks * 4; ++i)
+		{
+			std::size_t blockIndex = blockDis(m_randomGenerator);
+			BlockIndex blockContent = chunkReset.content[blockIndex];
+
+			auto& sampledBlocks = (blockContent == EmptyBlockIndex) ? chunkData.emptyBlocks : chunkData.filledBlocks;
+			if (sampledBlocks.size() >= MaxSampledBlocks)
+				continue;
+
+			// Voxel index is sizeX * (sizeY * z + y) + x
+			Packets::Helper::VoxelLocation& voxelLoc = sampledBlocks.emplace_back();
+			voxelLoc.x = Nz::SafeCast<Nz::UInt8>(blockIndex % chunkData.sizeX);
+			voxelLoc.y = Nz::SafeCast<Nz::UInt8>((blockIndex / chunkData.sizeX) % chunkData.sizeY);
+			voxelLoc.z = Nz::SafeCast<Nz::UInt8>(blockIndex / (chunkData.sizeX * chunkData.sizeY));
+
+			// PlaceBlock only carries 8 bits of block index
+			if (m_placedBlock == EmptyBlockIndex && blockContent != EmptyBlockIndex && blockContent <= std::numeric_limits<Nz::UInt8>::max())
+				m_placedBlock = blockContent;
+		}
+	}
+
+	void BotSessionHandler::HandlePacket(Packets::ChunkUpdate&& chunkUpdate)
+	{
+		auto it = m_chunks.find(chunkUpdate.chunkId);
+		if (it == m_chunks.end())
+			return;
+
+		// Keep samples in sync with blocks changed by other players (and with our own requests the server rejected)
+		ChunkData& chunkData = it.value();
+		for (const auto& blockUpdate : chunkUpdate.updates)
+		{
+			auto SameVoxel = [&](const Packets::Helper::VoxelLocation& voxelLoc)
+			{
+				return voxelLoc.x == blockUpdate.voxelLoc.x && voxelLoc.y == blockUpdate.voxelLoc.y && voxelLoc.z == blockUpdate.voxelLoc.z;
+			};
+
+			std::erase_if(chunkData.emptyBlocks, SameVoxel);
+			std::erase_if(chunkData.filledBlocks, SameVoxel);
+
+			auto& sampledBlocks = (blockUpdate.newContent == EmptyBlockIndex) ? chunkData.emptyBlocks : chunkData.filledBlocks;
+			if (sampledBlocks.size() < MaxSampledBlocks)
+				sampledBlocks.push_back(blockUpdate.voxelLoc);
+		}
+	}
+
+	void BotSessionHandler::HandlePacket(Packets::EntitiesStateUpdate&& stateUpdate)
+	{
+		Nz::Time now = Nz::GetElapsedNanoseconds();
+		if (m_hasReceivedStateUpdate)
+		{
+			Nz::UInt16 tickCount = static_cast<Nz::UInt16>(stateUpdate.tickIndex - m_lastTickIndex);
+			m_statistics.RecordStateUpdate(tickCount, now - m_lastStateUpdateTime);
+		}
+
+		m_hasReceivedStateUpdate = true;
+		m_lastStateUpdateTime = now;
+		m_lastTickIndex = stateUpdate.tickIndex;
+
+		AcknowledgeInput(stateUpdate.lastInputIndex);
+	}
+
+	void BotSessionHandler::HandlePacket(Packets::InputAck&& inputAck)
+	{
+		AcknowledgeInput(inputAck.lastInputIndex);
+	}
+
+	void BotSessionHandler::HandlePacket(Packets::NetworkStrings&& networkStrings)
+	{
+		GetSession()->GetStringStore().FillStore(networkStrings.startId, std::move(networkStrings.strings));
+	}
+
+	void BotSessionHandler::OnUnexpectedPacket(std::size_t /*packetIndex*/)
+	{
+		// Bots don't replicate entities, environments or players, these packets are only counted by the network statistics
+	}
+
+	void BotSessionHandler::Tick()
+	{
+		if (!m_isAuthenticated)
+			return;
+
+		m_tickCounter++;
+
+		UpdateMovement();
+		SendInputs();
+
+		if (m_tickCounter % ActionInterval != 0)
+			return;
+
+		switch (m_behavior)
+		{
+			case BotBehavior::Builder:
+				PlaceBlock();
+				break;
+
+			case BotBehavior::Miner:
+				MineBlock();
+				break;
+
+			case BotBehavior::Mixed:
+			{
+				// Fallback to the other action if no target is available
+				if (std::bernoulli_distribution(0.5)(m_randomGenerator))
+				{
+					if (!MineBlock())
+						PlaceBlock();
+				}
+				else if (!PlaceBlock())
+					MineBlock();
+
+				break;
+			}
+
+			case BotBehavior::Flyer:
+			case BotBehavior::Idle:
+			case BotBehavior::Walker:
+				break;
+		}
+	}
+
+	void BotSessionHandler::AcknowledgeInput(InputIndex lastInputIndex)
+	{
+		if (!IsInputMoreRecent(lastInputIndex, m_lastAckedInputIndex))
+			return;
+
+		// Only the most recent acknowledged input is measured, inputs acknowledged in the same batch would skew the distribution
+		Nz::Time sendTime = m_inputSendTimes[lastInputIndex];
+		if (sendTime != Nz::Time::Zero())
+			m_statistics.RecordInputAck(Nz::GetElapsedNanoseconds() - sendTime);
+
+		m_lastAckedInputIndex = lastInputIndex;
+	}
+
+	bool BotSessionHandler::MineBlock()
+	{
+		if (m_readyChunks.empty())
+			return false;
+
+		Packets::Helper::ChunkId chunkId = m_readyChunks[std::uniform_int_distribution<std::size_t>(0, m_readyChunks.size() - 1)(m_randomGenerator)];
+		ChunkData& chunkData = m_chunks[chunkId];
+		if (chunkData.filledBlocks.empty())
+			return false;
+
+		// Samples may be outdated because of other players, the server will ignore invalid requests
+		Packets::MineBlock mineBlock;
+		mineBlock.chunkId = chunkId;
+		mineBlock.voxelLoc = chunkData.filledBlocks.back();
+
+		chunkData.filledBlocks.pop_back();
+		chunkData.emptyBlocks.push_back(mineBlock.voxelLoc);
+
+		GetSession()->SendPacket(mineBlock);
+		m_statistics.IncrementBlockMinedCount();
+
+		return true;
+	}
+
+	bool BotSessionHandler::PlaceBlock()
+	{
+		if (m_readyChunks.empty() || m_placedBlock == EmptyBlockIndex)
+			return false;
+
+		Packets::Helper::ChunkId chunkId = m_readyChunks[std::uniform_int_distribution<std::size_t>(0, m_readyChunks.size() - 1)(m_randomGenerator)];
+		ChunkData& chunkData = m_chunks[chunkId];
+		if (chunkData.emptyBlocks.empty())
+			return false;
+
+		Packets::PlaceBlock placeBlock;
+		placeBlock.chunkId = chunkId;
+		placeBlock.voxelLoc = chunkData.emptyBlocks.back();
+		placeBlock.newContent = Nz::SafeCast<Nz::UInt8>(m_placedBlock);
+
+		chunkData.emptyBlocks.pop_back();
+		chunkData.filledBlocks.push_back(placeBlock.voxelLoc);
+
+		GetSession()->SendPacket(placeBlock);
+		m_statistics.IncrementBlockPlacedCount();
+
+		return true;
+	}
+
+	void BotSessionHandler::SendInputs()
+	{
+		Packets::UpdatePlayerInputs inputPacket;
+		inputPacket.inputs.index = m_nextInputIndex++;
+		inputPacket.inputs.data = m_characterInputs;
+
+		m_inputSendTimes[inputPacket.inputs.index] = Nz::GetElapsedNanoseconds();
+
+		GetSession()->SendPacket(inputPacket);
+	}
+
+	void BotSessionHandler::UpdateMovement()
+	{
+		if (m_behavior == BotBehavior::Idle)
+			return;
+
+		// Pitch and yaw are rotation deltas, turn for a few ticks then keep going straight
+		if (m_remainingTurnTicks > 0)
+			m_remainingTurnTicks--;
+		else if (std::bernoulli_distribution(0.02)(m_randomGenerator))
+		{
+			m_remainingTurnTicks = std::uniform_int_distribution<Nz::UInt32>(10, 60)(m_randomGenerator);
+			m_turnSpeed = Nz::DegreeAnglef(std::uniform_real_distribution<float>(-3.f, 3.f)(m_randomGenerator));
+		}
+
+		m_characterInputs.moveForward = true;
+		m_characterInputs.yaw = (m_remainingTurnTicks > 0) ? m_turnSpeed : Nz::DegreeAnglef::Zero();
+
+		if (m_behavior == BotBehavior::Flyer)
+		{
+			// Climb and dive in turns, pitch is relative to the flying direction
+			bool climbing = (m_tickCounter / 300) % 2 == 0;
+			m_characterInputs.jump = climbing;
+			m_characterInputs.crouch = !climbing;
+			m_characterInputs.pitch = (m_remainingTurnTicks > 0) ? m_turnSpeed * 0.5f : Nz::DegreeAnglef::Zero();
+		}
+		else
+		{
+			m_characterInputs.jump = std::bernoulli_distribution(0.01)(m_randomGenerator);
+			m_characterInputs.sprint = (m_tickCounter / 600) % 2 == 1;
+		}
+	}
+}
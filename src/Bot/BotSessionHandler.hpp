@@ -0,0 +1,95 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_BOT_BOTSESSIONHANDLER_HPP
+#define TSOM_BOT_BOTSESSIONHANDLER_HPP
+
+#include <Bot/BotBehavior.hpp>
+#include <CommonLib/BlockIndex.hpp>
+#include <CommonLib/PlayerInputs.hpp>
+#include <CommonLib/SessionHandler.hpp>
+#include <CommonLib/Protocol/Packets.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <tsl/hopscotch_map.h>
+#include <array>
+#include <random>
+#include <vector>
+
+namespace tsom
+{
+	class BotStatistics;
+
+	// Plays a character without rendering nor simulating the world, only a few voxels of each chunk are kept to pick mining/building targets
+	class BotSessionHandler : public SessionHandler
+	{
+		public:
+			BotSessionHandler(NetworkSession* session, BotBehavior behavior, BotStatistics& statistics, Nz::UInt32 seed);
+			BotSessionHandler(const BotSessionHandler&) = delete;
+			BotSessionHandler(BotSessionHandler&&) = delete;
+			~BotSessionHandler() = default;
+
+			void HandlePacket(Packets::AuthResponse&& authResponse);
+			void HandlePacket(Packets::ChunkCreate&& chunkCreate);
+			void HandlePacket(Packets::ChunkDestroy&& chunkDestroy);
+			void HandlePacket(Packets::ChunkReset&& chunkReset);
+			void HandlePacket(Packets::ChunkUpdate&& chunkUpdate);
+			void HandlePacket(Packets::EntitiesStateUpdate&& stateUpdate);
+			void HandlePacket(Packets::InputAck&& inputAck);
+			void HandlePacket(Packets::NetworkStrings&& networkStrings);
+
+			inline bool IsAuthenticated() const;
+
+			void OnUnexpectedPacket(std::size_t packetIndex) override;
+
+			void Tick();
+
+			BotSessionHandler& operator=(const BotSessionHandler&) = delete;
+			BotSessionHandler& operator=(BotSessionHandler&&) = delete;
+
+			static constexpr std::size_t ActionInterval = 30; //< ticks between two mine/place actions
+			static constexpr std::size_t MaxSampledBlocks = 32;
+
+		private:
+			void AcknowledgeInput(InputIndex lastInputIndex);
+			bool MineBlock();
+			bool PlaceBlock();
+			void SendInputs();
+			void UpdateMovement();
+
+			struct ChunkData
+			{
+				std::vector<Packets::Helper::VoxelLocation> emptyBlocks;
+				std::vector<Packets::Helper::VoxelLocation> filledBlocks;
+				Nz::Time creationTime;
+				Nz::UInt32 sizeX;
+				Nz::UInt32 sizeY;
+				Nz::UInt32 sizeZ;
+				bool isReady = false;
+			};
+
+			std::array<Nz::Time, 256> m_inputSendTimes;
+			std::minstd_rand m_randomGenerator;
+			std::vector<Packets::Helper::ChunkId> m_readyChunks;
+			tsl::hopscotch_map<Packets::Helper::ChunkId, ChunkData> m_chunks;
+			BotBehavior m_behavior;
+			BotStatistics& m_statistics;
+			BlockIndex m_placedBlock;
+			InputIndex m_lastAckedInputIndex;
+			InputIndex m_nextInputIndex;
+			Nz::DegreeAnglef m_turnSpeed;
+			Nz::Time m_lastStateUpdateTime;
+			Nz::UInt16 m_lastTickIndex;
+			Nz::UInt32 m_remainingTurnTicks;
+			Nz::UInt64 m_tickCounter;
+			PlayerInputs::Character m_characterInputs;
+			bool m_hasReceivedStateUpdate;
+			bool m_isAuthenticated;
+	};
+}
+
+#include <Bot/BotSessionHandler.inl>
+
+#endif // TSOM_BOT_BOTSESSIONHANDLER_HPP
@@ -0,0 +1,83 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <Bot/BotStatistics.hpp>
+#include <CommonLib/InternalConstants.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <string_view>
+
+namespace tsom
+{
+	namespace
+	{
+		std::string FormatDuration(Nz::Time time)
+		{
+			Nz::Int64 microseconds = time.AsMicroseconds();
+			if (microseconds >= 1000)
+				return fmt::format("{:.2f}ms", microseconds / 1000.0);
+			else
+				return fmt::format("{}us", microseconds);
+		}
+
+		std::string FormatSamples(std::string_view name, std::vector<Nz::Time> samples)
+		{
+			if (samples.empty())
+				return fmt::format("- {}: no sample\n", name);
+
+			std::sort(samples.begin(), samples.end());
+
+			// Nearest-rank percentile
+			auto Percentile = [&](std::size_t percent)
+			{
+				std::size_t rank = (samples.size() * percent + 99) / 100;
+				return samples[std::max<std::size_t>(rank, 1) - 1];
+			};
+
+			return fmt::format("- {}: {} samples, p50 {}, p99 {}, max {}\n", name, samples.size(), FormatDuration(Percentile(50)), FormatDuration(Percentile(99)), FormatDuration(samples.back()));
+		}
+	}
+
+	std::string BotStatistics::BuildReport() const
+	{
+		std::string report;
+		report += FormatSamples("rtt", m_pings);
+		report += FormatSamples("input ack", m_inputAckTimes);
+		report += FormatSamples("chunk download", m_chunkDownloadTimes);
+		report += FormatSamples("state update gap", m_stateUpdateGaps);
+
+		// Tick indices are sent by the server, comparing them to our own clock tells us if the server keeps up
+		if (m_observedTickTime > Nz::Time::Zero())
+		{
+			double tickRate = m_observedTickCount / m_observedTickTime.AsSeconds<double>();
+			double expectedTickRate = 1.0 / Constants::TickDuration.AsSeconds<double>();
+			report += fmt::format("- server tick rate: {:.1f}/s ({:.1f}% of {:.0f}/s)\n", tickRate, tickRate * 100.0 / expectedTickRate, expectedTickRate);
+		}
+
+		report += fmt::format("- blocks: {} mined, {} placed\n", m_blockMinedCount, m_blockPlacedCount);
+		if (m_authFailureCount > 0 || m_disconnectionCount > 0)
+			report += fmt::format("- failures: {} authentication, {} disconnection\n", m_authFailureCount, m_disconnectionCount);
+
+		return report;
+	}
+
+	void BotStatistics::Merge(const BotStatistics& statistics)
+	{
+		m_chunkDownloadTimes.insert(m_chunkDownloadTimes.end(), statistics.m_chunkDownloadTimes.begin(), statistics.m_chunkDownloadTimes.end());
+		m_inputAckTimes.insert(m_inputAckTimes.end(), statistics.m_inputAckTimes.begin(), statistics.m_inputAckTimes.end());
+		m_pings.insert(m_pings.end(), statistics.m_pings.begin(), statistics.m_pings.end());
+		m_stateUpdateGaps.insert(m_stateUpdateGaps.end(), statistics.m_stateUpdateGaps.begin(), statistics.m_stateUpdateGaps.end());
+		m_observedTickTime += statistics.m_observedTickTime;
+		m_authFailureCount += statistics.m_authFailureCount;
+		m_blockMinedCount += statistics.m_blockMinedCount;
+		m_blockPlacedCount += statistics.m_blockPlacedCount;
+		m_disconnectionCount += statistics.m_disconnectionCount;
+		m_observedTickCount += statistics.m_observedTickCount;
+	}
+
+	void BotStatistics::Reset()
+	{
+		*this = BotStatistics{};
+	}
+}
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_BOT_BOTSTATISTICS_HPP
+#define TSOM_BOT_BOTSTATISTICS_HPP
+
+#include <Nazara/Core/Time.hpp>
+#include <NazaraUtils/Prerequisites.hpp>
+#include <string>
+#include <vector>
+
+namespace tsom
+{
+	// Latency samples and counters gathered by all bots, only accessed from the main thread
+	class BotStatistics
+	{
+		public:
+			BotStatistics() = default;
+			BotStatistics(const BotStatistics&) = default;
+			BotStatistics(BotStatistics&&) = default;
+			~BotStatistics() = default;
+
+			std::string BuildReport() const;
+
+			inline void IncrementAuthFailureCount();
+			inline void IncrementBlockMinedCount();
+			inline void IncrementBlockPlacedCount();
+			inline void IncrementDisconnectionCount();
+
+			void Merge(const BotStatistics& statistics);
+
+			inline void RecordChunkDownload(Nz::Time downloadTime);
+			inline void RecordInputAck(Nz::Time ackTime);
+			inline void RecordPing(Nz::Time ping);
+			inline void RecordStateUpdate(Nz::UInt16 tickCount, Nz::Time elapsedTime);
+
+			void Reset();
+
+			BotStatistics& operator=(const BotStatistics&) = default;
+			BotStatistics& operator=(BotStatistics&&) = default;
+
+		private:
+			std::vector<Nz::Time> m_chunkDownloadTimes;
+			std::vector<Nz::Time> m_inputAckTimes;
+			std::vector<Nz::Time> m_pings;
+			std::vector<Nz::Time> m_stateUpdateGaps;
+			Nz::Time m_observedTickTime = Nz::Time::Zero();
+			Nz::UInt64 m_authFailureCount = 0;
+			Nz::UInt64 m_blockMinedCount = 0;
+			Nz::UInt64 m_blockPlacedCount = 0;
+			Nz::UInt64 m_disconnectionCount = 0;
+			Nz::UInt64 m_observedTickCount = 0;
+	};
+}
+
+#include <Bot/BotStatistics.inl>
+
+#endif // TSOM_BOT_BOTSTATISTICS_HPP
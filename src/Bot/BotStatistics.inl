@@ -0,0 +1,48 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+namespace tsom
+{
+	inline void BotStatistics::IncrementAuthFailureCount()
+	{
+		m_authFailureCount++;
+	}
+
+	inline void BotStatistics::IncrementBlockMinedCount()
+	{
+		m_blockMinedCount++;
+	}
+
+	inline void BotStatistics::IncrementBlockPlacedCount()
+	{
+		m_blockPlacedCount++;
+	}
+
+	inline void BotStatistics::IncrementDisconnectionCount()
+	{
+		m_disconnectionCount++;
+	}
+
+	inline void BotStatistics::RecordChunkDownload(Nz::Time downloadTime)
+	{
+		m_chunkDownloadTimes.push_back(downloadTime);
+	}
+
+	inline void BotStatistics::RecordInputAck(Nz::Time ackTime)
+	{
+		m_inputAckTimes.push_back(ackTime);
+	}
+
+	inline void BotStatistics::RecordPing(Nz::Time ping)
+	{
+		m_pings.push_back(ping);
+	}
+
+	inline void BotStatistics::RecordStateUpdate(Nz::UInt16 tickCount, Nz::Time elapsedTime)
+	{
+		m_observedTickCount += tickCount;
+		m_observedTickTime += elapsedTime;
+		m_stateUpdateGaps.push_back(elapsedTime);
+	}
+}
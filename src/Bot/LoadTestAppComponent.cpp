@@ -0,0 +1,241 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <Bot/LoadTestAppComponent.hpp>
+#include <Bot/BotSessionHandler.hpp>
+#include <CommonLib/InternalConstants.hpp>
+#include <CommonLib/NetworkSessionManager.hpp>
+#include <CommonLib/Version.hpp>
+#include <Nazara/Core/ApplicationBase.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#include <thread>
+
+namespace tsom
+{
+	LoadTestAppComponent::LoadTestAppComponent(Nz::ApplicationBase& app, Config config) :
+	ApplicationComponent(app),
+	m_nextBotIndex(0),
+	m_config(std::move(config)),
+	m_elapsedTime(Nz::Time::Zero()),
+	m_nextConnectionTime(Nz::Time::Zero()),
+	m_nextPingTime(Nz::Time::Second()),
+	m_nextReportTime(m_config.reportInterval),
+	m_tickAccumulator(Nz::Time::Zero()),
+	m_isFinished(false)
+	{
+		m_bots.reserve(m_config.botCount);
+		for (std::size_t i = 0; i < m_config.botCount; ++i)
+			m_bots.push_back(std::make_unique<Bot>());
+
+		// Each reactor runs its own thread, shard bots between them like the server does with its sessions
+		std::size_t reactorCount = (m_config.botCount + MaxBotPerReactor - 1) / MaxBotPerReactor;
+		for (std::size_t i = 0; i < reactorCount; ++i)
+			m_reactors.push_back(std::make_unique<NetworkReactor>(i * MaxBotPerReactor, m_config.serverAddress.GetProtocol(), 0, MaxBotPerReactor));
+
+		fmt::print("starting {} {} bots against {} ({} network reactors)\n", m_config.botCount, ToString(m_config.behavior), m_config.serverAddress.ToString(), reactorCount);
+	}
+
+	LoadTestAppComponent::~LoadTestAppComponent()
+	{
+		if (!m_isFinished)
+			PrintReport(true);
+
+		for (auto& botPtr : m_bots)
+		{
+			if (botPtr->session)
+				botPtr->session->Disconnect();
+		}
+	}
+
+	void LoadTestAppComponent::Update(Nz::Time elapsedTime)
+	{
+		if (m_isFinished)
+			return;
+
+		m_elapsedTime += elapsedTime;
+
+		// Stagger connections to avoid measuring the connection burst instead of the steady state
+		while (m_nextBotIndex < m_bots.size() && m_elapsedTime >= m_nextConnectionTime)
+		{
+			ConnectBot(m_nextBotIndex++, m_config.serverAddress);
+			m_nextConnectionTime += m_config.connectionInterval;
+		}
+
+		auto ConnectionHandler = [&]([[maybe_unused]] bool outgoingConnection, std::size_t peerIndex, [[maybe_unused]] const Nz::IpAddress& remoteAddress, [[maybe_unused]] Nz::UInt32 data)
+		{
+			auto it = m_botByPeerId.find(peerIndex);
+			if (it == m_botByPeerId.end())
+				return;
+
+			Packets::AuthRequest::AnonymousPlayerData anonymousPlayer;
+			anonymousPlayer.nickname = fmt::format("bot{}", it->second);
+
+			Packets::AuthRequest request;
+			request.gameVersion = GameVersion;
+			request.token = std::move(anonymousPlayer);
+
+			m_bots[it->second]->session->SendPacket(request);
+		};
+
+		auto DisconnectionHandler = [&](std::size_t peerIndex, [[maybe_unused]] Nz::UInt32 data, bool timeout)
+		{
+			auto it = m_botByPeerId.find(peerIndex);
+			if (it == m_botByPeerId.end())
+				return;
+
+			// Servers running multiple network reactors redirect peers to the least loaded one
+			if (std::optional<Nz::UInt16> redirectPortOffset = NetworkSessionManager::ExtractRedirectPortOffset(data); redirectPortOffset && !timeout)
+			{
+				Nz::IpAddress redirectAddress = m_config.serverAddress;
+				redirectAddress.SetPort(Nz::SafeCast<Nz::UInt16>(m_config.serverAddress.GetPort() + *redirectPortOffset));
+
+				m_redirectedBots.emplace_back(it->second, redirectAddress);
+			}
+			else
+			{
+				fmt::print(fg(fmt::color::red), "bot #{} {}\n", it->second, (timeout) ? "timed out" : "was disconnected");
+				m_statistics.IncrementDisconnectionCount();
+			}
+
+			Bot& bot = *m_bots[it->second];
+			bot.sessionHandler = nullptr;
+			bot.session.reset();
+
+			m_botByPeerId.erase(it);
+		};
+
+		auto PacketHandler = [&](std::size_t peerIndex, Nz::ByteArray&& packet)
+		{
+			auto it = m_botByPeerId.find(peerIndex);
+			if NAZARA_UNLIKELY(it == m_botByPeerId.end())
+				return;
+
+			m_bots[it->second]->session->HandlePacket(std::move(packet));
+		};
+
+		for (auto& reactorPtr : m_reactors)
+			reactorPtr->Poll(ConnectionHandler, DisconnectionHandler, PacketHandler);
+
+		for (auto&& [botIndex, redirectAddress] : m_redirectedBots)
+			ConnectBot(botIndex, redirectAddress);
+
+		m_redirectedBots.clear();
+
+		// Bots send their inputs at the server tick rate, as the game does
+		m_tickAccumulator += elapsedTime;
+		while (m_tickAccumulator >= Constants::TickDuration)
+		{
+			for (auto& botPtr : m_bots)
+			{
+				if (botPtr->sessionHandler)
+					botPtr->sessionHandler->Tick();
+			}
+
+			m_tickAccumulator -= Constants::TickDuration;
+		}
+
+		if (m_elapsedTime >= m_nextPingTime)
+		{
+			QueryPings();
+			m_nextPingTime += Nz::Time::Second();
+		}
+
+		if (m_config.duration > Nz::Time::Zero() && m_elapsedTime >= m_config.duration)
+		{
+			PrintReport(true);
+			m_isFinished = true;
+
+			GetApp().Quit();
+			return;
+		}
+
+		if (m_elapsedTime >= m_nextReportTime)
+		{
+			PrintReport(false);
+			m_nextReportTime += m_config.reportInterval;
+		}
+
+		Nz::Time nextTickTime = Constants::TickDuration - m_tickAccumulator;
+		if (nextTickTime > Nz::Time::Milliseconds(2))
+			std::this_thread::sleep_for((nextTickTime - Nz::Time::Milliseconds(1)).AsDuration<std::chrono::milliseconds>());
+	}
+
+	void LoadTestAppComponent::ConnectBot(std::size_t botIndex, const Nz::IpAddress& serverAddress)
+	{
+		NetworkReactor& reactor = *m_reactors[botIndex / MaxBotPerReactor];
+
+		// Peer creation is asynchronous, the callback is called from Poll
+		reactor.ConnectTo(serverAddress, 0, [this, botIndex, &reactor, serverAddress](std::size_t peerId)
+		{
+			if (peerId == NetworkReactor::InvalidPeerId)
+			{
+				fmt::print(fg(fmt::color::red), "bot #{} failed to connect\n", botIndex);
+				m_statistics.IncrementDisconnectionCount();
+				return;
+			}
+
+			if (m_isFinished)
+			{
+				reactor.DisconnectPeer(peerId, 0, DisconnectionType::Kick);
+				return;
+			}
+
+			Bot& bot = *m_bots[botIndex];
+			bot.session.emplace(reactor, peerId, serverAddress);
+			bot.session->SetProtocolVersion(IsDevVersion() ? Nz::MaxValue() : GameVersion);
+			bot.sessionHandler = &bot.session->SetupHandler<BotSessionHandler>(m_config.behavior, m_statistics, static_cast<Nz::UInt32>(m_config.seed + botIndex));
+
+			m_botByPeerId[peerId] = botIndex;
+		});
+	}
+
+	void LoadTestAppComponent::PrintReport(bool isFinal)
+	{
+		std::size_t connectedCount = 0;
+		std::size_t authenticatedCount = 0;
+		for (auto& botPtr : m_bots)
+		{
+			if (!botPtr->session)
+				continue;
+
+			connectedCount++;
+			if (botPtr->sessionHandler->IsAuthenticated())
+				authenticatedCount++;
+		}
+
+		m_totalStatistics.Merge(m_statistics);
+		const BotStatistics& reportedStatistics = (isFinal) ? m_totalStatistics : m_statistics;
+
+		std::string report = fmt::format("{} ({}s): {}/{} bots connected, {} authenticated\n", (isFinal) ? "final report" : "report", m_elapsedTime.AsSeconds<int>(), connectedCount, m_config.botCount, authenticatedCount);
+		report += reportedStatistics.BuildReport();
+
+		// Reactor counters are never reset, this is the average since the start
+		NetworkStatistics::Snapshot networkSnapshot;
+		for (auto& reactorPtr : m_reactors)
+			networkSnapshot.Merge(reactorPtr->GetStatistics().TakeSnapshot());
+
+		report += networkSnapshot.BuildReport(5);
+
+		fmt::print("{}", report);
+
+		m_statistics.Reset();
+	}
+
+	void LoadTestAppComponent::QueryPings()
+	{
+		// Callbacks are called from Poll and dropped if the peer is gone, this component outlives the reactors
+		for (auto& botPtr : m_bots)
+		{
+			if (!botPtr->session || !botPtr->session->IsConnected())
+				continue;
+
+			botPtr->session->QueryInfo([this](const NetworkReactor::PeerInfo& peerInfo)
+			{
+				m_statistics.RecordPing(Nz::Time::Milliseconds(peerInfo.ping));
+			});
+		}
+	}
+}
@@ -0,0 +1,84 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_BOT_LOADTESTAPPCOMPONENT_HPP
+#define TSOM_BOT_LOADTESTAPPCOMPONENT_HPP
+
+#include <Bot/BotBehavior.hpp>
+#include <Bot/BotStatistics.hpp>
+#include <CommonLib/NetworkReactor.hpp>
+#include <CommonLib/NetworkSession.hpp>
+#include <Nazara/Core/ApplicationComponent.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <Nazara/Network/IpAddress.hpp>
+#include <tsl/hopscotch_map.h>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace tsom
+{
+	class BotSessionHandler;
+
+	// Connects a number of bots to a server, ticks them at the server rate and periodically prints what they measured
+	class LoadTestAppComponent final : public Nz::ApplicationComponent
+	{
+		public:
+			struct Config;
+
+			LoadTestAppComponent(Nz::ApplicationBase& app, Config config);
+			LoadTestAppComponent(const LoadTestAppComponent&) = delete;
+			LoadTestAppComponent(LoadTestAppComponent&&) = delete;
+			~LoadTestAppComponent();
+
+			void Update(Nz::Time elapsedTime) override;
+
+			LoadTestAppComponent& operator=(const LoadTestAppComponent&) = delete;
+			LoadTestAppComponent& operator=(LoadTestAppComponent&&) = delete;
+
+			struct Config
+			{
+				BotBehavior behavior = BotBehavior::Walker;
+				Nz::IpAddress serverAddress;
+				Nz::Time connectionInterval = Nz::Time::Milliseconds(50);
+				Nz::Time duration = Nz::Time::Zero(); //< zero to run until interrupted
+				Nz::Time reportInterval = Nz::Time::Seconds(10);
+				Nz::UInt32 seed = 0;
+				std::size_t botCount = 10;
+			};
+
+			static constexpr std::size_t MaxBotPerReactor = 128;
+
+		private:
+			void ConnectBot(std::size_t botIndex, const Nz::IpAddress& serverAddress);
+			void PrintReport(bool isFinal);
+			void QueryPings();
+
+			struct Bot
+			{
+				std::optional<NetworkSession> session;
+				BotSessionHandler* sessionHandler = nullptr;
+			};
+
+			std::size_t m_nextBotIndex;
+			std::vector<std::unique_ptr<NetworkReactor>> m_reactors;
+			std::vector<std::unique_ptr<Bot>> m_bots; //< must be destroyed before m_reactors
+			std::vector<std::pair<std::size_t, Nz::IpAddress>> m_redirectedBots;
+			tsl::hopscotch_map<std::size_t, std::size_t> m_botByPeerId;
+			BotStatistics m_statistics; //< since last report
+			BotStatistics m_totalStatistics;
+			Config m_config;
+			Nz::Time m_elapsedTime;
+			Nz::Time m_nextConnectionTime;
+			Nz::Time m_nextPingTime;
+			Nz::Time m_nextReportTime;
+			Nz::Time m_tickAccumulator;
+			bool m_isFinished;
+	};
+}
+
+#endif // TSOM_BOT_LOADTESTAPPCOMPONENT_HPP
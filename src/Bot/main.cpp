@@ -0,0 +1,84 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <CommonLib/Utility/CompressionDictionary.hpp>
+#include <Bot/LoadTestAppComponent.hpp>
+#include <Nazara/Core/Application.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/SignalHandlerAppComponent.hpp>
+#include <Nazara/Network/Network.hpp>
+#include <NazaraUtils/PathUtils.hpp>
+#include <Main/Main.hpp>
+#include <fmt/color.h>
+#include <charconv>
+
+int BotMain(int argc, char* argv[])
+{
+	Nz::Application<Nz::Core, Nz::Network> app(argc, argv);
+
+	auto& commandLineParams = app.GetCommandLineParameters();
+
+	bool hasError = false;
+	auto ParseNumber = [&](std::string_view parameterName, auto defaultValue)
+	{
+		std::string_view param;
+		decltype(defaultValue) value = defaultValue;
+		if (commandLineParams.GetParameter(parameterName, &param))
+		{
+			if (auto err = std::from_chars(param.data(), param.data() + param.size(), value); err.ec != std::errc{} || err.ptr != param.data() + param.size())
+			{
+				fmt::print(fg(fmt::color::red), "failed to parse {0} commandline parameter ({1}) as a number\n", parameterName, param);
+				hasError = true;
+			}
+		}
+
+		return value;
+	};
+
+	tsom::LoadTestAppComponent::Config config;
+	config.botCount = ParseNumber("bot-count", config.botCount);
+	config.connectionInterval = Nz::Time::Milliseconds(ParseNumber("connection-interval", 50));
+	config.duration = Nz::Time::Seconds(ParseNumber("duration", 0));
+	config.reportInterval = Nz::Time::Seconds(ParseNumber("report-interval", 10));
+	config.seed = ParseNumber("seed", config.seed);
+	Nz::UInt16 serverPort = ParseNumber("server-port", Nz::UInt16(29536));
+
+	std::string_view behaviorStr;
+	if (commandLineParams.GetParameter("behavior", &behaviorStr))
+	{
+		if (std::optional<tsom::BotBehavior> behavior = tsom::BotBehaviorFromString(behaviorStr))
+			config.behavior = *behavior;
+		else
+		{
+			fmt::print(fg(fmt::color::red), "unknown bot behavior {} (expected builder, flyer, idle, miner, mixed or walker)\n", behaviorStr);
+			hasError = true;
+		}
+	}
+
+	if (hasError)
+		return EXIT_FAILURE;
+
+	std::string_view serverAddress = "localhost";
+	commandLineParams.GetParameter("server-address", &serverAddress);
+
+	Nz::ResolveError resolveError;
+	auto hostVec = Nz::IpAddress::ResolveHostname(Nz::NetProtocol::Any, std::string(serverAddress), std::to_string(serverPort), &resolveError);
+	if (hostVec.empty())
+	{
+		fmt::print(fg(fmt::color::red), "failed to resolve {}: {}\n", serverAddress, Nz::ErrorToString(resolveError));
+		return EXIT_FAILURE;
+	}
+
+	config.serverAddress = hostVec[0].address;
+
+	// Chunk contents are compressed using the same dictionaries as the game
+	tsom::CompressionDictionary::LoadDirectory(Nz::Utf8Path("dictionaries"));
+
+	app.AddComponent<Nz::SignalHandlerAppComponent>();
+	app.AddComponent<tsom::LoadTestAppComponent>(std::move(config));
+
+	return app.Run();
+}
+
+TSOMMain(BotMain)
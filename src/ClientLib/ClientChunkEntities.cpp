@@ -12,11 +12,13 @@
 #include <Nazara/Core/IndexBuffer.hpp>
 #include <Nazara/Core/TaskSchedulerAppComponent.hpp>
 #include <Nazara/Core/VertexBuffer.hpp>
+#include <Nazara/Core/Components/DisabledComponent.hpp>
 #include <Nazara/Core/Components/NodeComponent.hpp>
 #include <Nazara/Graphics/GraphicalMesh.hpp>
 #include <Nazara/Graphics/Graphics.hpp>
 #include <Nazara/Graphics/MaterialInstance.hpp>
 #include <Nazara/Graphics/Model.hpp>
+#include <Nazara/Graphics/Components/CameraComponent.hpp>
 #include <Nazara/Graphics/Components/GraphicsComponent.hpp>
 #include <Nazara/Graphics/PropertyHandler/OptionValuePropertyHandler.hpp>
 #include <Nazara/Graphics/PropertyHandler/TexturePropertyHandler.hpp>
@@ -141,7 +143,18 @@ namespace tsom
 		FillChunks();
 	}
 
-	std::shared_ptr<Nz::Mesh> ClientChunkEntities::BuildMesh(const Chunk& chunk)
+	void ClientChunkEntities::Update()
+	{
+		std::optional<Nz::Vector3f> cameraPosition = ComputeCameraPosition();
+		if (cameraPosition)
+			UpdateLodLevels(*cameraPosition);
+
+		ChunkEntities::Update();
+
+		UpdateVisibility(cameraPosition);
+	}
+
+	std::shared_ptr<Nz::Mesh> ClientChunkEntities::BuildMesh(const Chunk& chunk, const Chunk::Snapshot& snapshot, unsigned int lodLevel)
 	{
 		std::vector<Nz::UInt32> indices;
 		std::vector<VertexStruct> vertices;
@@ -160,7 +173,7 @@ namespace tsom
 			return vertexAttributes;
 		};
 
-		chunk.BuildMesh(indices, m_chunkContainer.GetCenter() - m_chunkContainer.GetChunkOffset(chunk.GetIndices()), AddVertices);
+		chunk.BuildMesh(snapshot, lodLevel, indices, m_chunkContainer.GetCenter() - m_chunkContainer.GetChunkOffset(chunk.GetIndices()), AddVertices);
 		if (indices.empty())
 			return nullptr;
 
@@ -178,19 +191,55 @@ namespace tsom
 		return chunkMesh;
 	}
 
+	std::optional<Nz::Vector3f> ClientChunkEntities::ComputeCameraPosition() const
+	{
+		// Chunk LOD and visibility depend on the 3D camera position, in chunk container space
+		auto& registry = m_world.GetRegistry();
+		for (auto&& [entity, node, camera] : registry.view<Nz::NodeComponent, Nz::CameraComponent>(entt::exclude<Nz::DisabledComponent>).each())
+		{
+			if ((camera.GetRenderMask() & Constants::RenderMask3D) == 0)
+				continue;
+
+			Nz::Vector3f cameraPosition = node.GetGlobalPosition();
+			return (m_parentEntity) ? m_parentEntity.get<Nz::NodeComponent>().ToLocalPosition(cameraPosition) : cameraPosition;
+		}
+
+		return std::nullopt;
+	}
+
+	unsigned int ClientChunkEntities::ComputeLodLevel(const ChunkIndices& chunkIndices, unsigned int currentLodLevel) const
+	{
+		if (!m_lodOrigin)
+			return 0;
+
+		float distance = m_lodOrigin->Distance(m_chunkContainer.GetChunkOffset(chunkIndices));
+
+		unsigned int lodLevel = 0;
+		while (lodLevel < MaxLodLevel && distance > LodDistance * (1u << lodLevel))
+			lodLevel++;
+
+		// Hysteresis to prevent chunks at a LOD boundary from being remeshed back and forth
+		if (lodLevel < currentLodLevel && distance > LodDistance * (1u << (currentLodLevel - 1)) * 0.9f)
+			return currentLodLevel;
+
+		return lodLevel;
+	}
+
 	auto ClientChunkEntities::ProcessChunkUpdate(const Chunk& chunk, DirectionMask neighborMask) -> ColliderModelUpdateJob*
+	{
+		return StartChunkUpdate(chunk, neighborMask, true);
+	}
+
+	auto ClientChunkEntities::StartChunkUpdate(const Chunk& chunk, DirectionMask neighborMask, bool updateCollider) -> ColliderModelUpdateJob*
 	{
 		assert(chunk.HasContent());
 
-		// Try to cancel current update job to void useless work
-		if (auto it = m_updateJobs.find(chunk.GetIndices()); it != m_updateJobs.end())
-		{
-			UpdateJob& job = *it->second;
-			job.cancelled = true;
-		}
+		auto lodIt = m_chunkLodLevels.find(chunk.GetIndices());
+		unsigned int lodLevel = ComputeLodLevel(chunk.GetIndices(), (lodIt != m_chunkLodLevels.end()) ? lodIt->second : 0);
+		m_chunkLodLevels.insert_or_assign(chunk.GetIndices(), lodLevel);
 
-		std::shared_ptr<ColliderModelUpdateJob> updateJob = std::make_shared<ColliderModelUpdateJob>();
-		updateJob->taskCount = 2;
+		std::shared_ptr<ColliderModelUpdateJob> updateJob = PrepareUpdateJob<ColliderModelUpdateJob>(chunk.GetIndices(), (updateCollider) ? 2 : 1);
+		updateJob->updateCollider = updateCollider;
 
 		updateJob->applyFunc = [this](const ChunkIndices& chunkIndices, UpdateJob&& job)
 		{
@@ -198,8 +247,15 @@ namespace tsom
 
 			entt::handle chunkEntity = Nz::Retrieve(m_chunkEntities, chunkIndices);
 
-			auto& rigidBody = chunkEntity.get<Nz::RigidBody3DComponent>();
-			rigidBody.SetCollider(std::move(colliderUpdateJob.collider), false);
+			m_chunkFaceConnectivity.insert_or_assign(chunkIndices, colliderUpdateJob.faceConnectivity);
+
+			if (colliderUpdateJob.updateCollider)
+			{
+				auto& rigidBody = chunkEntity.get<Nz::RigidBody3DComponent>();
+				rigidBody.SetCollider(std::move(colliderUpdateJob.collider), false);
+
+				UpdateChunkDebugCollider(chunkIndices);
+			}
 
 			entt::handle visualEntity;
 			if (VisualEntityComponent* visualEntityComponent = chunkEntity.try_get<VisualEntityComponent>())
@@ -225,8 +281,15 @@ namespace tsom
 				entityOwnerComp.Register(visualEntity);
 			}
 
-			auto& gfxComponent = visualEntity.get_or_emplace<Nz::GraphicsComponent>();
-			gfxComponent.Clear();
+			Nz::GraphicsComponent* gfxComponent = visualEntity.try_get<Nz::GraphicsComponent>();
+			if (!gfxComponent)
+			{
+				// New graphics components start visible, let UpdateVisibility hide it again if needed
+				gfxComponent = &visualEntity.emplace<Nz::GraphicsComponent>();
+				m_hiddenChunks.erase(chunkIndices);
+			}
+
+			gfxComponent->Clear();
 
 			if (colliderUpdateJob.mesh)
 			{
@@ -236,35 +299,37 @@ namespace tsom
 				std::shared_ptr<Nz::Model> model = std::make_shared<Nz::Model>(std::move(gfxMesh));
 				model->SetMaterial(0, m_chunkMaterial);
 
-				gfxComponent.AttachRenderable(std::move(model), tsom::Constants::RenderMask3D);
+				gfxComponent->AttachRenderable(std::move(model), tsom::Constants::RenderMask3D);
 			}
-
-			UpdateChunkDebugCollider(chunkIndices);
 		};
 
+		// Tasks work on a copy-on-write snapshot of the blocks, the chunk can be modified meanwhile
+		Chunk::Snapshot snapshot = chunk.TakeSnapshot();
+
 		auto& taskScheduler = m_application.GetComponent<Nz::TaskSchedulerAppComponent>();
-		taskScheduler.AddTask([this, updateJob, chunkPtr = chunk.shared_from_this()]
+		if (updateCollider)
 		{
-			if (updateJob->cancelled)
-				return;
+			// Colliders are always built at full resolution
+			taskScheduler.AddTask([updateJob, chunkPtr = chunk.shared_from_this(), snapshot]
+			{
+				if (updateJob->cancelled)
+					return;
 
-			chunkPtr->LockRead();
-			updateJob->collider = chunkPtr->BuildCollider();
-			chunkPtr->UnlockRead();
+				updateJob->collider = chunkPtr->BuildCollider(snapshot);
 
-			updateJob->jobDone++;
-		});
+				updateJob->NotifyTaskDone();
+			});
+		}
 
-		taskScheduler.AddTask([this, updateJob, chunkPtr = chunk.shared_from_this()]
+		taskScheduler.AddTask([this, updateJob, chunkPtr = chunk.shared_from_this(), snapshot = std::move(snapshot), lodLevel]
 		{
 			if (updateJob->cancelled)
 				return;
 
-			chunkPtr->LockRead();
-			updateJob->mesh = BuildMesh(*chunkPtr);
-			chunkPtr->UnlockRead();
+			updateJob->mesh = BuildMesh(*chunkPtr, snapshot, lodLevel);
+			updateJob->faceConnectivity = chunkPtr->ComputeFaceConnectivity(snapshot);
 
-			updateJob->jobDone++;
+			updateJob->NotifyTaskDone();
 		});
 
 		// Add neighbor chunks
@@ -277,17 +342,143 @@ namespace tsom
 
 			updateJob->chunkDependencies.push_back(neighborIndices);
 
-			// Trigger our neighbor update
-			if (!m_updateJobs.contains(neighborIndices))
+			// Trigger our neighbor update (once per update, a pending job may have read the chunk before it changed)
+			if (!IsChunkUpdateScheduled(neighborIndices))
 				ProcessChunkUpdate(*neighborChunk, 0);
 		}
 
 		ColliderModelUpdateJob* jobPtr = updateJob.get();
-		m_updateJobs.insert_or_assign(chunk.GetIndices(), std::move(updateJob));
+		RegisterUpdateJob(chunk.GetIndices(), std::move(updateJob));
 
 		return jobPtr;
 	}
 
+	void ClientChunkEntities::UpdateLodLevels(const Nz::Vector3f& cameraPosition)
+	{
+		// Don't check every chunk each update, LOD distances are way bigger than that
+		if (m_lodOrigin && m_lodOrigin->SquaredDistance(cameraPosition) < LodUpdateDistance * LodUpdateDistance)
+			return;
+
+		m_lodOrigin = cameraPosition;
+
+		for (auto it = m_chunkLodLevels.begin(); it != m_chunkLodLevels.end();)
+		{
+			const ChunkIndices& chunkIndices = it->first;
+			const Chunk* chunk = m_chunkContainer.GetChunk(chunkIndices);
+			if (!chunk || !chunk->HasContent() || !m_chunkEntities.contains(chunkIndices))
+			{
+				it = m_chunkLodLevels.erase(it);
+				continue;
+			}
+
+			if (ComputeLodLevel(chunkIndices, it->second) != it->second)
+			{
+				// Only rebuild the mesh, unless a pending job was going to rebuild the collider as well
+				bool updateCollider = false;
+				if (auto jobIt = m_updateJobs.find(chunkIndices); jobIt != m_updateJobs.end())
+					updateCollider = static_cast<const ColliderModelUpdateJob&>(*jobIt->second).updateCollider;
+
+				StartChunkUpdate(*chunk, 0, updateCollider);
+			}
+
+			++it;
+		}
+	}
+
+	void ClientChunkEntities::UpdateVisibility(const std::optional<Nz::Vector3f>& cameraPosition)
+	{
+		for (auto it = m_chunkFaceConnectivity.begin(); it != m_chunkFaceConnectivity.end();)
+		{
+			if (!m_chunkEntities.contains(it->first))
+				it = m_chunkFaceConnectivity.erase(it);
+			else
+				++it;
+		}
+
+		for (auto it = m_hiddenChunks.begin(); it != m_hiddenChunks.end();)
+		{
+			if (!m_chunkEntities.contains(*it))
+				it = m_hiddenChunks.erase(it);
+			else
+				++it;
+		}
+
+		// Without a camera inside the chunks we can't tell which chunks are hidden, show everything
+		std::optional<ChunkIndices> cameraChunkIndices;
+		if (cameraPosition)
+		{
+			ChunkIndices chunkIndices = m_chunkContainer.GetChunkIndicesByPosition(*cameraPosition);
+			if (m_chunkEntities.contains(chunkIndices))
+				cameraChunkIndices = chunkIndices;
+		}
+
+		m_visibleChunks.clear();
+		if (cameraChunkIndices)
+		{
+			struct PendingChunk
+			{
+				ChunkIndices chunkIndices;
+				Direction entryFace;
+				DirectionMask travelDirections;
+			};
+
+			// Flood fill from the camera chunk, a chunk can only be seen through if the face we entered it from is connected to the face we leave it from,
+			// and we never go back in a direction we came from (as a straight line of sight can't do that)
+			std::vector<PendingChunk> pendingChunks;
+
+			m_visibleChunks.insert(*cameraChunkIndices);
+			for (auto&& [direction, offset] : s_chunkDirOffset.iter_kv())
+				pendingChunks.push_back({ *cameraChunkIndices + offset, s_oppositeDirections[direction], direction });
+
+			for (std::size_t i = 0; i < pendingChunks.size(); ++i)
+			{
+				PendingChunk pendingChunk = pendingChunks[i];
+				if (!m_chunkEntities.contains(pendingChunk.chunkIndices))
+					continue;
+
+				if (!m_visibleChunks.insert(pendingChunk.chunkIndices).second)
+					continue;
+
+				// Chunks which haven't been meshed yet don't block the view
+				DirectionMask exitFaces = DirectionMask_All;
+				if (auto it = m_chunkFaceConnectivity.find(pendingChunk.chunkIndices); it != m_chunkFaceConnectivity.end())
+					exitFaces = it->second[pendingChunk.entryFace];
+
+				for (Direction exitFace : exitFaces)
+				{
+					if (pendingChunk.travelDirections.Test(s_oppositeDirections[exitFace]))
+						continue;
+
+					pendingChunks.push_back({ pendingChunk.chunkIndices + s_chunkDirOffset[exitFace], s_oppositeDirections[exitFace], pendingChunk.travelDirections | exitFace });
+				}
+			}
+		}
+
+		for (auto&& [chunkIndices, chunkEntity] : m_chunkEntities)
+		{
+			VisualEntityComponent* visualEntityComponent = chunkEntity.try_get<VisualEntityComponent>();
+			if (!visualEntityComponent)
+				continue;
+
+			// Showing or hiding a graphics component updates the render world, only do it when visibility changed
+			bool isVisible = !cameraChunkIndices || m_visibleChunks.contains(chunkIndices);
+			bool wasVisible = !m_hiddenChunks.contains(chunkIndices);
+			if (isVisible == wasVisible)
+				continue;
+
+			Nz::GraphicsComponent* gfxComponent = visualEntityComponent->visualEntity.try_get<Nz::GraphicsComponent>();
+			if (!gfxComponent)
+				continue;
+
+			gfxComponent->Show(isVisible);
+
+			if (isVisible)
+				m_hiddenChunks.erase(chunkIndices);
+			else
+				m_hiddenChunks.insert(chunkIndices);
+		}
+	}
+
 	void ClientChunkEntities::UpdateChunkDebugCollider(const ChunkIndices& chunkIndices)
 	{
 #if 0
@@ -81,7 +81,7 @@ namespace tsom
 
 		m_entityRegistry.RegisterClassLibrary<ClientChunkClassLibrary>(m_app, m_blockLibrary);
 
-		m_scriptingContext.RegisterLibrary<ClientEntityScriptingLibrary>(m_entityRegistry);
+		m_scriptingContext.RegisterLibrary<ClientEntityScriptingLibrary>(m_entityRegistry, m_scriptingContext.GetProfiler(), m_scriptingContext.GetScheduler());
 
 		LoadScripts();
 	}
@@ -170,13 +170,11 @@ namespace tsom
 			return;
 		}
 
-		chunk->LockWrite();
 		chunk->Reset([&](BlockIndex* blocks)
 		{
 			for (BlockIndex blockContent : chunkReset.content)
 				*blocks++ = blockContent;
 		});
-		chunk->UnlockWrite();
 	}
 
 	void ClientSessionHandler::HandlePacket(Packets::ChunkUpdate&& chunkUpdate)
@@ -186,12 +184,8 @@ namespace tsom
 		auto& chunkNetworkMap = entity.get<ChunkNetworkMapComponent>();
 
 		Chunk* chunk = Nz::Retrieve(chunkNetworkMap.chunkByNetworkIndex, chunkUpdate.chunkId);
-		chunk->LockWrite();
-
 		for (auto&& [blockPos, blockIndex] : chunkUpdate.updates)
 			chunk->UpdateBlock({ blockPos.x, blockPos.y, blockPos.z }, Nz::SafeCast<BlockIndex>(blockIndex));
-
-		chunk->UnlockWrite();
 	}
 
 	void ClientSessionHandler::HandlePacket(Packets::DebugDrawLineList&& debugDrawLineList)
@@ -354,6 +348,19 @@ namespace tsom
 		}
 	}
 
+	void ClientSessionHandler::HandlePacket(Packets::EntitiesPropertyUpdate&& propertyUpdate)
+	{
+		for (auto& entity : propertyUpdate.entities)
+		{
+			assert(m_entities[entity.entityId]);
+			EntityData& entityData = *m_entities[entity.entityId];
+
+			auto& classInstance = entityData.entity.get<ClassInstanceComponent>();
+			for (auto& property : entity.properties)
+				classInstance.UpdateProperty(property.propertyIndex, std::move(property.propertyValue));
+		}
+	}
+
 	void ClientSessionHandler::HandlePacket(Packets::EntitiesStateUpdate&& stateUpdate)
 	{
 		for (auto& entityStates : stateUpdate.entities)
@@ -381,7 +388,13 @@ namespace tsom
 		}
 
 		if (stateUpdate.controlledCharacter)
+		{
+			// Only count inputs as acknowledged when the prediction history was actually reconciled
+			if (IsInputMoreRecent(stateUpdate.lastInputIndex, m_lastInputIndex))
+				m_lastInputIndex = stateUpdate.lastInputIndex;
+
 			OnControlledEntityStateUpdate(stateUpdate.lastInputIndex, *stateUpdate.controlledCharacter);
+		}
 	}
 
 	void ClientSessionHandler::HandlePacket(Packets::EntityEnvironmentUpdate&& environmentUpdate)
@@ -510,6 +523,16 @@ namespace tsom
 		}
 	}
 
+	void ClientSessionHandler::HandlePacket(Packets::InputAck&& inputAck)
+	{
+		// Acks can arrive after a state update which already acknowledged a more recent input
+		if (!IsInputMoreRecent(inputAck.lastInputIndex, m_lastInputIndex))
+			return;
+
+		m_lastInputIndex = inputAck.lastInputIndex;
+		OnInputAcknowledged(inputAck.lastInputIndex);
+	}
+
 	void ClientSessionHandler::HandlePacket(Packets::NetworkStrings&& networkStrings)
 	{
 		GetSession()->GetStringStore().FillStore(networkStrings.startId, std::move(networkStrings.strings));
@@ -517,27 +540,33 @@ namespace tsom
 
 	void ClientSessionHandler::HandlePacket(Packets::PlayerJoin&& playerJoin)
 	{
-		if (playerJoin.index >= m_players.size())
-			m_players.resize(playerJoin.index + 1);
+		for (auto& playerData : playerJoin.players)
+		{
+			if (playerData.index >= m_players.size())
+				m_players.resize(playerData.index + 1);
 
-		auto& playerInfo = m_players[playerJoin.index].emplace();
-		playerInfo.nickname = std::move(playerJoin.nickname).Str();
-		playerInfo.isAuthenticated = playerJoin.isAuthenticated;
+			auto& playerInfo = m_players[playerData.index].emplace();
+			playerInfo.nickname = std::move(playerData.nickname).Str();
+			playerInfo.isAuthenticated = playerData.isAuthenticated;
 
-		OnPlayerJoined(playerInfo);
+			OnPlayerJoined(playerInfo);
+		}
 	}
 
 	void ClientSessionHandler::HandlePacket(Packets::PlayerLeave&& playerLeave)
 	{
-		if (playerLeave.index >= m_players.size() || !m_players[playerLeave.index])
+		for (PlayerIndex playerIndex : playerLeave.indices)
 		{
-			fmt::print(fg(fmt::color::red), "PlayerLeave with unknown player index {}\n", playerLeave.index);
-			return;
-		}
+			if (playerIndex >= m_players.size() || !m_players[playerIndex])
+			{
+				fmt::print(fg(fmt::color::red), "PlayerLeave with unknown player index {}\n", playerIndex);
+				continue;
+			}
 
-		OnPlayerLeave(*m_players[playerLeave.index]);
+			OnPlayerLeave(*m_players[playerIndex]);
 
-		m_players[playerLeave.index].reset();
+			m_players[playerIndex].reset();
+		}
 	}
 
 	void ClientSessionHandler::HandlePacket(Packets::PlayerNameUpdate&& playerNameUpdate)
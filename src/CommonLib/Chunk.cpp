@@ -8,8 +8,8 @@
 #include <CommonLib/InternalConstants.hpp>
 #include <Nazara/Core/ByteStream.hpp>
 #include <Nazara/Math/Box.hpp>
-#include <NazaraUtils/CallOnExit.hpp>
 #include <NazaraUtils/EnumArray.hpp>
+#include <algorithm>
 #include <cassert>
 #include <numeric>
 
@@ -17,8 +17,11 @@ namespace tsom
 {
 	Chunk::~Chunk() = default;
 
-	void Chunk::BuildMesh(std::vector<Nz::UInt32>& indices, const Nz::Vector3f& gravityCenter, const Nz::FunctionRef<VertexAttributes(const Nz::Vector3ui& blockIndices, Direction direction)>& addFace) const
+	void Chunk::BuildMesh(const Snapshot& snapshot, unsigned int lodLevel, std::vector<Nz::UInt32>& indices, const Nz::Vector3f& gravityCenter, const Nz::FunctionRef<VertexAttributes(const Nz::Vector3ui& blockIndices, Direction direction)>& addFace) const
 	{
+		// Far chunks can be meshed with cells of lodScale^3 blocks
+		unsigned int lodScale = 1u << lodLevel;
+
 		auto DrawFace = [&](BlockIndex blockContent, const Nz::Vector3ui& blockIndices, Direction direction, const Nz::Vector3f& blockCenter, const std::array<Nz::Vector3f, 4>& pos)
 		{
 			VertexAttributes vertexAttributes = addFace(blockIndices, direction);
@@ -104,7 +107,7 @@ namespace tsom
 						}
 					}
 
-					vertexAttributes.uv[i] = Nz::Vector3f(uv * mag + Nz::Vector2f(0.5f), sliceIndex);
+					vertexAttributes.uv[i] = Nz::Vector3f(uv * mag * float(lodScale) + Nz::Vector2f(0.5f), sliceIndex); //< repeat texture on LOD cells
 				}
 			}
 
@@ -118,107 +121,148 @@ namespace tsom
 			}
 		};
 
-		// Find and lock all neighbor chunks to avoid discrepancies between chunks
-		Nz::EnumArray<Direction, const Chunk*> neighborChunks;
-		for (auto&& [dir, chunk] : neighborChunks.iter_kv())
-		{
-			chunk = m_owner.GetChunk(m_indices + s_chunkDirOffset[dir]);
-			if (!chunk)
-				continue;
+		assert(snapshot.blocks);
+		const ChunkBlocks& blocks = *snapshot.blocks;
 
-			chunk->LockRead();
-		}
+		NazaraAssertMsg(m_size.x % lodScale == 0 && m_size.y % lodScale == 0 && m_size.z % lodScale == 0, "chunk size must be a multiple of the LOD scale");
+
+		Nz::Vector3ui cellCount = m_size / lodScale;
 
-		NAZARA_DEFER(
+		std::vector<BlockIndex> lodBlocks;
+		if (lodLevel > 0)
 		{
-			for (const Chunk* chunk : neighborChunks)
+			// A cell takes the most common non-empty block it contains, a cell is only empty if all its blocks are (this prevents holes at LOD seams)
+			lodBlocks.resize(cellCount.x * cellCount.y * cellCount.z, EmptyBlockIndex);
+
+			std::vector<std::pair<BlockIndex, unsigned int>> blockCounts;
+			BlockIndex* lodBlockPtr = lodBlocks.data();
+			for (unsigned int z = 0; z < cellCount.z; ++z)
 			{
-				if (chunk)
-					chunk->UnlockRead();
+				for (unsigned int y = 0; y < cellCount.y; ++y)
+				{
+					for (unsigned int x = 0; x < cellCount.x; ++x)
+					{
+						blockCounts.clear();
+
+						Nz::Vector3ui firstBlockIndices = Nz::Vector3ui(x, y, z) * lodScale;
+						for (unsigned int dz = 0; dz < lodScale; ++dz)
+						{
+							for (unsigned int dy = 0; dy < lodScale; ++dy)
+							{
+								for (unsigned int dx = 0; dx < lodScale; ++dx)
+								{
+									BlockIndex blockContent = blocks.GetBlockContent(firstBlockIndices + Nz::Vector3ui(dx, dy, dz));
+									if (blockContent == EmptyBlockIndex)
+										continue;
+
+									auto it = std::find_if(blockCounts.begin(), blockCounts.end(), [&](const auto& pair) { return pair.first == blockContent; });
+									if (it != blockCounts.end())
+										it->second++;
+									else
+										blockCounts.emplace_back(blockContent, 1);
+								}
+							}
+						}
+
+						if (!blockCounts.empty())
+							*lodBlockPtr = std::max_element(blockCounts.begin(), blockCounts.end(), [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; })->first;
+
+						lodBlockPtr++;
+					}
+				}
 			}
-		});
+		}
+
+		auto GetCellContent = [&](const Nz::Vector3ui& cellIndices) -> BlockIndex
+		{
+			if (lodLevel == 0)
+				return blocks.GetBlockContent(cellIndices);
+
+			return lodBlocks[cellCount.x * (cellCount.y * cellIndices.z + cellIndices.y) + cellIndices.x];
+		};
 
-		auto GetNeighborBlock = [&](Nz::Vector3ui indices, Direction direction) -> std::optional<BlockIndex>
+		auto IsTransparent = [&](BlockIndex blockIndex, BlockIndex neighborBlockIndex)
 		{
-			ChunkIndices chunkIndices = m_indices;
-			std::swap(chunkIndices.y, chunkIndices.z);
+			// don't render faces between blocks of the same type even if transparent
+			if (blockIndex == neighborBlockIndex)
+				return false;
 
+			const auto& neighborBlockData = m_blockLibrary.GetBlockData(neighborBlockIndex);
+			return neighborBlockData.isTransparent;
+		};
+
+		auto IsFaceVisible = [&](const Nz::Vector3ui& cellIndices, BlockIndex blockIndex, Direction direction)
+		{
+			const Nz::Vector3i& offset = s_blockDirOffset[direction];
+
+			Nz::Vector3i neighborCellIndices = Nz::Vector3i(cellIndices) + offset;
+			if (neighborCellIndices.x >= 0 && neighborCellIndices.x < Nz::SafeCast<int>(cellCount.x) &&
+				neighborCellIndices.y >= 0 && neighborCellIndices.y < Nz::SafeCast<int>(cellCount.y) &&
+				neighborCellIndices.z >= 0 && neighborCellIndices.z < Nz::SafeCast<int>(cellCount.z))
+				return IsTransparent(blockIndex, GetCellContent(Nz::Vector3ui(neighborCellIndices)));
+
+			const ChunkBlocks* neighborBlocks = snapshot.neighborBlocks[direction].get();
+			if (!neighborBlocks)
+				return true;
+
+			// Neighbor chunk may be meshed at another LOD, look at all its blocks touching the face at full resolution
+			Nz::Vector3ui firstBlockIndices = cellIndices * lodScale;
+			Nz::Vector3ui lastBlockIndices = firstBlockIndices + Nz::Vector3ui(lodScale - 1);
 			for (unsigned int axis : { 0, 1, 2 })
 			{
-				unsigned int& index = indices[axis];
-				int offset = s_blockDirOffset[direction][axis];
-				assert(offset >= -1 && offset <= 1);
+				if (offset[axis] > 0)
+					firstBlockIndices[axis] = lastBlockIndices[axis] = 0;
+				else if (offset[axis] < 0)
+					firstBlockIndices[axis] = lastBlockIndices[axis] = m_size[axis] - 1;
+			}
 
-				if (offset > 0)
-				{
-					index += offset;
-					if (index >= m_size[axis])
-					{
-						index -= m_size[axis];
-						chunkIndices[axis]++;
-					}
-				}
-				else if (offset < 0)
+			for (unsigned int z = firstBlockIndices.z; z <= lastBlockIndices.z; ++z)
+			{
+				for (unsigned int y = firstBlockIndices.y; y <= lastBlockIndices.y; ++y)
 				{
-					unsigned int posOffset = std::abs(offset);
-					if (posOffset > index)
+					for (unsigned int x = firstBlockIndices.x; x <= lastBlockIndices.x; ++x)
 					{
-						index += m_size[axis];
-						chunkIndices[axis]--;
+						if (IsTransparent(blockIndex, neighborBlocks->GetBlockContent({ x, y, z })))
+							return true;
 					}
-
-					index -= posOffset;
 				}
 			}
 
-			std::swap(chunkIndices.y, chunkIndices.z);
-
-			if (chunkIndices != m_indices)
-			{
-				const Chunk* chunk = neighborChunks[direction];
-				if (!chunk)
-					return {};
-
-				if (!chunk->HasContent())
-					return {};
-
-				return chunk->GetBlockContent(indices);
-			}
-			else
-				return GetBlockContent(indices);
+			return false;
 		};
 
-		for (unsigned int z = 0; z < m_size.z; ++z)
+		for (unsigned int z = 0; z < cellCount.z; ++z)
 		{
-			for (unsigned int y = 0; y < m_size.y; ++y)
+			for (unsigned int y = 0; y < cellCount.y; ++y)
 			{
-				for (unsigned int x = 0; x < m_size.x; ++x)
+				for (unsigned int x = 0; x < cellCount.x; ++x)
 				{
-					Nz::Vector3ui blockIndices(x, y, z);
+					Nz::Vector3ui cellIndices(x, y, z);
+					Nz::Vector3ui blockIndices = cellIndices * lodScale;
 
-					BlockIndex blockIndex = GetBlockContent(blockIndices);
+					BlockIndex blockIndex = GetCellContent(cellIndices);
 					if (blockIndex == EmptyBlockIndex)
 						continue;
 
 					const auto& blockData = m_blockLibrary.GetBlockData(blockIndex);
 
 					// Get unaltered voxel corners and deform them next
-					Nz::EnumArray<Nz::BoxCorner, Nz::Vector3f> corners = Chunk::ComputeVoxelCorners(blockIndices);
-
-					Nz::Vector3f blockCenter = std::accumulate(corners.begin(), corners.end(), Nz::Vector3f::Zero()) / corners.size();
-
-					auto IsTransparent = [&](BlockIndex neighborBlockIndex)
+					Nz::EnumArray<Nz::BoxCorner, Nz::Vector3f> corners;
+					if (lodLevel > 0)
 					{
-						// don't render faces between blocks of the same type even if transparent
-						if (blockIndex == neighborBlockIndex)
-							return false;
+						Nz::Vector3f blockPos = (Nz::Vector3f(blockIndices) - Nz::Vector3f(m_size) * 0.5f) * m_blockSize;
+						float cellSize = m_blockSize * lodScale;
 
-						const auto& neighborBlockData = m_blockLibrary.GetBlockData(neighborBlockIndex);
-						return neighborBlockData.isTransparent;
-					};
+						Nz::Boxf box(blockPos.x, blockPos.z, blockPos.y, cellSize, cellSize, cellSize);
+						corners = box.GetCorners();
+					}
+					else
+						corners = Chunk::ComputeVoxelCorners(blockIndices);
+
+					Nz::Vector3f blockCenter = std::accumulate(corners.begin(), corners.end(), Nz::Vector3f::Zero()) / corners.size();
 
 					// Up
-					if (auto neighborOpt = GetNeighborBlock(blockIndices, Direction::Up); !neighborOpt || IsTransparent(*neighborOpt))
+					if (IsFaceVisible(cellIndices, blockIndex, Direction::Up))
 					{
 						DrawFace(blockIndex, blockIndices, Direction::Up, blockCenter, { corners[Nz::BoxCorner::RightTopNear], corners[Nz::BoxCorner::LeftTopNear], corners[Nz::BoxCorner::RightBottomNear], corners[Nz::BoxCorner::LeftBottomNear] });
 						if (blockData.isDoubleSided)
@@ -226,7 +270,7 @@ namespace tsom
 					}
 
 					// Down
-					if (auto neighborOpt = GetNeighborBlock(blockIndices, Direction::Down); !neighborOpt || IsTransparent(*neighborOpt))
+					if (IsFaceVisible(cellIndices, blockIndex, Direction::Down))
 					{
 						DrawFace(blockIndex, blockIndices, Direction::Down, blockCenter, { corners[Nz::BoxCorner::LeftTopFar], corners[Nz::BoxCorner::RightTopFar], corners[Nz::BoxCorner::LeftBottomFar], corners[Nz::BoxCorner::RightBottomFar] });
 						if (blockData.isDoubleSided)
@@ -234,7 +278,7 @@ namespace tsom
 					}
 
 					// Front
-					if (auto neighborOpt = GetNeighborBlock(blockIndices, Direction::Front); !neighborOpt || IsTransparent(*neighborOpt))
+					if (IsFaceVisible(cellIndices, blockIndex, Direction::Front))
 					{
 						DrawFace(blockIndex, blockIndices, Direction::Front, blockCenter, { corners[Nz::BoxCorner::RightTopFar], corners[Nz::BoxCorner::RightTopNear], corners[Nz::BoxCorner::RightBottomFar], corners[Nz::BoxCorner::RightBottomNear] });
 						if (blockData.isDoubleSided)
@@ -242,7 +286,7 @@ namespace tsom
 					}
 
 					// Back
-					if (auto neighborOpt = GetNeighborBlock(blockIndices, Direction::Back); !neighborOpt || IsTransparent(*neighborOpt))
+					if (IsFaceVisible(cellIndices, blockIndex, Direction::Back))
 					{
 						DrawFace(blockIndex, blockIndices, Direction::Back, blockCenter, { corners[Nz::BoxCorner::LeftTopNear], corners[Nz::BoxCorner::LeftTopFar], corners[Nz::BoxCorner::LeftBottomNear], corners[Nz::BoxCorner::LeftBottomFar] });
 						if (blockData.isDoubleSided)
@@ -250,7 +294,7 @@ namespace tsom
 					}
 
 					// Left
-					if (auto neighborOpt = GetNeighborBlock(blockIndices, Direction::Left); !neighborOpt || IsTransparent(*neighborOpt))
+					if (IsFaceVisible(cellIndices, blockIndex, Direction::Left))
 					{
 						DrawFace(blockIndex, blockIndices, Direction::Left, blockCenter, { corners[Nz::BoxCorner::RightBottomNear], corners[Nz::BoxCorner::LeftBottomNear], corners[Nz::BoxCorner::RightBottomFar], corners[Nz::BoxCorner::LeftBottomFar] });
 						if (blockData.isDoubleSided)
@@ -258,7 +302,7 @@ namespace tsom
 					}
 
 					// Right
-					if (auto neighborOpt = GetNeighborBlock(blockIndices, Direction::Right); !neighborOpt || IsTransparent(*neighborOpt))
+					if (IsFaceVisible(cellIndices, blockIndex, Direction::Right))
 					{
 						DrawFace(blockIndex, blockIndices, Direction::Right, blockCenter, { corners[Nz::BoxCorner::LeftTopNear], corners[Nz::BoxCorner::RightTopNear], corners[Nz::BoxCorner::LeftTopFar], corners[Nz::BoxCorner::RightTopFar] });
 						if (blockData.isDoubleSided)
@@ -269,6 +313,63 @@ namespace tsom
 		}
 	}
 
+	Nz::EnumArray<Direction, DirectionMask> Chunk::ComputeFaceConnectivity(const Snapshot& snapshot) const
+	{
+		// Flood fill non-opaque blocks to find which faces of the chunk are connected to each other (cave culling)
+		Nz::EnumArray<Direction, DirectionMask> faceConnectivity;
+
+		const ChunkBlocks& blocks = *snapshot.blocks;
+		const Nz::Vector3ui& size = blocks.GetSize();
+
+		auto IsOpaque = [&](unsigned int blockIndex)
+		{
+			return !m_blockLibrary.GetBlockData(blocks.GetBlockContent(blockIndex)).isTransparent;
+		};
+
+		Nz::Bitset<Nz::UInt64> visitedBlocks(blocks.GetBlockCount(), false);
+		std::vector<unsigned int> pendingBlocks;
+		for (unsigned int startIndex = 0; startIndex < blocks.GetBlockCount(); ++startIndex)
+		{
+			if (visitedBlocks.Test(startIndex) || IsOpaque(startIndex))
+				continue;
+
+			DirectionMask reachedFaces;
+
+			visitedBlocks.Set(startIndex);
+			pendingBlocks.push_back(startIndex);
+			while (!pendingBlocks.empty())
+			{
+				unsigned int blockIndex = pendingBlocks.back();
+				pendingBlocks.pop_back();
+
+				Nz::Vector3i blockIndices = Nz::Vector3i(blocks.GetBlockLocalIndices(blockIndex));
+				for (auto&& [direction, offset] : s_blockDirOffset.iter_kv())
+				{
+					Nz::Vector3i neighborIndices = blockIndices + offset;
+					if (neighborIndices.x < 0 || neighborIndices.x >= Nz::SafeCast<int>(size.x) ||
+						neighborIndices.y < 0 || neighborIndices.y >= Nz::SafeCast<int>(size.y) ||
+						neighborIndices.z < 0 || neighborIndices.z >= Nz::SafeCast<int>(size.z))
+					{
+						reachedFaces |= direction;
+						continue;
+					}
+
+					unsigned int neighborIndex = blocks.GetBlockLocalIndex(Nz::Vector3ui(neighborIndices));
+					if (visitedBlocks.Test(neighborIndex) || IsOpaque(neighborIndex))
+						continue;
+
+					visitedBlocks.Set(neighborIndex);
+					pendingBlocks.push_back(neighborIndex);
+				}
+			}
+
+			for (Direction face : reachedFaces)
+				faceConnectivity[face] |= reachedFaces;
+		}
+
+		return faceConnectivity;
+	}
+
 	Nz::EnumArray<Nz::BoxCorner, Nz::Vector3f> Chunk::ComputeVoxelCorners(const Nz::Vector3ui& indices) const
 	{
 		Nz::Vector3f blockPos = (Nz::Vector3f(indices) - Nz::Vector3f(m_size) * 0.5f) * m_blockSize;
@@ -326,9 +427,11 @@ namespace tsom
 		}
 
 		Reset();
+
+		std::vector<BlockIndex>& blocks = EditBlocks().m_blocks;
 		if (blockTypeCount > 8)
 		{
-			for (BlockIndex& blockIndex : m_blocks)
+			for (BlockIndex& blockIndex : blocks)
 			{
 				Nz::UInt16 value;
 				byteStream >> value;
@@ -338,7 +441,7 @@ namespace tsom
 		}
 		else
 		{
-			for (BlockIndex& blockIndex : m_blocks)
+			for (BlockIndex& blockIndex : blocks)
 			{
 				Nz::UInt8 value;
 				byteStream >> value;
@@ -375,29 +478,46 @@ namespace tsom
 			byteStream << m_blockLibrary.GetBlockData(i).name;
 		}
 
+		NazaraAssertMsg(m_blocks, "chunk has not been reset");
+		const std::vector<BlockIndex>& blocks = m_blocks->m_blocks;
+
 		// nextUniqueIndex is the number of bits required to store all the different block types used
 		if (nextUniqueIndex > 8)
 		{
-			for (BlockIndex blockIndex : m_blocks)
+			for (BlockIndex blockIndex : blocks)
 				byteStream << static_cast<Nz::UInt16>(serializationIndices[blockIndex]);
 		}
 		else
 		{
-			for (BlockIndex blockIndex : m_blocks)
+			for (BlockIndex blockIndex : blocks)
 				byteStream << static_cast<Nz::UInt8>(serializationIndices[blockIndex]);
 		}
 	}
 
+	auto Chunk::TakeSnapshot() const -> Snapshot
+	{
+		Snapshot snapshot;
+		snapshot.blocks = GetBlocks();
+
+		for (auto&& [dir, neighborBlocks] : snapshot.neighborBlocks.iter_kv())
+		{
+			if (const Chunk* chunk = m_owner.GetChunk(m_indices + s_chunkDirOffset[dir]))
+				neighborBlocks = chunk->GetBlocks();
+		}
+
+		return snapshot;
+	}
+
 	void Chunk::UpdateBlock(const Nz::Vector3ui& indices, BlockIndex newBlock)
 	{
-		NazaraAssertMsg(!m_blocks.empty(), "chunk has not been reset");
+		ChunkBlocks& blocks = EditBlocks();
 
 		const auto& blockData = m_blockLibrary.GetBlockData(newBlock);
 
 		unsigned int blockIndex = GetBlockLocalIndex(indices);
-		BlockIndex oldContent = m_blocks[blockIndex];
-		m_blocks[blockIndex] = newBlock;
-		m_collisionCellMask[blockIndex] = blockData.hasCollisions;
+		BlockIndex oldContent = blocks.m_blocks[blockIndex];
+		blocks.m_blocks[blockIndex] = newBlock;
+		blocks.m_collisionCellMask[blockIndex] = blockData.hasCollisions;
 
 		m_blockTypeCount[oldContent]--;
 		if (newBlock >= m_blockTypeCount.size())
@@ -410,12 +530,14 @@ namespace tsom
 
 	void Chunk::OnChunkReset()
 	{
+		ChunkBlocks& blocks = EditBlocks();
+
 		std::fill(m_blockTypeCount.begin(), m_blockTypeCount.end(), 0);
-		for (std::size_t blockIndex = 0; blockIndex < m_blocks.size(); ++blockIndex)
+		for (std::size_t blockIndex = 0; blockIndex < blocks.m_blocks.size(); ++blockIndex)
 		{
-			BlockIndex blockContent = m_blocks[blockIndex];
+			BlockIndex blockContent = blocks.m_blocks[blockIndex];
 			const auto& blockData = m_blockLibrary.GetBlockData(blockContent);
-			m_collisionCellMask[blockIndex] = blockData.hasCollisions;
+			blocks.m_collisionCellMask[blockIndex] = blockData.hasCollisions;
 
 			if (blockContent >= m_blockTypeCount.size())
 				m_blockTypeCount.resize(blockContent + 1);
@@ -5,12 +5,15 @@
 #include <CommonLib/ChunkEntities.hpp>
 #include <CommonLib/BlockLibrary.hpp>
 #include <CommonLib/PhysicsConstants.hpp>
+#include <CommonLib/TickProfiler.hpp>
 #include <CommonLib/Components/ChunkComponent.hpp>
 #include <CommonLib/Components/EntityOwnerComponent.hpp>
 #include <Nazara/Core/ApplicationBase.hpp>
 #include <Nazara/Core/EnttWorld.hpp>
 #include <Nazara/Core/TaskSchedulerAppComponent.hpp>
+#include <Nazara/Core/Components/DisabledComponent.hpp>
 #include <Nazara/Core/Components/NodeComponent.hpp>
+#include <Nazara/Physics3D/Components/PhysCharacter3DComponent.hpp>
 #include <Nazara/Physics3D/Components/RigidBody3DComponent.hpp>
 #include <cassert>
 
@@ -26,16 +29,25 @@ namespace tsom
 	m_application(application),
 	m_world(world),
 	m_blockLibrary(blockLibrary),
-	m_chunkContainer(chunkContainer)
+	m_chunkContainer(chunkContainer),
+	m_updateCounter(0),
+	m_colliderActivationDistance(0.f)
 	{
+		m_finishedJobQueue = std::make_shared<FinishedJobQueue>();
+
 		m_onChunkAdded.Connect(chunkContainer.OnChunkAdded, [this](ChunkContainer* /*emitter*/, Chunk* chunk)
 		{
+			// Chunk entity will be created when a body gets close
+			if (m_colliderActivationDistance > 0.f)
+				return;
+
 			CreateChunkEntity(chunk->GetIndices(), *chunk);
 		});
 
 		m_onChunkRemove.Connect(chunkContainer.OnChunkRemove, [this](ChunkContainer* /*emitter*/, Chunk* chunk)
 		{
 			DestroyChunkEntity(chunk->GetIndices());
+			m_chunkLastUse.erase(chunk->GetIndices());
 		});
 
 		m_onChunkUpdated.Connect(chunkContainer.OnChunkUpdated, [this](ChunkContainer* /*emitter*/, Chunk* chunk, DirectionMask neighborMask)
@@ -56,6 +68,31 @@ namespace tsom
 		}
 	}
 
+	void ChunkEntities::SetColliderActivationDistance(float distance)
+	{
+		bool wasLazy = m_colliderActivationDistance > 0.f;
+		m_colliderActivationDistance = distance;
+
+		if (distance > 0.f)
+		{
+			if (!wasLazy)
+			{
+				// Existing chunk entities will be released if no body comes near them
+				for (auto it = m_chunkEntities.begin(); it != m_chunkEntities.end(); ++it)
+					m_chunkLastUse.insert_or_assign(it->first, m_updateCounter);
+			}
+		}
+		else if (wasLazy)
+		{
+			m_chunkLastUse.clear();
+			m_chunkContainer.ForEachChunk([this](const ChunkIndices& chunkIndices, Chunk& chunk)
+			{
+				if (!m_chunkEntities.contains(chunkIndices))
+					CreateChunkEntity(chunkIndices, chunk);
+			});
+		}
+	}
+
 	void ChunkEntities::SetParentEntity(entt::handle entity)
 	{
 		m_parentEntity = entity;
@@ -70,11 +107,44 @@ namespace tsom
 
 	void ChunkEntities::Update()
 	{
-		for (auto it = m_updateJobs.begin(); it != m_updateJobs.end(); ++it)
+		if (m_colliderActivationDistance > 0.f)
+			UpdateActiveChunks();
+
+		CommitFinishedJobs();
+
+		// Each invalidated chunk gets a single job, neighbors are only rebuilt once as well
+		m_updatedChunks.clear();
+		for (auto&& [chunkIndices, neighborMask] : m_invalidatedChunks)
+		{
+			// Inactive chunks will be built when they get activated
+			if (m_chunkEntities.contains(chunkIndices))
+				UpdateChunkEntity(chunkIndices, neighborMask);
+		}
+
+		m_invalidatedChunks.clear();
+	}
+
+	void ChunkEntities::CommitFinishedJobs()
+	{
+		{
+			std::lock_guard lock(m_finishedJobQueue->mutex);
+			m_readyJobs.insert(m_readyJobs.end(), m_finishedJobQueue->chunkIndices.begin(), m_finishedJobQueue->chunkIndices.end());
+			m_finishedJobQueue->chunkIndices.clear();
+		}
+
+		// Jobs are committed once all their tasks are done and the jobs of the chunks they read are committed, committing a job wakes up the jobs waiting on it
+		while (!m_readyJobs.empty())
 		{
+			ChunkIndices chunkIndices = m_readyJobs.back();
+			m_readyJobs.pop_back();
+
+			auto it = m_updateJobs.find(chunkIndices);
+			if (it == m_updateJobs.end())
+				continue; //< already committed or cancelled
+
 			UpdateJob& job = *it->second;
 			if (!job.HasFinished())
-				continue;
+				continue; //< job was replaced, the new one will be pushed when done
 
 			bool canExecute = true;
 			for (auto depIt = job.chunkDependencies.begin(); depIt != job.chunkDependencies.end();)
@@ -86,27 +156,22 @@ namespace tsom
 					continue;
 				}
 
+				depJobIt->second->dependentJobs.push_back(chunkIndices);
 				canExecute = false;
-				++depIt;
+				break;
 			}
 
-			if (canExecute)
-			{
-				job.applyFunc(it->first, std::move(job));
-
-				// Don't remove jobs immediatly to be able to detect dependencies errors
-				m_finishedJobs.push_back(it->first);
-			}
-		}
+			if (!canExecute)
+				continue;
 
-		for (const ChunkIndices& indices : m_finishedJobs)
-			m_updateJobs.erase(indices);
-		m_finishedJobs.clear();
+			std::shared_ptr<UpdateJob> finishedJob = std::move(it.value());
+			m_updateJobs.erase(it);
 
-		for (auto&& [chunkIndices, neighborMask] : m_invalidatedChunks)
-			UpdateChunkEntity(chunkIndices, neighborMask);
+			std::vector<ChunkIndices> dependentJobs = std::move(finishedJob->dependentJobs);
+			finishedJob->applyFunc(chunkIndices, std::move(*finishedJob));
 
-		m_invalidatedChunks.clear();
+			m_readyJobs.insert(m_readyJobs.end(), dependentJobs.begin(), dependentJobs.end());
+		}
 	}
 
 	void ChunkEntities::CreateChunkEntity(const ChunkIndices& chunkIndices, Chunk& chunk)
@@ -143,7 +208,10 @@ namespace tsom
 			UpdateJob& job = *it->second;
 			job.cancelled = true;
 
-			m_updateJobs.erase(chunkIndices);
+			// Don't leave jobs waiting on this one forever
+			m_readyJobs.insert(m_readyJobs.end(), job.dependentJobs.begin(), job.dependentJobs.end());
+
+			m_updateJobs.erase(it);
 		}
 
 		if (auto it = m_chunkEntities.find(chunkIndices); it != m_chunkEntities.end())
@@ -157,6 +225,9 @@ namespace tsom
 
 	void ChunkEntities::FillChunks()
 	{
+		if (m_colliderActivationDistance > 0.f)
+			return;
+
 		m_chunkContainer.ForEachChunk([this](const ChunkIndices& chunkIndices, Chunk& chunk)
 		{
 			CreateChunkEntity(chunkIndices, chunk);
@@ -167,15 +238,7 @@ namespace tsom
 	{
 		assert(chunk.HasContent());
 
-		// Try to cancel current update job to avoid useless work
-		if (auto it = m_updateJobs.find(chunk.GetIndices()); it != m_updateJobs.end())
-		{
-			UpdateJob& job = *it->second;
-			job.cancelled = true;
-		}
-
-		std::shared_ptr<ColliderUpdateJob> updateJob = std::make_shared<ColliderUpdateJob>();
-		updateJob->taskCount = 1;
+		std::shared_ptr<ColliderUpdateJob> updateJob = PrepareUpdateJob<ColliderUpdateJob>(chunk.GetIndices(), 1);
 
 		updateJob->applyFunc = [this](const ChunkIndices& chunkIndices, UpdateJob&& job)
 		{
@@ -187,16 +250,16 @@ namespace tsom
 		};
 
 		auto& taskScheduler = m_application.GetComponent<Nz::TaskSchedulerAppComponent>();
-		taskScheduler.AddTask([this, updateJob, chunkPtr = chunk.shared_from_this()]
+		taskScheduler.AddTask([updateJob, chunkPtr = chunk.shared_from_this(), snapshot = chunk.TakeSnapshot()]
 		{
 			if (updateJob->cancelled)
 				return;
 
-			chunkPtr->LockRead();
-			updateJob->collider = chunkPtr->BuildCollider();
-			chunkPtr->UnlockRead();
+			TickProfiler::Zone zone("Chunk::BuildCollider");
 
-			updateJob->jobDone++;
+			updateJob->collider = chunkPtr->BuildCollider(snapshot);
+
+			updateJob->NotifyTaskDone();
 		});
 
 		// Add neighbor chunks
@@ -209,19 +272,87 @@ namespace tsom
 			if (!neighborChunk || !neighborChunk->HasContent() || !neighborChunk->HasPerFaceCollisions())
 				continue;
 
+			// Inactive chunks have no collider to regenerate
+			if (!m_chunkEntities.contains(neighborIndices))
+				continue;
+
 			updateJob->chunkDependencies.push_back(neighborIndices);
 
-			// Trigger our neighbor update
-			if (!m_updateJobs.contains(neighborIndices))
+			// Trigger our neighbor update (once per update, a pending job may have read the chunk before it changed)
+			if (!IsChunkUpdateScheduled(neighborIndices))
 				ProcessChunkUpdate(*neighborChunk, 0);
 		}
 
 		UpdateJob* updateJobPtr = updateJob.get();
-		m_updateJobs.insert_or_assign(chunk.GetIndices(), std::move(updateJob));
+		RegisterUpdateJob(chunk.GetIndices(), std::move(updateJob));
 
 		return updateJobPtr;
 	}
 
+	void ChunkEntities::UpdateActiveChunks()
+	{
+		m_updateCounter++;
+
+		// Gather positions first as creating chunk entities would invalidate the views
+		auto& registry = m_world.GetRegistry();
+		for (auto&& [entity, node, rigidBody] : registry.view<Nz::NodeComponent, Nz::RigidBody3DComponent>(entt::exclude<Nz::DisabledComponent>).each())
+		{
+			if (!rigidBody.IsDynamic())
+				continue;
+
+			m_bodyPositions.push_back(node.GetGlobalPosition());
+		}
+
+		for (auto&& [entity, node] : registry.view<Nz::NodeComponent, Nz::PhysCharacter3DComponent>(entt::exclude<Nz::DisabledComponent>).each())
+			m_bodyPositions.push_back(node.GetGlobalPosition());
+
+		const Nz::NodeComponent* parentNode = (m_parentEntity) ? &m_parentEntity.get<Nz::NodeComponent>() : nullptr;
+		Nz::Vector3f activationExtent(m_colliderActivationDistance);
+
+		for (const Nz::Vector3f& globalPosition : m_bodyPositions)
+		{
+			Nz::Vector3f position = (parentNode) ? parentNode->ToLocalPosition(globalPosition) : globalPosition;
+
+			ChunkIndices minIndices = m_chunkContainer.GetChunkIndicesByPosition(position - activationExtent);
+			ChunkIndices maxIndices = m_chunkContainer.GetChunkIndicesByPosition(position + activationExtent);
+			for (Nz::Int32 z = minIndices.z; z <= maxIndices.z; ++z)
+			{
+				for (Nz::Int32 y = minIndices.y; y <= maxIndices.y; ++y)
+				{
+					for (Nz::Int32 x = minIndices.x; x <= maxIndices.x; ++x)
+					{
+						ChunkIndices chunkIndices(x, y, z);
+						if (auto it = m_chunkLastUse.find(chunkIndices); it != m_chunkLastUse.end())
+						{
+							it.value() = m_updateCounter;
+							continue;
+						}
+
+						Chunk* chunk = m_chunkContainer.GetChunk(chunkIndices);
+						if (!chunk)
+							continue;
+
+						m_chunkLastUse.emplace(chunkIndices, m_updateCounter);
+						CreateChunkEntity(chunkIndices, *chunk);
+					}
+				}
+			}
+		}
+		m_bodyPositions.clear();
+
+		// Release chunks no body came close to for a while (the delay prevents rebuilding colliders of chunks at the edge of the activation distance)
+		for (auto it = m_chunkLastUse.begin(); it != m_chunkLastUse.end();)
+		{
+			if (m_updateCounter - it->second > ColliderReleaseDelay)
+			{
+				DestroyChunkEntity(it->first);
+				it = m_chunkLastUse.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
 	void ChunkEntities::OnParentNodeInvalidated(const Nz::Node* /*node*/)
 	{
 		// Refresh physical position
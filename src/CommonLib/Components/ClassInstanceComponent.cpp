@@ -4,18 +4,22 @@
 
 #include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <CommonLib/EntityClass.hpp>
+#include <CommonLib/Protocol/CompressedInteger.hpp>
+#include <Nazara/Core/ByteStream.hpp>
 #include <fmt/format.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
 
 namespace tsom
 {
 	ClassInstanceComponent::ClassInstanceComponent(std::shared_ptr<const EntityClass> entityClass) :
-	m_entityClass(std::move(entityClass))
+	m_entityClass(std::move(entityClass)),
+	m_propertyStorage(m_entityClass->GetDefaultPropertyStorage())
 	{
-		std::size_t propertyCount = m_entityClass->GetPropertyCount();
-
-		m_properties.reserve(propertyCount);
-		for (std::size_t i = 0; i < propertyCount; ++i)
-			m_properties.emplace_back(m_entityClass->GetProperty(i).defaultValue);
 	}
 
 	Nz::UInt32 ClassInstanceComponent::FindClientRpcIndex(std::string_view rpcName) const
@@ -37,6 +41,36 @@ namespace tsom
 		return propertyIndex;
 	}
 
+	void ClassInstanceComponent::SerializeProperty(Nz::ByteStream& byteStream, Nz::UInt32 propertyIndex) const
+	{
+		// Same format as EntityProperty serialization, without copying the value first
+		const auto& property = m_entityClass->GetProperty(propertyIndex);
+
+		byteStream << Nz::UInt8(property.type);
+		byteStream << Nz::UInt8((property.isArray) ? 1 : 0);
+
+		auto WriteValues = [&](auto dummyType)
+		{
+			using T = std::decay_t<decltype(dummyType)>;
+
+			auto values = GetPropertyValues<T::Property>(propertyIndex);
+			if (property.isArray)
+				byteStream << CompressedUnsigned<Nz::UInt32>(Nz::SafeCast<Nz::UInt32>(values.size()));
+
+			for (const auto& value : values)
+				byteStream << value;
+		};
+
+		switch (property.type)
+		{
+#define TSOM_ENTITYPROPERTYTYPE(V, T, IT) case EntityPropertyType:: T: return WriteValues(EntityPropertyTag<EntityPropertyType:: T>{});
+
+#include <CommonLib/EntityPropertyList.hpp>
+		}
+
+		NAZARA_UNREACHABLE();
+	}
+
 	void ClassInstanceComponent::TriggerClientRpc(Nz::UInt32 rpcIndex, ServerPlayer* targetPlayer)
 	{
 		OnClientRpc(this, rpcIndex, targetPlayer);
@@ -44,8 +78,176 @@ namespace tsom
 
 	void ClassInstanceComponent::UpdateClass(std::shared_ptr<const EntityClass> entityClass)
 	{
+		// Properties layout depends on the class, keep the values of properties which still exist with the same type
+		EntityClass::PropertyStorage propertyStorage = entityClass->GetDefaultPropertyStorage();
+		for (Nz::UInt32 i = 0; i < m_entityClass->GetPropertyCount(); ++i)
+		{
+			const auto& property = m_entityClass->GetProperty(i);
+
+			Nz::UInt32 newPropertyIndex = entityClass->FindProperty(property.name);
+			if (newPropertyIndex == EntityClass::InvalidIndex)
+				continue;
+
+			const auto& newProperty = entityClass->GetProperty(newPropertyIndex);
+			if (newProperty.type != property.type || newProperty.isArray != property.isArray)
+				continue;
+
+			auto KeepValues = [&](auto dummyType)
+			{
+				using T = std::decay_t<decltype(dummyType)>;
+
+				StorePropertyValues<T::Property>(*entityClass, propertyStorage, newPropertyIndex, GetPropertyValues<T::Property>(i));
+			};
+
+			switch (property.type)
+			{
+#define TSOM_ENTITYPROPERTYTYPE(V, T, IT) case EntityPropertyType:: T: KeepValues(EntityPropertyTag<EntityPropertyType:: T>{}); break;
+
+#include <CommonLib/EntityPropertyList.hpp>
+			}
+		}
+
 		m_entityClass = std::move(entityClass);
+		m_propertyStorage = std::move(propertyStorage);
+	}
+
+	void ClassInstanceComponent::UpdateProperty(Nz::UInt32 propertyIndex, EntityProperty&& value)
+	{
+		const auto& property = m_entityClass->GetProperty(propertyIndex);
+		if (ExtractPropertyType(value) != std::make_pair(property.type, property.isArray))
+			throw std::runtime_error(fmt::format("property {} expects a {}{} value", property.name, ToString(property.type), (property.isArray) ? " array" : ""));
+
+		// Listeners are notified before the value is stored, they can still read the previous one
+		OnPropertyUpdate(this, propertyIndex, value);
+		StoreProperty(propertyIndex, value);
+	}
+
+	void ClassInstanceComponent::StoreProperty(Nz::UInt32 propertyIndex, const EntityProperty& value)
+	{
+		std::visit([&](auto&& propertyValue)
+		{
+			using T = std::decay_t<decltype(propertyValue)>;
+			using TypeExtractor = EntityPropertyTypeExtractor<T>;
+			using UnderlyingType = typename TypeExtractor::UnderlyingType;
+
+			assert(TypeExtractor::Property == m_entityClass->GetProperty(propertyIndex).type);
+
+			std::span<const UnderlyingType> values;
+			if constexpr (TypeExtractor::IsArray)
+				values = std::span<const UnderlyingType>(propertyValue.begin(), propertyValue.size());
+			else
+				values = std::span<const UnderlyingType>(&propertyValue.value, 1);
+
+			StorePropertyValues<TypeExtractor::Property>(*m_entityClass, m_propertyStorage, propertyIndex, values);
+		}, value);
+	}
+
+	void ClassInstanceComponent::CompactArrays(const EntityClass& entityClass, EntityClass::PropertyStorage& propertyStorage)
+	{
+		// Rebuild array storage without the space left by arrays which were moved
+		std::vector<Nz::UInt8> arrayData;
+		std::vector<std::string> arrayStrings;
+
+		for (Nz::UInt32 i = 0; i < entityClass.GetPropertyCount(); ++i)
+		{
+			const auto& property = entityClass.GetProperty(i);
+			if (!property.isArray)
+				continue;
+
+			EntityClass::ArrayRange& arrayRange = propertyStorage.arrays[entityClass.GetPropertyLayout(i).offset];
+
+			auto MoveValues = [&](auto dummyType)
+			{
+				using T = std::decay_t<decltype(dummyType)>;
+				using UnderlyingType = EntityPropertyUnderlyingType_t<T::Property>;
+
+				if constexpr (T::Property == EntityPropertyType::String)
+				{
+					auto first = propertyStorage.arrayStrings.begin() + arrayRange.offset;
+
+					arrayRange.offset = arrayStrings.size();
+					arrayStrings.insert(arrayStrings.end(), std::make_move_iterator(first), std::make_move_iterator(first + arrayRange.size));
+				}
+				else
+				{
+					std::size_t offset = (arrayData.size() + alignof(UnderlyingType) - 1) / alignof(UnderlyingType) * alignof(UnderlyingType);
+					arrayData.resize(offset + arrayRange.size * sizeof(UnderlyingType));
+					if (arrayRange.size > 0)
+						std::memcpy(&arrayData[offset], &propertyStorage.arrayData[arrayRange.offset], arrayRange.size * sizeof(UnderlyingType));
+
+					arrayRange.offset = offset;
+				}
+
+				arrayRange.capacity = arrayRange.size;
+			};
+
+			switch (property.type)
+			{
+#define TSOM_ENTITYPROPERTYTYPE(V, T, IT) case EntityPropertyType:: T: MoveValues(EntityPropertyTag<EntityPropertyType:: T>{}); break;
+
+#include <CommonLib/EntityPropertyList.hpp>
+			}
+		}
+
+		propertyStorage.arrayData = std::move(arrayData);
+		propertyStorage.arrayStrings = std::move(arrayStrings);
+		propertyStorage.unusedArrayDataSize = 0;
+		propertyStorage.unusedArrayStringCount = 0;
+	}
+
+	template<EntityPropertyType Property>
+	void ClassInstanceComponent::StorePropertyValues(const EntityClass& entityClass, EntityClass::PropertyStorage& propertyStorage, Nz::UInt32 propertyIndex, std::span<const EntityPropertyUnderlyingType_t<Property>> values)
+	{
+		using UnderlyingType = EntityPropertyUnderlyingType_t<Property>;
+
+		const EntityClass::PropertyLayout& layout = entityClass.GetPropertyLayout(propertyIndex);
+		if (!entityClass.GetProperty(propertyIndex).isArray)
+		{
+			assert(values.size() == 1);
+			if constexpr (Property == EntityPropertyType::String)
+				propertyStorage.strings[layout.offset] = values.front();
+			else
+				std::memcpy(&propertyStorage.data[layout.offset], &values.front(), sizeof(UnderlyingType));
+
+			return;
+		}
+
+		std::size_t arrayIndex = layout.offset;
+		if (values.size() > propertyStorage.arrays[arrayIndex].capacity)
+		{
+			// Array doesn't fit where it is anymore, move it to the end of the array storage (compacting it first if too much space is unused)
+			EntityClass::ArrayRange& arrayRange = propertyStorage.arrays[arrayIndex];
+			if constexpr (Property == EntityPropertyType::String)
+				propertyStorage.unusedArrayStringCount += arrayRange.capacity;
+			else
+				propertyStorage.unusedArrayDataSize += arrayRange.capacity * sizeof(UnderlyingType);
+
+			arrayRange.capacity = 0;
+			arrayRange.size = 0;
+
+			if (propertyStorage.unusedArrayDataSize > propertyStorage.arrayData.size() / 2 || propertyStorage.unusedArrayStringCount > propertyStorage.arrayStrings.size() / 2)
+				CompactArrays(entityClass, propertyStorage);
+
+			if constexpr (Property == EntityPropertyType::String)
+			{
+				arrayRange.offset = propertyStorage.arrayStrings.size();
+				propertyStorage.arrayStrings.resize(arrayRange.offset + values.size());
+			}
+			else
+			{
+				arrayRange.offset = (propertyStorage.arrayData.size() + alignof(UnderlyingType) - 1) / alignof(UnderlyingType) * alignof(UnderlyingType);
+				propertyStorage.arrayData.resize(arrayRange.offset + values.size() * sizeof(UnderlyingType));
+			}
+
+			arrayRange.capacity = values.size();
+		}
+
+		EntityClass::ArrayRange& arrayRange = propertyStorage.arrays[arrayIndex];
+		arrayRange.size = values.size();
 
-		// TODO: Handle possible properties changes
+		if constexpr (Property == EntityPropertyType::String)
+			std::copy(values.begin(), values.end(), propertyStorage.arrayStrings.begin() + arrayRange.offset);
+		else if (!values.empty())
+			std::memcpy(&propertyStorage.arrayData[arrayRange.offset], values.data(), values.size() * sizeof(UnderlyingType));
 	}
 }
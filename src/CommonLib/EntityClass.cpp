@@ -6,7 +6,9 @@
 #include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <entt/entt.hpp>
 #include <fmt/format.h>
+#include <cstring>
 #include <stdexcept>
+#include <type_traits>
 
 namespace tsom
 {
@@ -14,7 +16,8 @@ namespace tsom
 	m_name(std::move(name)),
 	m_properties(std::move(properties)),
 	m_clientRpcs(std::move(clientRpcs)),
-	m_callbacks(std::move(callbacks))
+	m_callbacks(std::move(callbacks)),
+	m_networkedPropertyCount(0)
 	{
 		for (const auto& clientRpc : m_clientRpcs)
 		{
@@ -30,6 +33,65 @@ namespace tsom
 				throw std::runtime_error(fmt::format("property {} already exists", property.name));
 
 			m_propertyIndices.emplace(property.name, m_propertyIndices.size());
+
+			if (property.isNetworked)
+				m_networkedPropertyCount++;
+		}
+
+		// Compute where each property is stored once, so instances can store all their values in a few blocks copied from the defaults
+		m_propertyLayouts.reserve(m_properties.size());
+		for (const auto& property : m_properties)
+		{
+			std::visit([&](auto&& defaultValue)
+			{
+				using T = std::decay_t<decltype(defaultValue)>;
+				using TypeExtractor = EntityPropertyTypeExtractor<T>;
+				using UnderlyingType = typename TypeExtractor::UnderlyingType;
+
+				if (TypeExtractor::Property != property.type || TypeExtractor::IsArray != property.isArray)
+					throw std::runtime_error(fmt::format("property {} default value doesn't match its type", property.name));
+
+				auto& layout = m_propertyLayouts.emplace_back();
+
+				if constexpr (TypeExtractor::IsArray)
+				{
+					layout.offset = m_defaultPropertyStorage.arrays.size();
+
+					auto& arrayRange = m_defaultPropertyStorage.arrays.emplace_back();
+					arrayRange.capacity = defaultValue.size();
+					arrayRange.size = defaultValue.size();
+
+					if constexpr (TypeExtractor::Property == EntityPropertyType::String)
+					{
+						arrayRange.offset = m_defaultPropertyStorage.arrayStrings.size();
+						m_defaultPropertyStorage.arrayStrings.insert(m_defaultPropertyStorage.arrayStrings.end(), defaultValue.begin(), defaultValue.end());
+					}
+					else
+					{
+						static_assert(std::is_trivially_copyable_v<UnderlyingType>);
+
+						std::vector<Nz::UInt8>& arrayData = m_defaultPropertyStorage.arrayData;
+						arrayRange.offset = (arrayData.size() + alignof(UnderlyingType) - 1) / alignof(UnderlyingType) * alignof(UnderlyingType);
+						arrayData.resize(arrayRange.offset + defaultValue.size() * sizeof(UnderlyingType));
+						if (defaultValue.size() > 0)
+							std::memcpy(&arrayData[arrayRange.offset], defaultValue.begin(), defaultValue.size() * sizeof(UnderlyingType));
+					}
+				}
+				else if constexpr (TypeExtractor::Property == EntityPropertyType::String)
+				{
+					layout.offset = m_defaultPropertyStorage.strings.size();
+					m_defaultPropertyStorage.strings.push_back(defaultValue.value);
+				}
+				else
+				{
+					static_assert(std::is_trivially_copyable_v<UnderlyingType>);
+
+					std::vector<Nz::UInt8>& data = m_defaultPropertyStorage.data;
+					layout.offset = (data.size() + alignof(UnderlyingType) - 1) / alignof(UnderlyingType) * alignof(UnderlyingType);
+					data.resize(layout.offset + sizeof(UnderlyingType));
+					std::memcpy(&data[layout.offset], &defaultValue.value, sizeof(UnderlyingType));
+				}
+			}, property.defaultValue);
 		}
 	}
 
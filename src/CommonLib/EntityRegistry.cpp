@@ -29,11 +29,14 @@ namespace tsom
 			{
 				auto& instance = view.get<ClassInstanceComponent>(entity);
 
-				auto refreshIt = m_refreshMap.find(instance.GetClass().get());
+				auto refreshIt = m_refreshMap.find(instance.GetClass());
 				if (refreshIt == m_refreshMap.end())
 					continue; // class wasn't touched
 
 				instance.UpdateClass(refreshIt->second);
+
+				if (const auto& onClassUpdate = refreshIt->second->GetCallbacks().onClassUpdate)
+					onClassUpdate(entt::handle(*reg, entity));
 			}
 		}
 
@@ -43,7 +46,19 @@ namespace tsom
 	void EntityRegistry::RegisterClass(EntityClass entityClass)
 	{
 		std::string name = entityClass.GetName();
-		m_classes[std::move(name)] = std::make_shared<EntityClass>(std::move(entityClass));
+		std::shared_ptr<EntityClass> newClass = std::make_shared<EntityClass>(std::move(entityClass));
+
+		auto it = m_classes.find(name);
+		if (it != m_classes.end())
+		{
+			// Remember the previous class so existing entities can be switched to the new one
+			if (m_isRefreshing)
+				m_refreshMap[it->second] = newClass;
+
+			it.value() = std::move(newClass);
+		}
+		else
+			m_classes.emplace(std::move(name), std::move(newClass));
 	}
 
 	void EntityRegistry::RegisterClassLibrary(std::unique_ptr<EntityClassLibrary>&& library)
@@ -3,8 +3,21 @@
 // For conditions of distribution and use, see copyright notice in LICENSE
 
 #include <CommonLib/GravityController.hpp>
+#include <cassert>
 
 namespace tsom
 {
 	GravityController::~GravityController() = default;
+
+	void GravityController::ComputeGravityBatch(std::span<const Nz::Vector3f> positions, std::span<GravityForce> forces) const
+	{
+		assert(positions.size() == forces.size());
+		for (std::size_t i = 0; i < positions.size(); ++i)
+			forces[i] = ComputeGravity(positions[i]);
+	}
+
+	bool GravityController::HasUniformGravity() const
+	{
+		return false;
+	}
 }
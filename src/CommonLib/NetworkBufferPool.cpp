@@ -0,0 +1,63 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <CommonLib/NetworkBufferPool.hpp>
+#include <algorithm>
+
+namespace tsom
+{
+	Nz::ByteArray NetworkBufferPool::Acquire(std::size_t sizeHint)
+	{
+		// Smallest class able to hold sizeHint bytes
+		auto it = std::lower_bound(SizeClasses.begin(), SizeClasses.end(), sizeHint);
+		if (it == SizeClasses.end())
+		{
+			// Too big to be pooled
+			Nz::ByteArray buffer;
+			buffer.Reserve(sizeHint);
+
+			return buffer;
+		}
+
+		std::size_t sizeClass = std::distance(SizeClasses.begin(), it);
+
+		// Bigger buffers are fine too
+		Nz::ByteArray buffer;
+		for (std::size_t i = sizeClass; i < SizeClasses.size(); ++i)
+		{
+			if (m_freeBuffers[i].try_dequeue(buffer))
+				return buffer;
+		}
+
+		buffer.Reserve(SizeClasses[sizeClass]);
+		return buffer;
+	}
+
+	void NetworkBufferPool::Release(Nz::ByteArray&& buffer)
+	{
+		// Biggest class this buffer can hold
+		auto it = std::upper_bound(SizeClasses.begin(), SizeClasses.end(), buffer.GetCapacity());
+		if (it == SizeClasses.begin())
+			return;
+
+		std::size_t sizeClass = std::distance(SizeClasses.begin(), it) - 1;
+
+		auto& freeBuffers = m_freeBuffers[sizeClass];
+		if (freeBuffers.size_approx() >= m_maxBufferPerClass)
+			return;
+
+		buffer.Clear(true);
+		freeBuffers.enqueue(std::move(buffer));
+	}
+
+	void NetworkBufferPool::UpdateSizeHint(Nz::UInt8 bufferType, std::size_t size)
+	{
+		// Decaying maximum: a single big buffer doesn't make every following one big, but a regular mix of sizes stays on the big side
+		// (concurrent updates may lose one, which is fine for a hint)
+		std::atomic<std::size_t>& sizeHint = m_sizeHints[bufferType];
+
+		std::size_t currentHint = sizeHint.load(std::memory_order_relaxed);
+		sizeHint.store(std::max(size, currentHint - currentHint / SizeHintDecay), std::memory_order_relaxed);
+	}
+}
@@ -34,28 +34,18 @@ namespace tsom
 		m_thread.join();
 	}
 
-	std::size_t NetworkReactor::ConnectTo(Nz::IpAddress address, Nz::UInt32 data)
+	void NetworkReactor::ConnectTo(Nz::IpAddress address, Nz::UInt32 data, ConnectionCallback callback)
 	{
+		assert(callback);
+
+		// The peer is created by the reactor thread, the callback will be called from Poll once it's done
+		// (before any connection or disconnection event regarding this peer)
 		ConnectionRequest request;
+		request.callback = std::move(callback);
 		request.data = data;
 		request.remoteAddress = std::move(address);
 
-		// We will need a few synchronization primitives to block the calling thread until the reactor has treated our request
-		std::size_t newClientId = InvalidPeerId;
-		// As InvalidClientId is a possible return from the callback, we need another variable to prevent spurious wakeup
-		std::atomic_bool hasReturned = false;
-		request.callback = [&](std::size_t peerId)
-		{
-			// This callback is called from within the reactor
-			newClientId = m_idOffset + peerId;
-			hasReturned = true;
-			hasReturned.notify_all();
-		};
-		m_connectionRequests.enqueue(request);
-
-		hasReturned.wait(false);
-
-		return newClientId;
+		m_connectionRequests.enqueue(std::move(request));
 	}
 
 	void NetworkReactor::DisconnectPeer(std::size_t peerId, Nz::UInt32 data, DisconnectionType type)
@@ -115,12 +105,14 @@ namespace tsom
 		{
 			ReceivePackets(incomingToken);
 			SendPackets(incomingToken, outgoingToken);
+			RecycleBuffers();
 
 			// Handle connection requests last to treat disconnection request before connection requests
-			HandleConnectionRequests(connectionToken);
+			HandleConnectionRequests(incomingToken, connectionToken);
 		}
 
 		EnsureProperDisconnection(incomingToken, outgoingToken);
+		m_inFlightPackets.clear();
 	}
 
 	void NetworkReactor::EnsureProperDisconnection(const moodycamel::ProducerToken& producterToken, moodycamel::ConsumerToken& token)
@@ -181,20 +173,26 @@ namespace tsom
 		}
 	}
 
-	void NetworkReactor::HandleConnectionRequests(moodycamel::ConsumerToken& token)
-{
+	void NetworkReactor::HandleConnectionRequests(const moodycamel::ProducerToken& producterToken, moodycamel::ConsumerToken& token)
+	{
 		ConnectionRequest request;
 		while (m_connectionRequests.try_dequeue(token, request))
 		{
+			IncomingEvent newEvent;
+
 			if (Nz::ENetPeer* peer = m_host.Connect(request.remoteAddress, Constants::NetworkChannelCount, request.data))
 			{
 				Nz::UInt16 peerId = peer->GetPeerId();
 				m_clients[peerId] = peer;
 
-				request.callback(peerId);
+				newEvent.peerId = m_idOffset + peerId;
 			}
-			else
-				request.callback(InvalidPeerId);
+
+			auto& connectionResponse = newEvent.data.emplace<IncomingEvent::ConnectionResponse>();
+			connectionResponse.callback = std::move(request.callback);
+
+			// Use the same producer token as other events to ensure the response is received before the connection events
+			m_incomingQueue.enqueue(producterToken, std::move(newEvent));
 		}
 	}
 
@@ -267,6 +265,30 @@ namespace tsom
 		}
 	}
 
+	void NetworkReactor::RecycleBuffers()
+	{
+		// Sweeping is O(in-flight packets), don't do it on every loop iteration
+		if (!m_recycleClock.RestartIfOver(RecycleInterval))
+			return;
+
+		// ENet releases its references once a packet has been sent (or acknowledged if reliable),
+		// when we're the last owner the payload buffer can go back to the pool
+		for (std::size_t i = 0; i < m_inFlightPackets.size();)
+		{
+			Nz::ENetPacketRef& packet = m_inFlightPackets[i];
+			if (packet->referenceCount > 1)
+			{
+				++i;
+				continue;
+			}
+
+			m_bufferPool.Release(std::move(packet->data));
+
+			std::swap(packet, m_inFlightPackets.back());
+			m_inFlightPackets.pop_back();
+		}
+	}
+
 	void NetworkReactor::SendPackets(const moodycamel::ProducerToken& producterToken, moodycamel::ConsumerToken& token)
 	{
 		OutgoingEvent outEvent;
@@ -316,12 +338,16 @@ namespace tsom
 				{
 					if (Nz::ENetPeer* peer = m_clients[outEvent.peerId])
 					{
+						// Payload is moved to the ENet packet (no copy), we keep a reference to recycle it afterwards
 						Nz::ENetPacketRef packet = m_host.AllocatePacket(arg.flags, std::move(arg.data));
 						if (arg.acknowledgeCallback)
 							packet->OnAcknowledged.Connect(std::move(arg.acknowledgeCallback));
 
-						peer->Send(arg.channelId, std::move(packet));
+						peer->Send(arg.channelId, packet);
+						m_inFlightPackets.push_back(std::move(packet));
 					}
+					else
+						m_bufferPool.Release(std::move(arg.data));
 				}
 				else if constexpr (std::is_same_v<T, OutgoingEvent::QueryPeerInfo>)
 				{
@@ -5,6 +5,7 @@
 #include <CommonLib/NetworkSession.hpp>
 #include <CommonLib/NetworkSessionManager.hpp>
 #include <CommonLib/SessionHandler.hpp>
+#include <Nazara/Core/ByteArray.hpp>
 
 namespace tsom
 {
@@ -28,6 +29,13 @@ namespace tsom
 
 	void NetworkSession::HandlePacket(Nz::ByteArray&& byteArray)
 	{
+		// Unknown opcodes are reported by the session handler
+		if (!byteArray.IsEmpty() && byteArray[0] < PacketCount)
+		{
+			m_statistics.RecordIncoming(byteArray[0], byteArray.GetSize());
+			m_reactor.GetStatistics().RecordIncoming(byteArray[0], byteArray.GetSize());
+		}
+
 		if NAZARA_LIKELY(m_sessionHandler)
 			m_sessionHandler->HandlePacket(std::move(byteArray));
 	}
@@ -4,13 +4,42 @@
 
 #include <CommonLib/NetworkSessionManager.hpp>
 #include <CommonLib/SessionHandler.hpp>
+#include <NazaraUtils/Algorithm.hpp>
 #include <NazaraUtils/Hash.hpp>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
 
 namespace tsom
 {
+	NetworkSessionManager::NetworkSessionManager(Nz::UInt16 port, Nz::NetProtocol protocol, std::size_t maxSessions, std::size_t reactorCount) :
+	m_handlerFactory(nullptr),
+	m_redirectPeers(port > 0 && reactorCount > 1)
+	{
+		assert(reactorCount > 0);
+
+		// Each reactor listens on its own port (port, port + 1, ...) and handles a part of the sessions
+		// Peers connect to the first one, which redirects them to the least loaded reactor (see Poll)
+		m_maxSessionPerReactor = (maxSessions + reactorCount - 1) / reactorCount;
+		if (m_maxSessionPerReactor > MaxSessionPerReactor)
+			throw std::runtime_error(fmt::format("too many sessions per reactor ({0} > {1}), increase the reactor count", m_maxSessionPerReactor, MaxSessionPerReactor));
+
+		if (port > 0 && port + reactorCount - 1 > 0xFFFF)
+			throw std::runtime_error("not enough ports for all reactors");
+
+		m_sessions.resize(m_maxSessionPerReactor * reactorCount);
+		m_reactorSessionCounts.resize(reactorCount, 0);
+
+		m_reactors.reserve(reactorCount);
+		for (std::size_t i = 0; i < reactorCount; ++i)
+		{
+			Nz::UInt16 reactorPort = (port > 0) ? Nz::SafeCast<Nz::UInt16>(port + i) : 0;
+			m_reactors.push_back(std::make_unique<NetworkReactor>(i * m_maxSessionPerReactor, protocol, reactorPort, m_maxSessionPerReactor));
+		}
+	}
+
 	void NetworkSessionManager::Poll()
 	{
 		auto ConnectionHandler = [&]([[maybe_unused]] bool outgoingConnection, std::size_t peerIndex, const Nz::IpAddress& remoteAddress, [[maybe_unused]] Nz::UInt32 data)
@@ -21,27 +50,84 @@ namespace tsom
 
 			std::string addressStr = remoteAddress.ToString(false);
 
+			std::size_t reactorIndex = peerIndex / m_maxSessionPerReactor;
+			if (m_redirectPeers && reactorIndex == 0)
+			{
+				// Redirected peers get no session, their packets are ignored until they're disconnected
+				std::size_t targetReactorIndex = PickReactor(m_reactorSessionCounts);
+				if (targetReactorIndex != 0)
+				{
+					fmt::print("Peer redirected to reactor {} (peerIndex: {}, hashed address: {:x})\n", targetReactorIndex, peerIndex, Nz::FNV1a64(addressStr));
+					m_reactors[0]->DisconnectPeer(peerIndex, BuildRedirectData(Nz::SafeCast<Nz::UInt16>(targetReactorIndex)));
+					return;
+				}
+			}
+
+			m_reactorSessionCounts[reactorIndex]++;
+
 			fmt::print("Peer connected (peerIndex: {}, hashed address: {:x})\n", peerIndex, Nz::FNV1a64(addressStr));
-			m_sessions[peerIndex].emplace(m_reactor, peerIndex, remoteAddress);
+			m_sessions[peerIndex].emplace(GetPeerReactor(peerIndex), peerIndex, remoteAddress);
 			m_sessions[peerIndex]->SetHandler(m_handlerFactory(&m_sessions[peerIndex].value()));
 		};
 
 		auto DisconnectionHandler = [&](std::size_t peerIndex, [[maybe_unused]] Nz::UInt32 data, bool timeout)
 		{
-			assert(m_sessions[peerIndex].has_value());
+			if (!m_sessions[peerIndex].has_value())
+			{
+				assert(m_redirectPeers);
+				return;
+			}
+
 			assert(data == 0);
 
 			fmt::print("Peer {} (peerIndex: {})\n", (timeout) ? "timeout" : "disconnected", peerIndex);
 			m_sessions[peerIndex].reset();
+
+			m_reactorSessionCounts[peerIndex / m_maxSessionPerReactor]--;
 		};
 
 		auto PacketHandler = [&](std::size_t peerIndex, Nz::ByteArray&& packet)
 		{
-			assert(m_sessions[peerIndex].has_value());
+			if NAZARA_UNLIKELY(!m_sessions[peerIndex].has_value())
+			{
+				assert(m_redirectPeers);
+				return;
+			}
 
 			m_sessions[peerIndex]->HandlePacket(std::move(packet));
 		};
 
-		m_reactor.Poll(ConnectionHandler, DisconnectionHandler, PacketHandler);
+		// Peer ids are global to the manager so every reactor queue can be polled the same way
+		for (auto& reactorPtr : m_reactors)
+			reactorPtr->Poll(ConnectionHandler, DisconnectionHandler, PacketHandler);
+	}
+
+	std::size_t NetworkSessionManager::PickReactor(std::span<const std::size_t> reactorSessionCounts)
+	{
+		// Least loaded reactor, the first one on ties so peers don't need to be redirected while the server is quiet
+		assert(!reactorSessionCounts.empty());
+		return static_cast<std::size_t>(std::distance(reactorSessionCounts.begin(), std::min_element(reactorSessionCounts.begin(), reactorSessionCounts.end())));
+	}
+
+	void NetworkSessionManager::ResetStatistics()
+	{
+		for (auto&& reactorPtr : m_reactors)
+			reactorPtr->GetStatistics().Reset();
+
+		for (std::optional<NetworkSession>& session : m_sessions)
+		{
+			if (session)
+				session->GetStatistics().Reset();
+		}
+	}
+
+	NetworkStatistics::Snapshot NetworkSessionManager::TakeStatisticsSnapshot() const
+	{
+		// Reactors count packets of all their sessions, including the disconnected ones
+		NetworkStatistics::Snapshot snapshot;
+		for (auto&& reactorPtr : m_reactors)
+			snapshot.Merge(reactorPtr->GetStatistics().TakeSnapshot());
+
+		return snapshot;
 	}
 }
@@ -0,0 +1,156 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <CommonLib/NetworkStatistics.hpp>
+#include <CommonLib/Utils.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <numeric>
+
+namespace tsom
+{
+	NetworkStatistics::NetworkStatistics() = default;
+
+	void NetworkStatistics::Reset()
+	{
+		for (auto* counterArray : { &m_incoming, &m_outgoing })
+		{
+			for (Counters& counters : *counterArray)
+			{
+				counters.byteCount.store(0, std::memory_order_relaxed);
+				counters.packetCount.store(0, std::memory_order_relaxed);
+				counters.rawByteCount.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		m_clock.Restart();
+	}
+
+	auto NetworkStatistics::TakeSnapshot() const -> Snapshot
+	{
+		auto CopyCounters = [](const std::array<Counters, PacketCount>& counterArray, std::array<PacketStats, PacketCount>& statsArray)
+		{
+			for (std::size_t i = 0; i < PacketCount; ++i)
+			{
+				const Counters& counters = counterArray[i];
+				PacketStats& stats = statsArray[i];
+				stats.byteCount = counters.byteCount.load(std::memory_order_relaxed);
+				stats.packetCount = counters.packetCount.load(std::memory_order_relaxed);
+				stats.rawByteCount = counters.rawByteCount.load(std::memory_order_relaxed);
+				stats.channel = counters.channel.load(std::memory_order_relaxed);
+			}
+		};
+
+		Snapshot snapshot;
+		CopyCounters(m_incoming, snapshot.incoming);
+		CopyCounters(m_outgoing, snapshot.outgoing);
+		snapshot.elapsedTime = m_clock.GetElapsedTime();
+
+		return snapshot;
+	}
+
+	std::string NetworkStatistics::Snapshot::BuildReport(std::size_t maxPacketTypes) const
+	{
+		double elapsedSeconds = std::max(elapsedTime.AsSeconds<double>(), 1.0);
+
+		std::string report;
+		auto AppendDirection = [&](std::string_view direction, const std::array<PacketStats, PacketCount>& statsArray)
+		{
+			Nz::UInt64 totalBytes = 0;
+			Nz::UInt64 totalPackets = 0;
+			for (const PacketStats& stats : statsArray)
+			{
+				totalBytes += stats.byteCount;
+				totalPackets += stats.packetCount;
+			}
+
+			report += fmt::format("{}: {} packets ({:.1f}/s), {} ({})\n", direction, totalPackets, totalPackets / elapsedSeconds, ByteToString(totalBytes), ByteToString(static_cast<Nz::UInt64>(totalBytes / elapsedSeconds), true));
+
+			// Biggest consumers first
+			std::array<std::size_t, PacketCount> packetOrder;
+			std::iota(packetOrder.begin(), packetOrder.end(), 0);
+			std::sort(packetOrder.begin(), packetOrder.end(), [&](std::size_t lhs, std::size_t rhs)
+			{
+				return statsArray[lhs].byteCount > statsArray[rhs].byteCount;
+			});
+
+			for (std::size_t i = 0; i < std::min(maxPacketTypes, PacketCount); ++i)
+			{
+				const PacketStats& stats = statsArray[packetOrder[i]];
+				if (stats.packetCount == 0)
+					break;
+
+				report += fmt::format("- {}: {} packets ({:.1f}/s), {} ({})", PacketNames[packetOrder[i]], stats.packetCount, stats.packetCount / elapsedSeconds, ByteToString(stats.byteCount), ByteToString(static_cast<Nz::UInt64>(stats.byteCount / elapsedSeconds), true));
+				if (stats.rawByteCount != stats.byteCount)
+					report += fmt::format(", {} uncompressed", ByteToString(stats.rawByteCount));
+
+				if (stats.channel != 0xFF)
+					report += fmt::format(", channel {}", +stats.channel);
+
+				report += '\n';
+			}
+		};
+
+		AppendDirection("outgoing", outgoing);
+		AppendDirection("incoming", incoming);
+
+		return report;
+	}
+
+	void NetworkStatistics::Snapshot::Merge(const Snapshot& snapshot)
+	{
+		auto MergeStats = [](std::array<PacketStats, PacketCount>& statsArray, const std::array<PacketStats, PacketCount>& otherArray)
+		{
+			for (std::size_t i = 0; i < PacketCount; ++i)
+			{
+				PacketStats& stats = statsArray[i];
+				const PacketStats& otherStats = otherArray[i];
+				stats.byteCount += otherStats.byteCount;
+				stats.packetCount += otherStats.packetCount;
+				stats.rawByteCount += otherStats.rawByteCount;
+				if (otherStats.channel != 0xFF)
+					stats.channel = otherStats.channel;
+			}
+		};
+
+		MergeStats(incoming, snapshot.incoming);
+		MergeStats(outgoing, snapshot.outgoing);
+		elapsedTime = std::max(elapsedTime, snapshot.elapsedTime);
+	}
+
+	nlohmann::json NetworkStatistics::Snapshot::ToJson() const
+	{
+		double elapsedSeconds = std::max(elapsedTime.AsSeconds<double>(), 1.0);
+
+		auto StatsToJson = [&](const std::array<PacketStats, PacketCount>& statsArray)
+		{
+			nlohmann::json packets = nlohmann::json::object();
+			for (std::size_t i = 0; i < PacketCount; ++i)
+			{
+				const PacketStats& stats = statsArray[i];
+				if (stats.packetCount == 0)
+					continue;
+
+				nlohmann::json& packet = packets[std::string(PacketNames[i])];
+				packet["bytes"] = stats.byteCount;
+				packet["bytesPerSecond"] = stats.byteCount / elapsedSeconds;
+				packet["count"] = stats.packetCount;
+				packet["countPerSecond"] = stats.packetCount / elapsedSeconds;
+				packet["uncompressedBytes"] = stats.rawByteCount;
+				if (stats.channel != 0xFF)
+					packet["channel"] = stats.channel;
+			}
+
+			return packets;
+		};
+
+		nlohmann::json doc;
+		doc["elapsedSeconds"] = elapsedTime.AsSeconds<double>();
+		doc["incoming"] = StatsToJson(incoming);
+		doc["outgoing"] = StatsToJson(outgoing);
+
+		return doc;
+	}
+}
@@ -6,13 +6,26 @@
 #include <CommonLib/BlockLibrary.hpp>
 #include <CommonLib/DeformedChunk.hpp>
 #include <CommonLib/FlatChunk.hpp>
+#include <CommonLib/TickProfiler.hpp>
 #include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Math/Box.hpp>
-#include <NazaraUtils/CallOnExit.hpp>
 #include <PerlinNoise.hpp>
+#include <algorithm>
+#include <array>
 
 namespace tsom
 {
+	namespace
+	{
+		constexpr std::size_t GravityBatchSize = 64;
+
+		constexpr float PlanetGravityCenterStartDecrease = 16.f;
+		constexpr float PlanetGravityCenterNoGravity = 4.f;
+		constexpr float PlanetGravitySpaceStart = 100.f;
+		constexpr float PlanetGravitySpaceFinish = 150.f;
+		constexpr float PlanetGravitySpaceNone = 250.f;
+	}
+
 	Planet::Planet(float tileSize, float cornerRadius, float gravity) :
 	ChunkContainer(tileSize),
 	m_cornerRadius(cornerRadius),
@@ -88,62 +101,36 @@ namespace tsom
 
 	auto Planet::ComputeGravity(const Nz::Vector3f& position) const -> GravityForce
 	{
-		constexpr float PlanetGravityCenterStartDecrease = 16.f;
-		constexpr float PlanetGravityCenterNoGravity = 4.f;
-		constexpr float PlanetGravitySpaceStart = 100.f;
-		constexpr float PlanetGravitySpaceFinish = 150.f;
-		constexpr float PlanetGravitySpaceNone = 250.f;
-
-		// Decrease gravity near the center
 		float distSq = position.SquaredDistance(GetCenter());
-		if (distSq < Nz::IntegralPow(PlanetGravityCenterStartDecrease, 2))
-		{
-			Nz::Vector3f up = ComputeUpDirection(position);
-			return GravityForce{
-				.direction = -up,
-				.acceleration = m_gravity,
-				.factor = std::max(std::sqrt(distSq) - PlanetGravityCenterNoGravity, 0.f) / (PlanetGravityCenterStartDecrease - PlanetGravityCenterNoGravity)
-			};
-		}
+		if (distSq > Nz::IntegralPow(PlanetGravitySpaceNone, 2))
+			return GravityForce::Zero();
 
-		// Turn rounded gravity to newtonian gravity
-		if (distSq > Nz::IntegralPow(PlanetGravitySpaceStart, 2))
-		{
-			if (distSq > Nz::IntegralPow(PlanetGravitySpaceNone, 2))
-				return GravityForce::Zero();
+		return BuildGravityForce(position, distSq, ComputeUpDirection(position));
+	}
 
-			float dist = std::sqrt(distSq);
-			float newtonianInterp;
-			if (distSq > Nz::IntegralPow(PlanetGravitySpaceFinish, 2))
-				newtonianInterp = 1.f;
-			else
-				newtonianInterp = std::max(dist - PlanetGravitySpaceStart, 0.f) / (PlanetGravitySpaceFinish - PlanetGravitySpaceStart);
+	void Planet::ComputeGravityBatch(std::span<const Nz::Vector3f> positions, std::span<GravityForce> forces) const
+	{
+		assert(positions.size() == forces.size());
 
-			Nz::Vector3f direction = Nz::Vector3f::Normalize(GetCenter() - position);
-			if (newtonianInterp < 0.99f)
-				direction = Nz::Lerp(-ComputeUpDirection(position), direction, newtonianInterp);
-			else
-				direction = GetCenter() - position;
+		std::array<Nz::Vector3f, GravityBatchSize> upDirections;
 
-			direction.Normalize();
+		Nz::Vector3f center = GetCenter();
+		for (std::size_t offset = 0; offset < positions.size(); offset += GravityBatchSize)
+		{
+			std::size_t count = std::min(GravityBatchSize, positions.size() - offset);
+			ComputeUpDirectionBatch(positions.subspan(offset, count), std::span(upDirections.data(), count));
 
-			float gravity = std::max(dist - PlanetGravitySpaceFinish, 0.f) / (PlanetGravitySpaceNone - PlanetGravitySpaceFinish);
-			gravity *= gravity;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const Nz::Vector3f& position = positions[offset + i];
 
-			return GravityForce{
-				.direction = direction,
-				.acceleration = m_gravity,
-				.factor = 1.f - gravity
-			};
+				float distSq = position.SquaredDistance(center);
+				if (distSq > Nz::IntegralPow(PlanetGravitySpaceNone, 2))
+					forces[offset + i] = GravityForce::Zero();
+				else
+					forces[offset + i] = BuildGravityForce(position, distSq, upDirections[i]);
+			}
 		}
-
-		// Regular gravity
-		Nz::Vector3f up = ComputeUpDirection(position);
-		return GravityForce{
-			.direction = -up,
-			.acceleration = m_gravity,
-			.factor = 1.f
-		};
 	}
 
 	Nz::Vector3f Planet::ComputeUpDirection(const Nz::Vector3f& position) const
@@ -164,6 +151,49 @@ namespace tsom
 		return Nz::Vector3f::Normalize(position - innerPos);
 	}
 
+	void Planet::ComputeUpDirectionBatch(std::span<const Nz::Vector3f> positions, std::span<Nz::Vector3f> upDirections) const
+	{
+		assert(positions.size() == upDirections.size());
+
+		// Same computation as ComputeUpDirection, but split in plain float arrays without branches so compilers can vectorize it
+		std::array<float, GravityBatchSize> x, y, z;
+
+		Nz::Vector3f center = GetCenter();
+		float cornerRadius = std::max(m_cornerRadius, 1.f);
+
+		for (std::size_t offset = 0; offset < positions.size(); offset += GravityBatchSize)
+		{
+			std::size_t count = std::min(GravityBatchSize, positions.size() - offset);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				x[i] = positions[offset + i].x - center.x;
+				y[i] = positions[offset + i].y - center.y;
+				z[i] = positions[offset + i].z - center.z;
+			}
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				float distToCenter = std::max(std::max(std::abs(x[i]), std::abs(y[i])), std::abs(z[i]));
+				float innerReductionSize = std::max(distToCenter - cornerRadius, 0.f);
+
+				// Offset from the inner box (which is centered on the planet)
+				x[i] -= std::clamp(x[i], -innerReductionSize, innerReductionSize);
+				y[i] -= std::clamp(y[i], -innerReductionSize, innerReductionSize);
+				z[i] -= std::clamp(z[i], -innerReductionSize, innerReductionSize);
+
+				// A position on the center gives a null direction (as Vector3f::Normalize does) instead of NaNs
+				float lengthSq = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+				float invLength = (lengthSq > 0.f) ? 1.f / std::sqrt(lengthSq) : 0.f;
+				x[i] *= invLength;
+				y[i] *= invLength;
+				z[i] *= invLength;
+			}
+
+			for (std::size_t i = 0; i < count; ++i)
+				upDirections[offset + i] = Nz::Vector3f(x[i], y[i], z[i]);
+		}
+	}
+
 	void Planet::ForEachChunk(Nz::FunctionRef<void(const ChunkIndices& chunkIndices, Chunk& chunk)> callback)
 	{
 		for (auto&& [chunkIndices, chunkData] : m_chunks)
@@ -199,9 +229,6 @@ namespace tsom
 		for (auto&& [dir, noise] : perlin.iter_kv())
 			noise.reseed(seed + static_cast<unsigned int>(dir));
 
-		chunk.LockWrite();
-		NAZARA_DEFER({ chunk.UnlockWrite(); });
-
 		chunk.Reset([&](BlockIndex* blockIndices)
 		{
 			// Fill all blocks based on their depth
@@ -412,6 +439,7 @@ namespace tsom
 					auto& chunk = AddChunk(blockLibrary, { chunkX - int(chunkCount.x / 2), chunkY - int(chunkCount.y / 2), chunkZ - int(chunkCount.z / 2) });
 					taskScheduler.AddTask([&]
 					{
+						TickProfiler::Zone zone("Planet::GenerateChunk");
 						GenerateChunk(blockLibrary, chunk, seed, chunkCount);
 					});
 				}
@@ -530,6 +558,54 @@ namespace tsom
 		}
 	}
 
+	auto Planet::BuildGravityForce(const Nz::Vector3f& position, float distSq, const Nz::Vector3f& up) const -> GravityForce
+	{
+		// Decrease gravity near the center
+		if (distSq < Nz::IntegralPow(PlanetGravityCenterStartDecrease, 2))
+		{
+			return GravityForce{
+				.direction = -up,
+				.acceleration = m_gravity,
+				.factor = std::max(std::sqrt(distSq) - PlanetGravityCenterNoGravity, 0.f) / (PlanetGravityCenterStartDecrease - PlanetGravityCenterNoGravity)
+			};
+		}
+
+		// Turn rounded gravity to newtonian gravity
+		if (distSq > Nz::IntegralPow(PlanetGravitySpaceStart, 2))
+		{
+			float dist = std::sqrt(distSq);
+			float newtonianInterp;
+			if (distSq > Nz::IntegralPow(PlanetGravitySpaceFinish, 2))
+				newtonianInterp = 1.f;
+			else
+				newtonianInterp = std::max(dist - PlanetGravitySpaceStart, 0.f) / (PlanetGravitySpaceFinish - PlanetGravitySpaceStart);
+
+			Nz::Vector3f direction = Nz::Vector3f::Normalize(GetCenter() - position);
+			if (newtonianInterp < 0.99f)
+				direction = Nz::Lerp(-up, direction, newtonianInterp);
+			else
+				direction = GetCenter() - position;
+
+			direction.Normalize();
+
+			float gravity = std::max(dist - PlanetGravitySpaceFinish, 0.f) / (PlanetGravitySpaceNone - PlanetGravitySpaceFinish);
+			gravity *= gravity;
+
+			return GravityForce{
+				.direction = direction,
+				.acceleration = m_gravity,
+				.factor = 1.f - gravity
+			};
+		}
+
+		// Regular gravity
+		return GravityForce{
+			.direction = -up,
+			.acceleration = m_gravity,
+			.factor = 1.f
+		};
+	}
+
 	void Planet::RemoveChunk(const ChunkIndices& indices)
 	{
 		auto it = m_chunks.find(indices);
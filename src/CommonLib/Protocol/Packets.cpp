@@ -3,11 +3,15 @@
 // For conditions of distribution and use, see copyright notice in LICENSE
 
 #include <CommonLib/Protocol/Packets.hpp>
+#include <CommonLib/EntityClass.hpp>
 #include <CommonLib/Version.hpp>
+#include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <CommonLib/Utility/BinaryCompressor.hpp>
+#include <CommonLib/Utility/CompressionDictionary.hpp>
 #include <NazaraUtils/TypeTraits.hpp>
 #include <lz4.h>
 #include <fmt/format.h>
+#include <cassert>
 
 namespace tsom
 {
@@ -184,10 +188,34 @@ namespace tsom
 			serializer.SerializeArraySize(data.content);
 			std::size_t bufferSize = data.content.size() * sizeof(BlockIndex);
 
+			const CompressionDictionary* dictionary = nullptr;
+			if (serializer.GetProtocolVersion() >= BuildVersion(0, 7, 0))
+			{
+				// 0 means the content was compressed without dictionary
+				CompressedUnsigned<Nz::UInt32> dictionaryId;
+				if (serializer.IsWriting())
+				{
+					dictionary = CompressionDictionary::Get(CompressionDictionaryType::ChunkContent);
+					dictionaryId = (dictionary) ? dictionary->GetId() : 0;
+				}
+
+				serializer &= dictionaryId;
+
+				if (!serializer.IsWriting() && dictionaryId != 0)
+				{
+					dictionary = CompressionDictionary::Get(CompressionDictionaryType::ChunkContent);
+					if (!dictionary || dictionary->GetId() != dictionaryId)
+						throw std::runtime_error(fmt::format("chunk content was compressed using dictionary #{0} which is not available", Nz::UInt32(dictionaryId)));
+				}
+			}
+
 			BinaryCompressor& binaryCompressor = serializer.GetBinaryCompressor();
 			if (serializer.IsWriting())
 			{
-				std::optional compressedData = binaryCompressor.Compress(data.content.data(), bufferSize);
+				CompressionSettings compressionSettings;
+				compressionSettings.dictionary = dictionary;
+
+				std::optional compressedData = binaryCompressor.Compress(data.content.data(), bufferSize, compressionSettings);
 				if (!compressedData)
 					throw std::runtime_error("failed to compress chunk");
 
@@ -197,6 +225,7 @@ namespace tsom
 				serializer &= compressedSize;
 
 				serializer.Write(buffer.data(), buffer.size());
+				serializer.RegisterCompression(bufferSize, buffer.size());
 			}
 			else
 			{
@@ -206,7 +235,7 @@ namespace tsom
 				Nz::Stream* stream = serializer.GetByteStream().GetStream();
 				const char* srcData = static_cast<const char*>(stream->GetMappedPointer()) + stream->GetCursorPos();
 
-				std::optional<std::size_t> decompressedSize = binaryCompressor.Decompress(srcData, compressedSize, data.content.data(), bufferSize);
+				std::optional<std::size_t> decompressedSize = binaryCompressor.Decompress(srcData, compressedSize, data.content.data(), bufferSize, dictionary);
 				if (!decompressedSize)
 					throw std::runtime_error("failed to decompress chunk");
 
@@ -258,9 +287,23 @@ namespace tsom
 				if (entity.playerControlled)
 					Helper::Serialize(serializer, *entity.playerControlled);
 
-				serializer.SerializeArraySize(entity.properties);
-				for (auto& property : entity.properties)
-					serializer &= property;
+				if (serializer.IsWriting() && entity.propertySource)
+				{
+					const EntityClass& entityClass = *entity.propertySource->GetClass();
+					serializer &= CompressedUnsigned<Nz::UInt32>(entityClass.GetNetworkedPropertyCount());
+
+					for (Nz::UInt32 i = 0; i < entityClass.GetPropertyCount(); ++i)
+					{
+						if (entityClass.GetProperty(i).isNetworked)
+							entity.propertySource->SerializeProperty(serializer.GetByteStream(), i);
+					}
+				}
+				else
+				{
+					serializer.SerializeArraySize(entity.properties);
+					for (auto& property : entity.properties)
+						serializer &= property;
+				}
 			}
 		}
 
@@ -273,6 +316,28 @@ namespace tsom
 				serializer &= entityId;
 		}
 
+		void Serialize(PacketSerializer& serializer, EntitiesPropertyUpdate& data)
+		{
+			serializer &= data.tickIndex;
+
+			serializer.SerializeArraySize(data.entities);
+			for (auto& entity : data.entities)
+			{
+				serializer &= entity.entityId;
+
+				serializer.SerializeArraySize(entity.properties);
+				for (auto& property : entity.properties)
+				{
+					serializer &= property.propertyIndex;
+
+					if (serializer.IsWriting() && entity.propertySource)
+						entity.propertySource->SerializeProperty(serializer.GetByteStream(), property.propertyIndex);
+					else
+						serializer &= property.propertyValue;
+				}
+			}
+		}
+
 		void Serialize(PacketSerializer& serializer, EntitiesStateUpdate& data)
 		{
 			serializer &= data.tickIndex;
@@ -315,7 +380,11 @@ namespace tsom
 			serializer &= data.tickIndex;
 			serializer &= data.entity;
 			serializer &= data.propertyIndex;
-			serializer &= data.propertyValue;
+
+			if (serializer.IsWriting() && data.propertySource)
+				data.propertySource->SerializeProperty(serializer.GetByteStream(), data.propertyIndex);
+			else
+				serializer &= data.propertyValue;
 		}
 
 		void Serialize(PacketSerializer& serializer, EnvironmentCreate& data)
@@ -355,6 +424,12 @@ namespace tsom
 			}
 		}
 
+		void Serialize(PacketSerializer& serializer, InputAck& data)
+		{
+			serializer &= data.tickIndex;
+			serializer &= data.lastInputIndex;
+		}
+
 		void Serialize(PacketSerializer& serializer, Interact& data)
 		{
 			serializer &= data.entityId;
@@ -384,14 +459,40 @@ namespace tsom
 
 		void Serialize(PacketSerializer& serializer, PlayerLeave& data)
 		{
-			serializer &= data.index;
+			if (serializer.GetProtocolVersion() >= BuildVersion(0, 7, 0))
+				serializer.SerializeArraySize(data.indices);
+			else
+			{
+				// Older clients expect one packet per player
+				if (!serializer.IsWriting())
+					data.indices.resize(1);
+
+				assert(data.indices.size() == 1);
+			}
+
+			for (PlayerIndex& playerIndex : data.indices)
+				serializer &= playerIndex;
 		}
 
 		void Serialize(PacketSerializer& serializer, PlayerJoin& data)
 		{
-			serializer &= data.index;
-			serializer &= data.nickname;
-			serializer &= data.isAuthenticated;
+			if (serializer.GetProtocolVersion() >= BuildVersion(0, 7, 0))
+				serializer.SerializeArraySize(data.players);
+			else
+			{
+				// Older clients expect one packet per player
+				if (!serializer.IsWriting())
+					data.players.resize(1);
+
+				assert(data.players.size() == 1);
+			}
+
+			for (auto& player : data.players)
+			{
+				serializer &= player.index;
+				serializer &= player.nickname;
+				serializer &= player.isAuthenticated;
+			}
 		}
 
 		void Serialize(PacketSerializer& serializer, PlayerNameUpdate& data)
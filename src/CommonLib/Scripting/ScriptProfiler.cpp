@@ -0,0 +1,200 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <CommonLib/Scripting/ScriptProfiler.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <numeric>
+
+namespace tsom
+{
+	namespace
+	{
+		// Only the address is used, as a unique key in the Lua registry
+		constexpr char s_profilerRegistryKey = 0;
+
+		std::string FormatDuration(Nz::Time time)
+		{
+			Nz::Int64 microseconds = time.AsMicroseconds();
+			if (microseconds >= 1000)
+				return fmt::format("{:.2f}ms", microseconds / 1000.0);
+			else
+				return fmt::format("{}us", microseconds);
+		}
+	}
+
+	ScriptProfiler::ScriptProfiler(lua_State* L) :
+	m_budget(Nz::Time::Zero()),
+	m_deadline(Nz::Time::Zero()),
+	m_callDepth(0),
+	m_budgetExceeded(false)
+	{
+		// Hooks are plain C functions, they retrieve the profiler through the registry
+		lua_pushlightuserdata(L, this);
+		lua_rawsetp(L, LUA_REGISTRYINDEX, &s_profilerRegistryKey);
+	}
+
+	std::string ScriptProfiler::BuildReport() const
+	{
+		struct ClassTotal
+		{
+			Nz::Time totalTime = Nz::Time::Zero();
+			Nz::UInt64 callCount = 0;
+		};
+
+		tsl::hopscotch_map<std::string_view, ClassTotal> classTotals;
+		for (const CallbackStats& stats : m_callbacks)
+		{
+			ClassTotal& classTotal = classTotals[stats.className];
+			classTotal.totalTime += stats.totalTime;
+			classTotal.callCount += stats.callCount;
+		}
+
+		// Most expensive classes first, and most expensive callbacks first inside a class
+		std::vector<std::size_t> callbackOrder(m_callbacks.size());
+		std::iota(callbackOrder.begin(), callbackOrder.end(), 0);
+		std::sort(callbackOrder.begin(), callbackOrder.end(), [&](std::size_t lhs, std::size_t rhs)
+		{
+			const CallbackStats& lhsStats = m_callbacks[lhs];
+			const CallbackStats& rhsStats = m_callbacks[rhs];
+			if (lhsStats.className != rhsStats.className)
+			{
+				Nz::Time lhsClassTime = classTotals[lhsStats.className].totalTime;
+				Nz::Time rhsClassTime = classTotals[rhsStats.className].totalTime;
+				if (lhsClassTime != rhsClassTime)
+					return lhsClassTime > rhsClassTime;
+
+				return lhsStats.className < rhsStats.className;
+			}
+
+			return lhsStats.totalTime > rhsStats.totalTime;
+		});
+
+		std::string report;
+		if (m_budget > Nz::Time::Zero())
+			report = fmt::format("script callbacks (budget: {}):\n", FormatDuration(m_budget));
+		else
+			report = "script callbacks (no budget):\n";
+
+		std::string_view currentClass;
+		for (std::size_t callbackIndex : callbackOrder)
+		{
+			const CallbackStats& stats = m_callbacks[callbackIndex];
+			if (stats.callCount == 0)
+				continue;
+
+			if (stats.className != currentClass)
+			{
+				const ClassTotal& classTotal = classTotals[stats.className];
+				report += fmt::format("- {}: {} calls, {} total\n", stats.className, classTotal.callCount, FormatDuration(classTotal.totalTime));
+				currentClass = stats.className;
+			}
+
+			report += fmt::format("  - {}: {} calls, {} total, {} avg, {} max", stats.callbackName, stats.callCount, FormatDuration(stats.totalTime), FormatDuration(Nz::Time::Microseconds(stats.totalTime.AsMicroseconds() / Nz::SafeCast<Nz::Int64>(stats.callCount))), FormatDuration(stats.maxTime));
+			if (stats.abortCount > 0)
+				report += fmt::format(", {} aborted", stats.abortCount);
+
+			report += '\n';
+		}
+
+		return report;
+	}
+
+	std::size_t ScriptProfiler::RegisterCallback(std::string_view className, std::string_view callbackName)
+	{
+		// Classes are registered again when scripts are reloaded, keep their stats
+		std::string key = fmt::format("{}/{}", className, callbackName);
+		if (auto it = m_callbackIndices.find(key); it != m_callbackIndices.end())
+			return it->second;
+
+		std::size_t callbackIndex = m_callbacks.size();
+		auto& stats = m_callbacks.emplace_back();
+		stats.className = std::string(className);
+		stats.callbackName = std::string(callbackName);
+
+		m_callbackIndices.emplace(std::move(key), callbackIndex);
+
+		return callbackIndex;
+	}
+
+	void ScriptProfiler::ResetStats()
+	{
+		for (CallbackStats& stats : m_callbacks)
+		{
+			stats.abortCount = 0;
+			stats.callCount = 0;
+			stats.maxTime = Nz::Time::Zero();
+			stats.totalTime = Nz::Time::Zero();
+		}
+	}
+
+	auto ScriptProfiler::BeginCall(lua_State* L) -> CallContext
+	{
+		CallContext callContext;
+		callContext.startTime = m_clock.GetElapsedTime();
+		callContext.removeHook = false;
+
+		if (m_budget > Nz::Time::Zero())
+		{
+			// Nested callbacks (a property update triggered from an init callback for example) share the budget of the outermost one
+			if (m_callDepth == 0)
+			{
+				m_deadline = callContext.startTime + m_budget;
+				m_budgetExceeded = false;
+			}
+
+			// Hooks are per thread, a nested call may run on another one (a coroutine spawned from a callback)
+			if (m_callDepth == 0 || lua_gethook(L) != &ScriptProfiler::BudgetHook)
+			{
+				lua_sethook(L, &ScriptProfiler::BudgetHook, LUA_MASKCOUNT, HookInstructionInterval);
+				callContext.removeHook = true;
+			}
+		}
+
+		m_callDepth++;
+
+		return callContext;
+	}
+
+	void ScriptProfiler::EndCall(lua_State* L, std::size_t callbackIndex, const CallContext& callContext, bool succeeded)
+	{
+		assert(m_callDepth > 0);
+		assert(callbackIndex < m_callbacks.size());
+
+		Nz::Time elapsedTime = m_clock.GetElapsedTime() - callContext.startTime;
+
+		CallbackStats& stats = m_callbacks[callbackIndex];
+		stats.callCount++;
+		stats.totalTime += elapsedTime;
+		stats.maxTime = std::max(stats.maxTime, elapsedTime);
+
+		if (!succeeded && m_budgetExceeded)
+		{
+			stats.abortCount++;
+			fmt::print(fg(fmt::color::red), "{}/{} callback was aborted after running for {} (budget: {})\n", stats.className, stats.callbackName, FormatDuration(elapsedTime), FormatDuration(m_budget));
+		}
+
+		if (callContext.removeHook)
+			lua_sethook(L, nullptr, 0, 0);
+
+		if (--m_callDepth == 0)
+			m_budgetExceeded = false;
+	}
+
+	void ScriptProfiler::BudgetHook(lua_State* L, lua_Debug* /*ar*/)
+	{
+		lua_rawgetp(L, LUA_REGISTRYINDEX, &s_profilerRegistryKey);
+		ScriptProfiler* profiler = static_cast<ScriptProfiler*>(lua_touserdata(L, -1));
+		lua_pop(L, 1);
+
+		if (!profiler || profiler->m_clock.GetElapsedTime() < profiler->m_deadline)
+			return;
+
+		// Keep raising errors until the outermost callback returns, so pcall can't be used to keep running
+		profiler->m_budgetExceeded = true;
+		luaL_error(L, "execution budget exceeded");
+	}
+}
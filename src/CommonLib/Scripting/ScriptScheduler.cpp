@@ -0,0 +1,301 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <CommonLib/Scripting/ScriptScheduler.hpp>
+#include <CommonLib/InternalConstants.hpp>
+#include <CommonLib/Scripting/ScriptProfiler.hpp>
+#include <CommonLib/Scripting/ScriptingUtils.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace tsom
+{
+	ScriptScheduler::ScriptScheduler(ScriptProfiler& profiler) :
+	m_ownedTaskCount(0),
+	m_pendingTaskCount(0),
+	m_currentTick(0),
+	m_profiler(profiler)
+	{
+		m_coroutineProfilerIndex = m_profiler.RegisterCallback("scheduler", "coroutine");
+		m_timerProfilerIndex = m_profiler.RegisterCallback("scheduler", "timer");
+	}
+
+	bool ScriptScheduler::Cancel(TaskId taskId)
+	{
+		std::size_t taskIndex = static_cast<std::size_t>(taskId & 0xFFFFFFFF);
+		Nz::UInt32 generation = static_cast<Nz::UInt32>(taskId >> 32);
+		if (taskIndex >= m_tasks.size())
+			return false;
+
+		Task& task = m_tasks[taskIndex];
+		if (!task.isActive || task.generation != generation)
+			return false;
+
+		// The task stays in its wheel slot (or may be running), it will be freed when reached
+		task.isActive = false;
+		m_pendingTaskCount--;
+
+		return true;
+	}
+
+	void ScriptScheduler::CancelOwnedTasks(entt::handle owner)
+	{
+		if (m_ownedTaskCount == 0)
+			return;
+
+		for (Task& task : m_tasks)
+		{
+			if (task.isActive && task.owner == owner)
+			{
+				task.isActive = false;
+				m_pendingTaskCount--;
+			}
+		}
+	}
+
+	void ScriptScheduler::Register(sol::state& state)
+	{
+		sol::table scheduler = state.create_named_table("Scheduler");
+
+		scheduler["After"] = LuaFunction([this](double delay, sol::protected_function callback)
+		{
+			return static_cast<Nz::Int64>(ScheduleTimer(std::move(callback), ToTicks(Nz::Time::Seconds(delay))));
+		});
+
+		scheduler["Cancel"] = LuaFunction([this](Nz::Int64 taskId)
+		{
+			return Cancel(static_cast<TaskId>(taskId));
+		});
+
+		scheduler["Every"] = LuaFunction([this](double interval, sol::protected_function callback)
+		{
+			Nz::UInt32 intervalTicks = ToTicks(Nz::Time::Seconds(interval));
+			return static_cast<Nz::Int64>(ScheduleTimer(std::move(callback), intervalTicks, intervalTicks));
+		});
+
+		scheduler["GetTick"] = LuaFunction([this]()
+		{
+			return static_cast<Nz::Int64>(m_currentTick);
+		});
+
+		scheduler["Spawn"] = LuaFunction([this](sol::this_state L, sol::protected_function function) -> sol::optional<Nz::Int64>
+		{
+			std::optional<TaskId> taskId = Spawn(sol::state_view(L), std::move(function));
+			if (!taskId)
+				return sol::nullopt;
+
+			return static_cast<Nz::Int64>(*taskId);
+		});
+
+		// Sleep and WaitTicks yield the number of ticks to wait to the scheduler, which resumes the coroutine when they're elapsed
+		scheduler["Sleep"] = [](lua_State* L) -> int
+		{
+			lua_Number delay = luaL_checknumber(L, 1);
+			if (!lua_isyieldable(L))
+				return luaL_error(L, "Scheduler.Sleep can only be called from a coroutine (see Scheduler.Spawn)");
+
+			lua_pushinteger(L, ToTicks(Nz::Time::Seconds(delay)));
+			return lua_yield(L, 1);
+		};
+
+		scheduler["WaitTicks"] = [](lua_State* L) -> int
+		{
+			lua_Integer tickCount = luaL_optinteger(L, 1, 1);
+			if (!lua_isyieldable(L))
+				return luaL_error(L, "Scheduler.WaitTicks can only be called from a coroutine (see Scheduler.Spawn)");
+
+			lua_pushinteger(L, std::clamp<lua_Integer>(tickCount, 1, std::numeric_limits<Nz::UInt32>::max()));
+			return lua_yield(L, 1);
+		};
+	}
+
+	auto ScriptScheduler::ScheduleTimer(sol::protected_function callback, Nz::UInt32 delayTicks, Nz::UInt32 intervalTicks) -> TaskId
+	{
+		std::size_t taskIndex = AllocateTask();
+
+		Task& task = m_tasks[taskIndex];
+		task.callback = std::move(callback);
+		task.intervalTicks = intervalTicks;
+
+		Schedule(taskIndex, delayTicks);
+
+		return BuildTaskId(taskIndex, task.generation);
+	}
+
+	auto ScriptScheduler::Spawn(sol::state_view state, sol::protected_function function) -> std::optional<TaskId>
+	{
+		std::size_t taskIndex = AllocateTask();
+
+		sol::thread thread = sol::thread::create(state);
+		sol::coroutine coroutine(thread.state(), std::move(function));
+
+		Task& task = m_tasks[taskIndex];
+		task.coroutine = coroutine;
+		task.thread = std::move(thread);
+
+		TaskId taskId = BuildTaskId(taskIndex, task.generation);
+
+		// Run until the first yield, like coroutine.resume would (the profiler installs its budget hook on the new thread even if we're already in a callback)
+		sol::protected_function_result result = m_profiler.Call(m_coroutineProfilerIndex, coroutine);
+		HandleCoroutineResult(taskIndex, result);
+
+		const Task& updatedTask = m_tasks[taskIndex];
+		if (!updatedTask.isActive || BuildTaskId(taskIndex, updatedTask.generation) != taskId)
+			return std::nullopt;
+
+		return taskId;
+	}
+
+	void ScriptScheduler::Tick()
+	{
+		m_currentTick++;
+
+		std::vector<std::size_t>& slot = m_wheel[m_currentTick % WheelSize];
+		if (slot.empty())
+			return;
+
+		// Tasks can be scheduled on this slot while running the due ones (for a delay multiple of the wheel size)
+		assert(m_dueTasks.empty());
+		std::swap(m_dueTasks, slot);
+
+		for (std::size_t taskIndex : m_dueTasks)
+		{
+			// Don't keep references to tasks while running scripts as they may schedule new tasks
+			Task& task = m_tasks[taskIndex];
+			if (!task.isActive)
+			{
+				FreeTask(taskIndex);
+				continue;
+			}
+
+			if (task.dueTick > m_currentTick)
+			{
+				// Due in a later rotation of the wheel
+				slot.push_back(taskIndex);
+				continue;
+			}
+
+			// Tasks scheduled by this one belong to the same entity
+			entt::handle owner = task.owner;
+
+			if (task.coroutine.valid())
+			{
+				sol::coroutine coroutine = task.coroutine;
+				sol::protected_function_result result = RunAsOwner(owner, [&] { return m_profiler.Call(m_coroutineProfilerIndex, coroutine); });
+				HandleCoroutineResult(taskIndex, result);
+			}
+			else
+			{
+				sol::protected_function callback = task.callback;
+				sol::protected_function_result result = RunAsOwner(owner, [&] { return m_profiler.Call(m_timerProfilerIndex, callback); });
+				if (!result.valid())
+				{
+					sol::error err = result;
+					fmt::print(fg(fmt::color::red), "script timer failed: {}\n", err.what());
+				}
+
+				const Task& updatedTask = m_tasks[taskIndex];
+				if (updatedTask.isActive && updatedTask.intervalTicks > 0)
+					Schedule(taskIndex, updatedTask.intervalTicks);
+				else
+					FreeTask(taskIndex);
+			}
+		}
+		m_dueTasks.clear();
+	}
+
+	Nz::UInt32 ScriptScheduler::ToTicks(Nz::Time duration)
+	{
+		// Round up so a script never wakes up before the requested duration, and always wait at least one tick
+		Nz::Int64 tickDuration = Constants::TickDuration.AsMicroseconds();
+		Nz::Int64 tickCount = (duration.AsMicroseconds() + tickDuration - 1) / tickDuration;
+
+		return static_cast<Nz::UInt32>(std::clamp<Nz::Int64>(tickCount, 1, std::numeric_limits<Nz::UInt32>::max()));
+	}
+
+	std::size_t ScriptScheduler::AllocateTask()
+	{
+		std::size_t taskIndex;
+		if (!m_freeTasks.empty())
+		{
+			taskIndex = m_freeTasks.back();
+			m_freeTasks.pop_back();
+		}
+		else
+		{
+			taskIndex = m_tasks.size();
+			m_tasks.emplace_back();
+		}
+
+		Task& task = m_tasks[taskIndex];
+		task.isActive = true;
+		task.owner = m_currentOwner;
+
+		if (task.owner)
+			m_ownedTaskCount++;
+
+		m_pendingTaskCount++;
+
+		return taskIndex;
+	}
+
+	void ScriptScheduler::FreeTask(std::size_t taskIndex)
+	{
+		Task& task = m_tasks[taskIndex];
+		if (task.isActive)
+			m_pendingTaskCount--;
+
+		if (task.owner)
+		{
+			m_ownedTaskCount--;
+			task.owner = {};
+		}
+
+		task.callback = sol::protected_function{};
+		task.coroutine = sol::coroutine{};
+		task.thread = sol::thread{};
+		task.intervalTicks = 0;
+		task.isActive = false;
+		task.generation = (task.generation + 1) & 0x7FFFFFFF; //< keep ids positive as Lua integers
+
+		m_freeTasks.push_back(taskIndex);
+	}
+
+	void ScriptScheduler::HandleCoroutineResult(std::size_t taskIndex, sol::protected_function_result& result)
+	{
+		if (!result.valid())
+		{
+			sol::error err = result;
+			fmt::print(fg(fmt::color::red), "script coroutine failed: {}\n", err.what());
+		}
+		else if (result.status() == sol::call_status::yielded && m_tasks[taskIndex].isActive)
+		{
+			// A plain coroutine.yield() waits for the next tick
+			Nz::UInt32 delayTicks = 1;
+			if (result.return_count() > 0)
+			{
+				if (sol::optional<lua_Integer> tickCount = result.get<sol::optional<lua_Integer>>(0))
+					delayTicks = static_cast<Nz::UInt32>(std::clamp<lua_Integer>(*tickCount, 1, std::numeric_limits<Nz::UInt32>::max()));
+			}
+
+			Schedule(taskIndex, delayTicks);
+			return;
+		}
+
+		FreeTask(taskIndex);
+	}
+
+	void ScriptScheduler::Schedule(std::size_t taskIndex, Nz::UInt32 delayTicks)
+	{
+		assert(delayTicks > 0);
+
+		Task& task = m_tasks[taskIndex];
+		task.dueTick = m_currentTick + delayTicks;
+
+		m_wheel[task.dueTick % WheelSize].push_back(taskIndex);
+	}
+}
@@ -172,9 +172,12 @@ namespace tsom
 	}
 
 	ScriptingContext::ScriptingContext(Nz::ApplicationBase& app) :
-	m_app(app)
+	m_app(app),
+	m_profiler(m_state.lua_state()),
+	m_scheduler(m_profiler)
 	{
 		m_state.open_libraries();
+		m_scheduler.Register(m_state);
 
 		m_state["tostring"] = [](lua_State* L) -> int
 		{
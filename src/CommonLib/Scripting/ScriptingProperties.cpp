@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in LICENSE
 
 #include <CommonLib/Scripting/ScriptingProperties.hpp>
+#include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <sol/sol.hpp>
 
 namespace tsom
@@ -103,4 +104,39 @@ namespace tsom
 
 		}, property);
 	}
+
+	sol::object TranslatePropertyToLua(sol::state_view& lua, const ClassInstanceComponent& classInstance, Nz::UInt32 propertyIndex)
+	{
+		// Push values straight from the entity instead of copying them to an EntityProperty first
+		const auto& property = classInstance.GetClass()->GetProperty(propertyIndex);
+
+		auto PushValues = [&](auto dummyType) -> sol::object
+		{
+			using T = std::decay_t<decltype(dummyType)>;
+
+			PropertyPusher<T::Property> pusher;
+
+			if (property.isArray)
+			{
+				auto values = classInstance.GetPropertyArray<T::Property>(propertyIndex);
+				sol::table content = lua.create_table(int(values.size()));
+
+				for (std::size_t i = 0; i < values.size(); ++i)
+					content[i + 1] = pusher(lua, values[i]);
+
+				return content;
+			}
+			else
+				return pusher(lua, classInstance.GetProperty<T::Property>(propertyIndex));
+		};
+
+		switch (property.type)
+		{
+#define TSOM_ENTITYPROPERTYTYPE(V, T, IT) case EntityPropertyType:: T: return PushValues(EntityPropertyTag<EntityPropertyType:: T>{});
+
+#include <CommonLib/EntityPropertyList.hpp>
+		}
+
+		NAZARA_UNREACHABLE();
+	}
 }
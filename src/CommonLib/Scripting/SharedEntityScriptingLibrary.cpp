@@ -10,6 +10,8 @@
 #include <CommonLib/PhysicsConstants.hpp>
 #include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <CommonLib/Components/ScriptedEntityComponent.hpp>
+#include <CommonLib/Scripting/ScriptProfiler.hpp>
+#include <CommonLib/Scripting/ScriptScheduler.hpp>
 #include <CommonLib/Scripting/ScriptingProperties.hpp>
 #include <CommonLib/Scripting/ScriptingUtils.hpp>
 #include <ServerLib/ServerPlayer.hpp>
@@ -35,6 +37,7 @@ namespace tsom
 			sol::table classMetatable;
 			std::vector<EntityClass::RemoteProcedureCall> clientRpcs;
 			std::vector<EntityClass::Property> properties;
+			std::vector<sol::protected_function> clientRpcCallbacks;
 			std::vector<sol::protected_function> propertyUpdateCallbacks;
 			EntityClass::Callbacks callbacks;
 		};
@@ -174,7 +177,7 @@ namespace tsom
 				TriggerLuaArgError(L, 2, fmt::format("invalid property {}", propertyName));
 
 			sol::state_view state(L);
-			return TranslatePropertyToLua(state, classComponent.GetProperty(propertyIndex));
+			return TranslatePropertyToLua(state, classComponent, propertyIndex);
 		});
 
 		entityMetatable["UpdateProperty"] = LuaFunction([this](sol::this_state L, sol::table entityTable, std::string_view propertyName, sol::object value)
@@ -191,7 +194,7 @@ namespace tsom
 		});
 	}
 
-	void SharedEntityScriptingLibrary::HandleInit(sol::table classMetatable, entt::handle entity)
+	void SharedEntityScriptingLibrary::HandleInit(const ScriptedClass& scriptedClass, entt::handle entity)
 	{
 	}
 
@@ -200,6 +203,15 @@ namespace tsom
 		return false;
 	}
 
+	void SharedEntityScriptingLibrary::ResolveCallbacks(std::string_view className, ScriptedClass& scriptedClass)
+	{
+		if (sol::optional<sol::protected_function> initCallback = scriptedClass.classMetatable["_Init"])
+		{
+			scriptedClass.initCallback.function = std::move(*initCallback);
+			scriptedClass.initCallback.profilerIndex = m_profiler.RegisterCallback(className, "init");
+		}
+	}
+
 	auto SharedEntityScriptingLibrary::RetrieveAddComponentHandler(std::string_view componentType) -> AddComponentFunc
 	{
 		auto it = s_components.find(componentType);
@@ -218,6 +230,11 @@ namespace tsom
 		return it->second.getComponent;
 	}
 
+	void SharedEntityScriptingLibrary::OnScriptedEntityDestroy(entt::registry& registry, entt::entity entity)
+	{
+		m_scheduler.CancelOwnedTasks(entt::handle(registry, entity));
+	}
+
 	void SharedEntityScriptingLibrary::RegisterConstants(sol::state& state)
 	{
 		sol::table constantMetatable = state.create_table_with(
@@ -317,17 +334,12 @@ namespace tsom
 				if (rpcIt == entityBuilder.clientRpcs.end())
 					TriggerLuaError(L, fmt::format("unknown client rpc {}", eventName));
 
-				rpcIt->onCalled = [cb = std::move(callback), en = std::move(eventName)](entt::handle entity)
-				{
-					auto& entityScripted = entity.get<ScriptedEntityComponent>();
+				// The class name isn't known yet, the actual handler is built when registering the class
+				std::size_t rpcIndex = std::distance(entityBuilder.clientRpcs.begin(), rpcIt);
+				if (rpcIndex >= entityBuilder.clientRpcCallbacks.size())
+					entityBuilder.clientRpcCallbacks.resize(rpcIndex + 1);
 
-					auto res = cb(entityScripted.entityTable);
-					if (!res.valid())
-					{
-						sol::error err = res;
-						fmt::print(fg(fmt::color::red), "entity client rpc {} failed: {}\n", en, err.what());
-					}
-				};
+				entityBuilder.clientRpcCallbacks[rpcIndex] = std::move(callback);
 			}),
 			"OnPropertyUpdate", LuaFunction([this](sol::this_state L, EntityBuilder& entityBuilder, std::string_view propertyName, sol::protected_function callback)
 			{
@@ -380,19 +392,85 @@ namespace tsom
 		{
 			sol::state_view state(L);
 
-			std::shared_ptr sharedCallbacks = std::make_shared<std::vector<sol::protected_function>>(std::move(entityBuilder.propertyUpdateCallbacks));
-			entityBuilder.callbacks.onInit = [this, state, metatable = std::move(entityBuilder.classMetatable), sharedCallbacks](entt::handle entity) mutable
+			for (std::size_t rpcIndex = 0; rpcIndex < entityBuilder.clientRpcCallbacks.size(); ++rpcIndex)
+			{
+				sol::protected_function& callback = entityBuilder.clientRpcCallbacks[rpcIndex];
+				if (!callback)
+					continue;
+
+				auto& rpc = entityBuilder.clientRpcs[rpcIndex];
+				std::size_t profilerIndex = m_profiler.RegisterCallback(name, fmt::format("rpc:{}", rpc.name));
+
+				rpc.onCalled = [this, cb = std::move(callback), profilerIndex, en = rpc.name](entt::handle entity)
+				{
+					auto& entityScripted = entity.get<ScriptedEntityComponent>();
+
+					auto res = m_scheduler.RunAsOwner(entity, [&] { return m_profiler.Call(profilerIndex, cb, entityScripted.entityTable); });
+					if (!res.valid())
+					{
+						sol::error err = res;
+						fmt::print(fg(fmt::color::red), "entity client rpc {} failed: {}\n", en, err.what());
+					}
+				};
+			}
+
+			auto scriptedClass = std::make_shared<ScriptedClass>();
+			scriptedClass->classMetatable = std::move(entityBuilder.classMetatable);
+			scriptedClass->propertyUpdateCallbacks.resize(entityBuilder.propertyUpdateCallbacks.size());
+			for (std::size_t propertyIndex = 0; propertyIndex < entityBuilder.propertyUpdateCallbacks.size(); ++propertyIndex)
+			{
+				sol::protected_function& callback = entityBuilder.propertyUpdateCallbacks[propertyIndex];
+				if (!callback)
+					continue;
+
+				auto& propertyCallback = scriptedClass->propertyUpdateCallbacks[propertyIndex];
+				propertyCallback.function = std::move(callback);
+				propertyCallback.profilerIndex = m_profiler.RegisterCallback(name, fmt::format("property:{}", entityBuilder.properties[propertyIndex].name));
+			}
+
+			ResolveCallbacks(name, *scriptedClass);
+
+			entityBuilder.callbacks.onClassUpdate = [scriptedClass](entt::handle entity)
+			{
+				// Entities created from the previous version of the class switch to the reloaded callbacks
+				ScriptedEntityComponent* entityScripted = entity.try_get<ScriptedEntityComponent>();
+				if (!entityScripted)
+					return;
+
+				entityScripted->scriptedClass = scriptedClass;
+				entityScripted->entityTable[sol::metatable_key] = scriptedClass->classMetatable;
+			};
+
+			entityBuilder.callbacks.onInit = [this, state, scriptedClass = std::shared_ptr<const ScriptedClass>(std::move(scriptedClass))](entt::handle entity) mutable
 			{
 				auto& entityInstance = entity.get<ClassInstanceComponent>();
-				entityInstance.OnPropertyUpdate.Connect([entity, sharedCallbacks, state](ClassInstanceComponent* classInstance, Nz::UInt32 propertyIndex, const EntityProperty& newValue) mutable
+				entityInstance.OnPropertyUpdate.Connect([this, entity](ClassInstanceComponent* classInstance, Nz::UInt32 propertyIndex, const EntityProperty& newValue)
 				{
-					auto& callbacks = (*sharedCallbacks);
-					if (propertyIndex >= callbacks.size() || !callbacks[propertyIndex])
+					auto& entityScripted = entity.get<ScriptedEntityComponent>();
+
+					const auto& callbacks = entityScripted.scriptedClass->propertyUpdateCallbacks;
+					if (propertyIndex >= callbacks.size() || !callbacks[propertyIndex].function)
 						return;
 
-					auto& entityScripted = entity.get<ScriptedEntityComponent>();
+					const ScriptedClass::Callback& propertyCallback = callbacks[propertyIndex];
+
+					// Single values are pushed directly on the Lua stack, only arrays need to be translated to a table
+					auto res = m_scheduler.RunAsOwner(entity, [&]
+					{
+						return std::visit([&](auto&& value)
+						{
+							using T = std::decay_t<decltype(value)>;
+
+							if constexpr (EntityPropertyTypeExtractor<T>::IsArray)
+							{
+								sol::state_view state(propertyCallback.function.lua_state());
+								return m_profiler.Call(propertyCallback.profilerIndex, propertyCallback.function, entityScripted.entityTable, TranslatePropertyToLua(state, newValue));
+							}
+							else
+								return m_profiler.Call(propertyCallback.profilerIndex, propertyCallback.function, entityScripted.entityTable, *value);
+						}, newValue);
+					});
 
-					auto res = callbacks[propertyIndex](entityScripted.entityTable, TranslatePropertyToLua(state, newValue));
 					if (!res.valid())
 					{
 						const auto& propertyData = classInstance->GetClass()->GetProperty(propertyIndex);
@@ -403,17 +481,19 @@ namespace tsom
 				});
 
 				auto& entityScripted = entity.emplace<ScriptedEntityComponent>();
-				entityScripted.classMetatable = metatable;
+				entityScripted.scriptedClass = scriptedClass;
 				entityScripted.entityTable = state.create_table();
-				entityScripted.entityTable[sol::metatable_key] = entityScripted.classMetatable;
+				entityScripted.entityTable[sol::metatable_key] = scriptedClass->classMetatable;
 				entityScripted.entityTable["_Entity"] = entity;
 
-				HandleInit(entityScripted.classMetatable, entity);
+				// Timers and coroutines started by the entity callbacks are cancelled along with it
+				entity.registry()->on_destroy<ScriptedEntityComponent>().connect<&SharedEntityScriptingLibrary::OnScriptedEntityDestroy>(this);
+
+				HandleInit(*scriptedClass, entity);
 
-				sol::optional<sol::protected_function> initCallback = entityScripted.classMetatable["_Init"];
-				if (initCallback)
+				if (const ScriptedClass::Callback& initCallback = scriptedClass->initCallback; initCallback.function)
 				{
-					auto res = (*initCallback)(entityScripted.entityTable);
+					auto res = m_scheduler.RunAsOwner(entity, [&] { return m_profiler.Call(initCallback.profilerIndex, initCallback.function, entityScripted.entityTable); });
 					if (!res.valid())
 					{
 						sol::error err = res;
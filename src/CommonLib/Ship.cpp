@@ -7,6 +7,8 @@
 #include <CommonLib/FlatChunk.hpp>
 #include <CommonLib/GameConstants.hpp>
 #include <Nazara/Physics3D/Collider3D.hpp>
+#include <algorithm>
+#include <cassert>
 
 namespace tsom
 {
@@ -65,12 +67,12 @@ namespace tsom
 			std::vector<Nz::CompoundCollider3D::ChildCollider> childColliders;
 			for (auto&& [ChunkIndices, chunkData] : m_chunks)
 			{
-				auto chunkCollider = chunkData.chunk->BuildCollider();
+				auto chunkCollider = chunkData.chunk->BuildCollider(chunkData.chunk->TakeSnapshot());
 				if (!chunkCollider)
 					continue;
 
 				auto& childCollider = childColliders.emplace_back();
-				childCollider.collider = chunkData.chunk->BuildCollider();
+				childCollider.collider = std::move(chunkCollider);
 				childCollider.offset = GetChunkOffset(chunkData.chunk->GetIndices());
 			}
 
@@ -84,7 +86,8 @@ namespace tsom
 			if (m_chunks.empty())
 				return nullptr;
 
-			return m_chunks.begin().value().chunk->BuildCollider();
+			const Chunk& chunk = *m_chunks.begin().value().chunk;
+			return chunk.BuildCollider(chunk.TakeSnapshot());
 		}
 	}
 
@@ -97,6 +100,14 @@ namespace tsom
 		};
 	}
 
+	void Ship::ComputeGravityBatch(std::span<const Nz::Vector3f> positions, std::span<GravityForce> forces) const
+	{
+		assert(positions.size() == forces.size());
+
+		// Ship gravity is uniform
+		std::fill(forces.begin(), forces.end(), ComputeGravity(Nz::Vector3f::Zero()));
+	}
+
 	void Ship::ForEachChunk(Nz::FunctionRef<void(const ChunkIndices& chunkIndices, Chunk& chunk)> callback)
 	{
 		for (auto&& [chunkIndices, chunkData] : m_chunks)
@@ -123,7 +134,6 @@ namespace tsom
 		unsigned int height = (small) ? 4 : 6;
 		Nz::Vector3ui startPos = chunk.GetSize() / 2 - Nz::Vector3ui(boxSize / 2, boxSize / 2, height / 2);
 
-		chunk.LockWrite();
 		chunk.Reset();
 
 		for (unsigned int z = 0; z < height; ++z)
@@ -144,8 +154,11 @@ namespace tsom
 				}
 			}
 		}
+	}
 
-		chunk.UnlockWrite();
+	bool Ship::HasUniformGravity() const
+	{
+		return true;
 	}
 
 	void Ship::RemoveChunk(const ChunkIndices& indices)
@@ -4,11 +4,17 @@
 
 #include <CommonLib/Systems/GravityPhysicsSystem.hpp>
 #include <CommonLib/GravityController.hpp>
+#include <CommonLib/Components/GravityCacheComponent.hpp>
 #include <CommonLib/Components/PlanetComponent.hpp>
 #include <Nazara/Core/Components/DisabledComponent.hpp>
 #include <Nazara/Physics3D/PhysWorld3D.hpp>
+#include <Nazara/Physics3D/Components/PhysCharacter3DComponent.hpp>
 #include <Nazara/Physics3D/Components/RigidBody3DComponent.hpp>
 #include <entt/entt.hpp>
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Body/BodyInterface.h>
+#include <algorithm>
 
 namespace tsom
 {
@@ -18,6 +24,12 @@ namespace tsom
 	m_physWorld(physWorld)
 	{
 		m_physWorld.RegisterStepListener(this);
+
+		// Non-uniform gravity is applied per body, make sure Jolt doesn't add its own on top of it
+		if (!m_gravityController.HasUniformGravity())
+			m_physWorld.SetGravity(Nz::Vector3f::Zero());
+
+		m_characterConstructConnection = m_registry.on_construct<Nz::PhysCharacter3DComponent>().connect<&GravityPhysicsSystem::OnCharacterConstruct>(this);
 	}
 
 	GravityPhysicsSystem::~GravityPhysicsSystem()
@@ -27,16 +39,72 @@ namespace tsom
 
 	void GravityPhysicsSystem::PreSimulate(float /*elapsedTime*/)
 	{
+		if (m_gravityController.HasUniformGravity())
+		{
+			// Let Jolt apply it, this handles per-body gravity factor and doesn't touch sleeping bodies
+			GravityForce gravityForce = m_gravityController.ComputeGravity(Nz::Vector3f::Zero());
+			m_physWorld.SetGravity(gravityForce.direction * gravityForce.acceleration * gravityForce.factor);
+			return;
+		}
+
+		m_rigidBodies.clear();
+		m_refreshedBodyIndices.clear();
+		m_refreshedPositions.clear();
+
 		auto view = m_registry.view<Nz::RigidBody3DComponent>(entt::exclude<Nz::DisabledComponent>);
 		for (auto&& [entity, rigidBody] : view.each())
 		{
+			// Adding a force would wake up sleeping bodies
 			if (rigidBody.IsSleeping() || !rigidBody.IsDynamic())
 				continue;
 
-			Nz::Vector3f pos = rigidBody.GetPosition();
-			GravityForce gravityForce = m_gravityController.ComputeGravity(rigidBody.GetPosition());
+			// Components are stored in pages, pointers stay valid while new caches are added
+			auto& gravityCache = m_registry.get_or_emplace<GravityCacheComponent>(entity);
+
+			Nz::Vector3f position = rigidBody.GetPosition();
+			if (!gravityCache.isValid || gravityCache.position.SquaredDistance(position) > Nz::IntegralPow(GravityRefreshDistance, 2))
+			{
+				gravityCache.position = position;
+
+				m_refreshedBodyIndices.push_back(m_rigidBodies.size());
+				m_refreshedPositions.push_back(position);
+			}
+
+			m_rigidBodies.push_back({ &rigidBody, &gravityCache });
+		}
+
+		if (!m_refreshedPositions.empty())
+		{
+			m_refreshedGravities.resize(m_refreshedPositions.size());
+			m_gravityController.ComputeGravityBatch(m_refreshedPositions, m_refreshedGravities);
 
-			rigidBody.AddForce(gravityForce.direction * gravityForce.acceleration * gravityForce.factor * rigidBody.GetMass());
+			for (std::size_t i = 0; i < m_refreshedBodyIndices.size(); ++i)
+			{
+				GravityCacheComponent& gravityCache = *m_rigidBodies[m_refreshedBodyIndices[i]].gravityCache;
+				gravityCache.gravity = m_refreshedGravities[i];
+				gravityCache.isValid = true;
+			}
+		}
+
+		for (auto&& [rigidBody, gravityCache] : m_rigidBodies)
+		{
+			const GravityForce& gravityForce = gravityCache->gravity;
+			rigidBody->AddForce(gravityForce.direction * gravityForce.acceleration * gravityForce.factor * rigidBody->GetMass());
 		}
 	}
+	void GravityPhysicsSystem::OnCharacterConstruct(entt::registry& registry, entt::entity entity)
+	{
+		// CharacterController applies gravity to characters itself, make sure Jolt world gravity doesn't add up to it
+		auto& character = registry.get<Nz::PhysCharacter3DComponent>(entity);
+
+		JPH::PhysicsSystem* physicsSystem = m_physWorld.GetPhysicsSystem();
+
+		// Characters only expose their body index, retrieve the full body ID (including its sequence number)
+		JPH::BodyIDVector bodyIDs;
+		physicsSystem->GetBodies(bodyIDs);
+
+		auto it = std::find_if(bodyIDs.begin(), bodyIDs.end(), [&](const JPH::BodyID& bodyID) { return bodyID.GetIndex() == character.GetBodyIndex(); });
+		if (it != bodyIDs.end())
+			physicsSystem->GetBodyInterface().SetGravityFactor(*it, 0.f);
+	}
 }
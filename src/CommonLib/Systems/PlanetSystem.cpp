@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in LICENSE
 
 #include <CommonLib/Systems/PlanetSystem.hpp>
+#include <CommonLib/TickProfiler.hpp>
 #include <CommonLib/Components/PlanetComponent.hpp>
 #include <Nazara/Core/Components/DisabledComponent.hpp>
 #include <entt/entt.hpp>
@@ -11,6 +12,8 @@ namespace tsom
 {
 	void PlanetSystem::Update(Nz::Time elapsedTime)
 	{
+		TickProfiler::Zone zone("PlanetSystem::Update");
+
 		auto view = m_registry.view<PlanetComponent>(entt::exclude<Nz::DisabledComponent>);
 		for (entt::entity entity : view)
 		{
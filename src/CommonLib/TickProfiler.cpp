@@ -0,0 +1,197 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <CommonLib/TickProfiler.hpp>
+#include <CommonLib/Utility/RingBuffer.hpp>
+#include <Nazara/Core/File.hpp>
+#include <fmt/format.h>
+#include <tsl/hopscotch_map.h>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+namespace tsom
+{
+	namespace
+	{
+		struct ZoneEvent
+		{
+			const char* name = nullptr;
+			Nz::Time startTime = Nz::Time::Zero();
+			Nz::Time duration = Nz::Time::Zero();
+		};
+
+		struct ThreadBuffer
+		{
+			// Only contended while a report is being built
+			std::mutex mutex;
+			RingBuffer<ZoneEvent, TickProfiler::MaxEventPerThread> events;
+			std::size_t threadIndex;
+		};
+
+		struct ThreadEvent
+		{
+			ZoneEvent event;
+			std::size_t threadIndex;
+		};
+
+		struct ProfilerData
+		{
+			std::mutex mutex;
+			std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+		};
+
+		ProfilerData& GetProfilerData()
+		{
+			static ProfilerData profilerData;
+			return profilerData;
+		}
+
+		ThreadBuffer& GetThreadBuffer()
+		{
+			// Buffers are kept alive by the profiler so events of exited threads can still be reported
+			thread_local std::shared_ptr<ThreadBuffer> threadBuffer = []
+			{
+				ProfilerData& profilerData = GetProfilerData();
+
+				std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+
+				std::lock_guard lock(profilerData.mutex);
+				buffer->threadIndex = profilerData.threadBuffers.size();
+				profilerData.threadBuffers.push_back(buffer);
+
+				return buffer;
+			}();
+
+			return *threadBuffer;
+		}
+
+		std::vector<ThreadEvent> CollectEvents(Nz::Time minStartTime)
+		{
+			ProfilerData& profilerData = GetProfilerData();
+
+			std::vector<ThreadEvent> events;
+
+			std::lock_guard lock(profilerData.mutex);
+			for (const std::shared_ptr<ThreadBuffer>& threadBuffer : profilerData.threadBuffers)
+			{
+				std::lock_guard bufferLock(threadBuffer->mutex);
+				for (std::size_t i = 0; i < threadBuffer->events.GetSize(); ++i)
+				{
+					const ZoneEvent& event = threadBuffer->events[i];
+					if (event.startTime >= minStartTime)
+						events.push_back({ event, threadBuffer->threadIndex });
+				}
+			}
+
+			return events;
+		}
+
+		std::string FormatDuration(Nz::Time time)
+		{
+			Nz::Int64 microseconds = time.AsMicroseconds();
+			if (microseconds >= 1000)
+				return fmt::format("{:.2f}ms", microseconds / 1000.0);
+			else
+				return fmt::format("{}us", microseconds);
+		}
+	}
+
+	std::string TickProfiler::BuildReport(Nz::Time window)
+	{
+		std::vector<ZoneStats> zoneStats = ComputeStats(window);
+
+		std::string report = fmt::format("tick zones (last {}s):\n", window.AsSeconds<int>());
+		for (const ZoneStats& stats : zoneStats)
+			report += fmt::format("- {}: {} samples, {} total, p50 {}, p99 {}, max {}\n", stats.name, stats.sampleCount, FormatDuration(stats.totalTime), FormatDuration(stats.p50Time), FormatDuration(stats.p99Time), FormatDuration(stats.maxTime));
+
+		return report;
+	}
+
+	auto TickProfiler::ComputeStats(Nz::Time window) -> std::vector<ZoneStats>
+	{
+		std::vector<ThreadEvent> events = CollectEvents(Nz::GetElapsedNanoseconds() - window);
+
+		// Zone names are string literals, the same name may have different addresses across modules
+		tsl::hopscotch_map<std::string_view, std::vector<Nz::Time>> zoneDurations;
+		for (const ThreadEvent& threadEvent : events)
+			zoneDurations[threadEvent.event.name].push_back(threadEvent.event.duration);
+
+		std::vector<ZoneStats> zoneStats;
+		zoneStats.reserve(zoneDurations.size());
+		for (auto it = zoneDurations.begin(); it != zoneDurations.end(); ++it)
+		{
+			std::vector<Nz::Time>& durations = it.value();
+			std::sort(durations.begin(), durations.end());
+
+			// Nearest-rank percentile
+			auto Percentile = [&](std::size_t percent)
+			{
+				std::size_t rank = (durations.size() * percent + 99) / 100;
+				return durations[std::max<std::size_t>(rank, 1) - 1];
+			};
+
+			ZoneStats& stats = zoneStats.emplace_back();
+			stats.name = it->first;
+			stats.sampleCount = durations.size();
+			stats.maxTime = durations.back();
+			stats.p50Time = Percentile(50);
+			stats.p99Time = Percentile(99);
+			for (Nz::Time duration : durations)
+				stats.totalTime += duration;
+		}
+
+		// Most expensive zones first
+		std::sort(zoneStats.begin(), zoneStats.end(), [](const ZoneStats& lhs, const ZoneStats& rhs)
+		{
+			if (lhs.totalTime != rhs.totalTime)
+				return lhs.totalTime > rhs.totalTime;
+
+			return lhs.name < rhs.name;
+		});
+
+		return zoneStats;
+	}
+
+	bool TickProfiler::DumpChromeTrace(const std::filesystem::path& filePath)
+	{
+		std::vector<ThreadEvent> events = CollectEvents(Nz::Time::Zero());
+		std::sort(events.begin(), events.end(), [](const ThreadEvent& lhs, const ThreadEvent& rhs)
+		{
+			return lhs.event.startTime < rhs.event.startTime;
+		});
+
+		// Trace Event Format (complete events), can be opened with chrome://tracing or Perfetto
+		Nz::Time originTime = (!events.empty()) ? events.front().event.startTime : Nz::Time::Zero();
+
+		std::string trace = "{\"traceEvents\":[\n";
+		for (std::size_t i = 0; i < events.size(); ++i)
+		{
+			const ThreadEvent& threadEvent = events[i];
+			if (i > 0)
+				trace += ",\n";
+
+			double startTime = (threadEvent.event.startTime - originTime).AsNanoseconds() / 1000.0;
+			double duration = threadEvent.event.duration.AsNanoseconds() / 1000.0;
+			trace += fmt::format(R"({{"name":"{}","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})", threadEvent.event.name, threadEvent.threadIndex, startTime, duration);
+		}
+		trace += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+		return Nz::File::WriteWhole(filePath, trace.data(), trace.size());
+	}
+
+	void TickProfiler::RecordZone(const char* name, Nz::Time startTime, Nz::Time endTime)
+	{
+		ThreadBuffer& threadBuffer = GetThreadBuffer();
+
+		std::lock_guard lock(threadBuffer.mutex);
+
+		// Overwrite oldest events, only the most recent window is reported
+		if (threadBuffer.events.IsFull())
+			threadBuffer.events.PopFront();
+
+		threadBuffer.events.PushBack({ name, startTime, endTime - startTime });
+	}
+}
@@ -3,22 +3,28 @@
 // For conditions of distribution and use, see copyright notice in LICENSE
 
 #include <CommonLib/Utility/BinaryCompressor.hpp>
+#include <CommonLib/Utility/CompressionDictionary.hpp>
 #include <NazaraUtils/Algorithm.hpp>
 #include <lz4.h>
+#include <lz4hc.h>
+#include <cstring>
 
 namespace tsom
 {
 	BinaryCompressor::~BinaryCompressor()
 	{
+		if (m_dictionaryState)
+			LZ4_freeStream(m_dictionaryState);
+
 		if (m_state)
 			LZ4_freeStream(m_state);
+
+		if (m_stateHC)
+			LZ4_freeStreamHC(m_stateHC);
 	}
 
-	std::optional<std::span<Nz::UInt8>> BinaryCompressor::Compress(const void* data, std::size_t size)
+	std::optional<std::span<Nz::UInt8>> BinaryCompressor::Compress(const void* data, std::size_t size, const CompressionSettings& settings)
 	{
-		if (!m_state)
-			m_state = LZ4_createStream();
-
 		int dataSize = Nz::SafeCast<int>(size);
 		int maxCompressedSize = LZ4_compressBound(dataSize);
 		if (maxCompressedSize <= 0)
@@ -27,7 +33,14 @@ namespace tsom
 		const char* src = static_cast<const char*>(data);
 
 		m_compressedData.resize(maxCompressedSize);
-		int compressedSize = LZ4_compress_fast_extState(m_state, src, reinterpret_cast<char*>(m_compressedData.data()), dataSize, maxCompressedSize, 0);
+		char* dst = reinterpret_cast<char*>(m_compressedData.data());
+
+		int compressedSize;
+		if (settings.highCompressionLevel > 0)
+			compressedSize = CompressHC(src, dst, dataSize, maxCompressedSize, settings);
+		else
+			compressedSize = CompressFast(src, dst, dataSize, maxCompressedSize, settings);
+
 		if (compressedSize <= 0)
 			return std::nullopt;
 
@@ -35,11 +48,19 @@ namespace tsom
 		return m_compressedData;
 	}
 
-	std::optional<std::size_t> BinaryCompressor::Decompress(const void* compressedData, std::size_t compressedSize, void* output, std::size_t maxOutputSize)
+	std::optional<std::size_t> BinaryCompressor::Decompress(const void* compressedData, std::size_t compressedSize, void* output, std::size_t maxOutputSize, const CompressionDictionary* dictionary)
 	{
 		const char* src = static_cast<const char*>(compressedData);
 
-		int decompressedSize = LZ4_decompress_safe(src, static_cast<char*>(output), Nz::SafeCast<int>(compressedSize), Nz::SafeCast<int>(maxOutputSize));
+		int decompressedSize;
+		if (dictionary)
+		{
+			const char* dict = reinterpret_cast<const char*>(dictionary->GetData());
+			decompressedSize = LZ4_decompress_safe_usingDict(src, static_cast<char*>(output), Nz::SafeCast<int>(compressedSize), Nz::SafeCast<int>(maxOutputSize), dict, Nz::SafeCast<int>(dictionary->GetSize()));
+		}
+		else
+			decompressedSize = LZ4_decompress_safe(src, static_cast<char*>(output), Nz::SafeCast<int>(compressedSize), Nz::SafeCast<int>(maxOutputSize));
+
 		if (decompressedSize < 0)
 			return std::nullopt;
 
@@ -51,4 +72,42 @@ namespace tsom
 		static thread_local BinaryCompressor binaryCompressor;
 		return binaryCompressor;
 	}
+
+	int BinaryCompressor::CompressFast(const char* src, char* dst, int srcSize, int dstCapacity, const CompressionSettings& settings)
+	{
+		if (!m_state)
+			m_state = LZ4_createStream();
+
+		if (!settings.dictionary)
+			return LZ4_compress_fast_extState(m_state, src, dst, srcSize, dstCapacity, settings.acceleration);
+
+		// Loading a dictionary means hashing it, do it once per dictionary and copy the prepared state for every compression
+		if (m_loadedDictionary != settings.dictionary)
+		{
+			if (!m_dictionaryState)
+				m_dictionaryState = LZ4_createStream();
+			else
+				LZ4_resetStream_fast(m_dictionaryState);
+
+			LZ4_loadDict(m_dictionaryState, reinterpret_cast<const char*>(settings.dictionary->GetData()), Nz::SafeCast<int>(settings.dictionary->GetSize()));
+			m_loadedDictionary = settings.dictionary;
+		}
+
+		std::memcpy(m_state.Get(), m_dictionaryState.Get(), sizeof(LZ4_stream_t));
+		return LZ4_compress_fast_continue(m_state, src, dst, srcSize, dstCapacity, settings.acceleration);
+	}
+
+	int BinaryCompressor::CompressHC(const char* src, char* dst, int srcSize, int dstCapacity, const CompressionSettings& settings)
+	{
+		if (!m_stateHC)
+			m_stateHC = LZ4_createStreamHC();
+
+		if (!settings.dictionary)
+			return LZ4_compress_HC_extStateHC(m_stateHC, src, dst, srcSize, dstCapacity, settings.highCompressionLevel);
+
+		LZ4_resetStreamHC_fast(m_stateHC, settings.highCompressionLevel);
+		LZ4_loadDictHC(m_stateHC, reinterpret_cast<const char*>(settings.dictionary->GetData()), Nz::SafeCast<int>(settings.dictionary->GetSize()));
+
+		return LZ4_compress_HC_continue(m_stateHC, src, dst, srcSize, dstCapacity);
+	}
 }
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <CommonLib/Utility/CompressionDictionary.hpp>
+#include <CommonLib/InternalConstants.hpp>
+#include <Nazara/Core/File.hpp>
+#include <NazaraUtils/EnumArray.hpp>
+#include <NazaraUtils/PathUtils.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#include <fmt/std.h>
+#include <optional>
+
+namespace tsom
+{
+	namespace
+	{
+		struct DictionaryInfo
+		{
+			std::string_view name;
+			Nz::UInt32 version;
+		};
+
+		constexpr Nz::EnumArray<CompressionDictionaryType, DictionaryInfo> s_dictionaryInfos = {
+			DictionaryInfo{ "chunkcontent", Constants::ChunkContentDictionaryVersion },
+			DictionaryInfo{ "chunksave",    Constants::ChunkSaveDictionaryVersion }
+		};
+
+		Nz::EnumArray<CompressionDictionaryType, std::optional<CompressionDictionary>> s_dictionaries;
+	}
+
+	const CompressionDictionary* CompressionDictionary::Get(CompressionDictionaryType type)
+	{
+		const auto& dictionaryOpt = s_dictionaries[type];
+		return (dictionaryOpt) ? &dictionaryOpt.value() : nullptr;
+	}
+
+	void CompressionDictionary::LoadDirectory(const std::filesystem::path& directory)
+	{
+		// Dictionaries are trained offline (see xmake train-dictionary) and versioned with the protocol,
+		// a missing dictionary only means data will be compressed without one
+		for (auto&& [type, info] : s_dictionaryInfos.iter_kv())
+		{
+			s_dictionaries[type].reset();
+
+			std::filesystem::path dictionaryPath = directory / Nz::Utf8Path(fmt::format("{}_v{}.dict", info.name, info.version));
+			if (!std::filesystem::is_regular_file(dictionaryPath))
+				continue;
+
+			std::optional<std::vector<Nz::UInt8>> content = Nz::File::ReadWhole(dictionaryPath);
+			if (!content || content->empty())
+			{
+				fmt::print(fg(fmt::color::red), "failed to load compression dictionary {}\n", dictionaryPath);
+				continue;
+			}
+
+			s_dictionaries[type].emplace(info.version, std::move(*content));
+		}
+	}
+}
@@ -4,6 +4,7 @@
 
 #include <Game/States/ConnectionState.hpp>
 #include <ClientLib/ClientSessionHandler.hpp>
+#include <CommonLib/NetworkSessionManager.hpp>
 #include <CommonLib/SessionHandler.hpp>
 #include <CommonLib/Version.hpp>
 #include <Game/States/BackgroundState.hpp>
@@ -11,6 +12,7 @@
 #include <Nazara/Core/StateMachine.hpp>
 #include <Nazara/TextRenderer/SimpleTextDrawer.hpp>
 #include <Nazara/Widgets/LabelWidget.hpp>
+#include <NazaraUtils/Algorithm.hpp>
 #include <fmt/format.h>
 
 namespace tsom
@@ -19,6 +21,7 @@ namespace tsom
 
 	ConnectionState::ConnectionState(std::shared_ptr<StateData> stateData) :
 	WidgetState(std::move(stateData)),
+	m_connectionRequestId(0),
 	m_nextPollTimer(PeerInfoPollTime)
 	{
 		m_connectingLabel = CreateWidget<Nz::LabelWidget>();
@@ -34,6 +37,7 @@ namespace tsom
 
 		m_previousState = std::move(previousState);
 		m_playerData = std::move(playerData);
+		m_serverAddress = serverAddress;
 
 		// Find a compatible reactor
 		NetworkReactor* reactor = nullptr;
@@ -56,42 +60,38 @@ namespace tsom
 			reactor = &m_reactors.emplace_back(MaxConnection * m_reactors.size(), serverAddress.GetProtocol(), 0, MaxConnection);
 		}
 
-		auto& stateData = GetStateData();
-
-		std::size_t peerId = reactor->ConnectTo(serverAddress);
-		m_serverSession.emplace(*reactor, peerId, serverAddress);
-		m_serverSession->SetProtocolVersion(IsDevVersion() ? Nz::MaxValue() : GameVersion);
+		UpdateStatus(Nz::SimpleTextDrawer::Draw(fmt::format("Connecting to {0}...", serverAddress.ToString()), 36));
 
-		ClientSessionHandler& sessionHandler = m_serverSession->SetupHandler<ClientSessionHandler>(*stateData.app, *stateData.world, *stateData.blockLibrary);
-		ConnectSignal(sessionHandler.OnAuthResponse, [this](const Packets::AuthResponse& authResponse)
+		// Peer creation is asynchronous, ignore the response if another connection was started (or cancelled) in the meantime
+		Nz::UInt32 connectionRequestId = ++m_connectionRequestId;
+		reactor->ConnectTo(serverAddress, 0, [this, connectionRequestId, reactor, serverAddress](std::size_t peerId)
 		{
-			if (authResponse.authResult.IsOk())
+			if (connectionRequestId != m_connectionRequestId)
 			{
-				UpdateStatus(Nz::SimpleTextDrawer::Draw("Authenticated", 36));
+				if (peerId != NetworkReactor::InvalidPeerId)
+					reactor->DisconnectPeer(peerId, 0, DisconnectionType::Kick);
 
-				m_nextState = std::move(m_connectedState);
-				m_nextStateTimer = Nz::Time::Milliseconds(500);
+				return;
 			}
-			else
+
+			if (peerId == NetworkReactor::InvalidPeerId)
 			{
-				Disconnect();
-				UpdateStatus(Nz::SimpleTextDrawer::Draw(fmt::format("Authentication failed: {0}", ToString(authResponse.authResult.GetError())), 36, Nz::TextStyle_Regular, Nz::Color::Red()));
+				UpdateStatus(Nz::SimpleTextDrawer::Draw(fmt::format("Failed to connect to {0}", serverAddress.ToString()), 36, Nz::TextStyle_Regular, Nz::Color::Red()));
 
 				m_nextState = m_previousState;
 				m_nextStateTimer = Nz::Time::Seconds(3);
+				return;
 			}
-		});
-
-		stateData.networkSession = &m_serverSession.value();
-		stateData.sessionHandler = &sessionHandler;
 
-		UpdateStatus(Nz::SimpleTextDrawer::Draw(fmt::format("Connecting to {0}...", serverAddress.ToString()), 36));
-
-		m_connectedState = std::make_shared<GameState>(GetStateDataPtr());
+			SetupSession(*reactor, peerId, serverAddress);
+		});
 	}
 
 	void ConnectionState::Disconnect()
 	{
+		// Invalidate pending connection request
+		m_connectionRequestId++;
+
 		if (m_serverSession)
 		{
 			m_serverSession->Disconnect();
@@ -133,7 +133,14 @@ namespace tsom
 			if (!m_serverSession || m_serverSession->GetPeerId() != peerIndex)
 				return;
 
-			if (m_nextStateTimer < Nz::Time::Zero())
+			// Servers running multiple network reactors redirect players to the least loaded one
+			std::optional<Nz::UInt16> redirectPortOffset = NetworkSessionManager::ExtractRedirectPortOffset(data);
+			if (redirectPortOffset && !timeout)
+			{
+				m_redirectAddress = m_serverAddress;
+				m_redirectAddress->SetPort(Nz::SafeCast<Nz::UInt16>(m_serverAddress.GetPort() + *redirectPortOffset));
+			}
+			else if (m_nextStateTimer < Nz::Time::Zero())
 			{
 				if (timeout)
 				{
@@ -175,6 +182,15 @@ namespace tsom
 		for (auto& reactor : m_reactors)
 			reactor.Poll(ConnectionHandler, DisconnectionHandler, PacketHandler);
 
+		if (m_redirectAddress)
+		{
+			Nz::IpAddress redirectAddress = *m_redirectAddress;
+			m_redirectAddress.reset();
+
+			fmt::print("Redirected to {}\n", redirectAddress.ToString());
+			Connect(redirectAddress, m_playerData, m_previousState);
+		}
+
 		if (m_nextState)
 		{
 			m_nextStateTimer -= elapsedTime;
@@ -221,6 +237,39 @@ namespace tsom
 		});
 	}
 
+	void ConnectionState::SetupSession(NetworkReactor& reactor, std::size_t peerId, const Nz::IpAddress& serverAddress)
+	{
+		auto& stateData = GetStateData();
+
+		m_serverSession.emplace(reactor, peerId, serverAddress);
+		m_serverSession->SetProtocolVersion(IsDevVersion() ? Nz::MaxValue() : GameVersion);
+
+		ClientSessionHandler& sessionHandler = m_serverSession->SetupHandler<ClientSessionHandler>(*stateData.app, *stateData.world, *stateData.blockLibrary);
+		ConnectSignal(sessionHandler.OnAuthResponse, [this](const Packets::AuthResponse& authResponse)
+		{
+			if (authResponse.authResult.IsOk())
+			{
+				UpdateStatus(Nz::SimpleTextDrawer::Draw("Authenticated", 36));
+
+				m_nextState = std::move(m_connectedState);
+				m_nextStateTimer = Nz::Time::Milliseconds(500);
+			}
+			else
+			{
+				Disconnect();
+				UpdateStatus(Nz::SimpleTextDrawer::Draw(fmt::format("Authentication failed: {0}", ToString(authResponse.authResult.GetError())), 36, Nz::TextStyle_Regular, Nz::Color::Red()));
+
+				m_nextState = m_previousState;
+				m_nextStateTimer = Nz::Time::Seconds(3);
+			}
+		});
+
+		stateData.networkSession = &m_serverSession.value();
+		stateData.sessionHandler = &sessionHandler;
+
+		m_connectedState = std::make_shared<GameState>(GetStateDataPtr());
+	}
+
 	void ConnectionState::UpdateStatus(const Nz::AbstractTextDrawer& textDrawer)
 	{
 		m_connectingLabel->UpdateText(textDrawer);
@@ -61,17 +61,21 @@ namespace tsom
 
 		private:
 			void PollSessionInfo();
+			void SetupSession(NetworkReactor& reactor, std::size_t peerId, const Nz::IpAddress& serverAddress);
 			void UpdateStatus(const Nz::AbstractTextDrawer& textDrawer);
 
 			std::optional<ConnectionInfo> m_connectionInfo;
+			std::optional<Nz::IpAddress> m_redirectAddress;
 			std::optional<NetworkSession> m_serverSession;
 			std::shared_ptr<Nz::State> m_connectedState;
 			std::shared_ptr<Nz::State> m_nextState;
 			std::shared_ptr<Nz::State> m_previousState;
 			std::variant<Packets::AuthRequest::AuthenticatedPlayerData, Packets::AuthRequest::AnonymousPlayerData> m_playerData;
 			Nz::HighPrecisionClock m_sessionInfoClock;
+			Nz::IpAddress m_serverAddress;
 			Nz::FixedVector<NetworkReactor, 2> m_reactors;
 			Nz::LabelWidget* m_connectingLabel;
+			Nz::UInt32 m_connectionRequestId;
 			Nz::Time m_nextPollTimer;
 			Nz::Time m_nextStateTimer;
 	};
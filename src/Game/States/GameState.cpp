@@ -229,6 +229,16 @@ namespace tsom
 #endif
 		});
 
+		m_onInputAcknowledged.Connect(stateData.sessionHandler->OnInputAcknowledged, [&](InputIndex inputIndex)
+		{
+			// Server state didn't change but these inputs were processed, no need to keep predicting them
+			auto it = std::find_if(m_predictedInputRotations.begin(), m_predictedInputRotations.end(), [&](const InputRotation& inputRotation)
+			{
+				return IsInputMoreRecent(inputRotation.inputIndex, inputIndex);
+			});
+			m_predictedInputRotations.erase(m_predictedInputRotations.begin(), it);
+		});
+
 		m_blockSelectionBar = CreateWidget<BlockSelectionBar>(*stateData.blockLibrary);
 
 		m_mouseWheelMovedSlot.Connect(stateData.window->GetEventHandler().OnMouseWheelMoved, [&](const Nz::WindowEventHandler* /*eventHandler*/, const Nz::WindowEvent::MouseWheelEvent& event)
@@ -1005,6 +1015,8 @@ namespace tsom
 		AnimationSystem& animationSystem = GetStateData().world->GetSystem<AnimationSystem>();
 		animationSystem.UpdateAnimationStates(elapsedTime);
 
+		GetStateData().sessionHandler->GetScriptingContext().GetScheduler().Tick();
+
 		if (lastTick)
 			SendInputs();
 	}
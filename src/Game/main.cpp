@@ -4,6 +4,7 @@
 
 #include <ClientLib/ClientAssetLibraryAppComponent.hpp>
 #include <CommonLib/UpdaterAppComponent.hpp>
+#include <CommonLib/Utility/CompressionDictionary.hpp>
 #include <Game/GameAppComponent.hpp>
 #include <Game/GameConfigAppComponent.hpp>
 #include <Nazara/Core/Application.hpp>
@@ -19,6 +20,7 @@
 #include <Nazara/Platform/WindowingAppComponent.hpp>
 #include <Nazara/Renderer/GpuSwitch.hpp>
 #include <Nazara/Widgets/Widgets.hpp>
+#include <NazaraUtils/PathUtils.hpp>
 #include <Main/Main.hpp>
 #include <fmt/color.h>
 #include <fmt/format.h>
@@ -40,6 +42,8 @@ int GameMain(int argc, char* argv[])
 	app.AddComponent<Nz::WindowingAppComponent>();
 
 	// Game setup
+	tsom::CompressionDictionary::LoadDirectory(Nz::Utf8Path("dictionaries"));
+
 	app.AddComponent<tsom::ClientAssetLibraryAppComponent>();
 	auto& gameConfig = app.AddComponent<tsom::GameConfigAppComponent>();
 
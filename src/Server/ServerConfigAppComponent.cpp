@@ -14,8 +14,14 @@ namespace tsom
 	{
 		RegisterStringOption("Api.Url");
 		RegisterStringOption("ConnectionToken.EncryptionKey", "");
+		RegisterFloatOption("Server.ChunkColliderDistance", 0.0, 1024.0, 64.0);
 		RegisterIntegerOption("Server.Port", 1, 0xFFFF, 29536);
+		RegisterIntegerOption("Server.MaxInputBacklog", 0, 63, 6);
 		RegisterIntegerOption("Server.MaxStuckSeconds", 0, 60, 10);
+		RegisterBoolOption("Server.ParallelWorldUpdate", true);
+		RegisterIntegerOption("Server.ReactorCount", 1, 16, 1);
+		RegisterStringOption("Server.RecordFile", "");
+		RegisterIntegerOption("Server.ScriptCallbackBudget", 0, 1000, 10);
 		RegisterBoolOption("Server.SleepWhenEmpty", true);
 		RegisterStringOption("Save.Directory", "saves/chunks");
 		RegisterIntegerOption("Save.Interval", 0, 60 * 60, 30);
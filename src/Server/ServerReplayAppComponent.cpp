@@ -0,0 +1,67 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <Server/ServerReplayAppComponent.hpp>
+#include <CommonLib/TickProfiler.hpp>
+#include <Nazara/Core/ApplicationBase.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#include <algorithm>
+
+namespace tsom
+{
+	ServerReplayAppComponent::ServerReplayAppComponent(Nz::ApplicationBase& app, std::unique_ptr<ServerReplayer> replayer, ServerInstance::Config instanceConfig, Nz::Time reportInterval) :
+	ApplicationComponent(app),
+	m_instance(std::make_unique<ServerInstance>(app, std::move(instanceConfig))),
+	m_replayer(std::move(replayer)),
+	m_reportInterval(reportInterval),
+	m_lastReportTickCount(0)
+	{
+	}
+
+	void ServerReplayAppComponent::Update(Nz::Time /*elapsedTime*/)
+	{
+		if (!m_replayer)
+			return;
+
+		// Replay as fast as possible, only giving control back to the application from time to time to handle signals
+		Nz::HighPrecisionClock updateClock;
+		while (updateClock.GetElapsedTime() < Nz::Time::Milliseconds(100))
+		{
+			if (!m_replayer->Tick(*m_instance))
+			{
+				PrintReport(true);
+
+				// Players have to leave while the environments are still alive
+				m_replayer.reset();
+
+				GetApp().Quit();
+				return;
+			}
+		}
+
+		if (m_reportClock.GetElapsedTime() >= m_reportInterval)
+			PrintReport(false);
+	}
+
+	void ServerReplayAppComponent::PrintReport(bool isFinal)
+	{
+		Nz::UInt64 tickCount = m_replayer->GetReplayedTickCount();
+		Nz::Time elapsedTime = m_reportClock.Restart();
+
+		// The profiler only keeps the last events of each thread, report regularly instead of only once at the end
+		double tickPerSecond = (tickCount - m_lastReportTickCount) / std::max(elapsedTime.AsSeconds<double>(), 0.001);
+		double realtimeFactor = tickPerSecond * m_instance->GetTickDuration().AsSeconds<double>();
+
+		std::string report = fmt::format("{} (tick {}, {} sessions): {:.1f} ticks/s ({:.1f}x realtime)\n", (isFinal) ? "replay finished" : "replaying", tickCount, m_replayer->GetSessionCount(), tickPerSecond, realtimeFactor);
+		report += TickProfiler::BuildReport(elapsedTime);
+
+		if (isFinal)
+			report += fmt::format("replayed {} ticks in {:.2f}s\n", tickCount, m_replayClock.GetElapsedTime().AsSeconds<double>());
+
+		fmt::print("{}", report);
+
+		m_lastReportTickCount = tickCount;
+	}
+}
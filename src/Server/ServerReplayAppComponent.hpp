@@ -0,0 +1,49 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#ifndef TSOM_SERVER_SERVERREPLAYAPPCOMPONENT_HPP
+#define TSOM_SERVER_SERVERREPLAYAPPCOMPONENT_HPP
+
+#include <ServerLib/ServerInstance.hpp>
+#include <ServerLib/ServerReplayer.hpp>
+#include <Nazara/Core/ApplicationComponent.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Time.hpp>
+#include <memory>
+
+namespace tsom
+{
+	// Replays a server recording as fast as possible and prints the tick profiler report along the way
+	class ServerReplayAppComponent final : public Nz::ApplicationComponent
+	{
+		public:
+			ServerReplayAppComponent(Nz::ApplicationBase& app, std::unique_ptr<ServerReplayer> replayer, ServerInstance::Config instanceConfig, Nz::Time reportInterval = Nz::Time::Seconds(10));
+			ServerReplayAppComponent(const ServerReplayAppComponent&) = delete;
+			ServerReplayAppComponent(ServerReplayAppComponent&&) = delete;
+			~ServerReplayAppComponent() = default;
+
+			inline ServerInstance& GetInstance();
+
+			void Update(Nz::Time elapsedTime) override;
+
+			ServerReplayAppComponent& operator=(const ServerReplayAppComponent&) = delete;
+			ServerReplayAppComponent& operator=(ServerReplayAppComponent&&) = delete;
+
+		private:
+			void PrintReport(bool isFinal);
+
+			std::unique_ptr<ServerInstance> m_instance;
+			std::unique_ptr<ServerReplayer> m_replayer; //< must be destroyed before m_instance
+			Nz::HighPrecisionClock m_replayClock;
+			Nz::HighPrecisionClock m_reportClock;
+			Nz::Time m_reportInterval;
+			Nz::UInt64 m_lastReportTickCount;
+	};
+}
+
+#include <Server/ServerReplayAppComponent.inl>
+
+#endif // TSOM_SERVER_SERVERREPLAYAPPCOMPONENT_HPP
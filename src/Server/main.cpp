@@ -4,10 +4,13 @@
 
 #include <CommonLib/HealthCheckerAppComponent.hpp>
 #include <CommonLib/InternalConstants.hpp>
+#include <CommonLib/Utility/CompressionDictionary.hpp>
 #include <Server/ServerConfigAppComponent.hpp>
+#include <Server/ServerReplayAppComponent.hpp>
 #include <ServerLib/PlayerTokenAppComponent.hpp>
 #include <ServerLib/ServerInstanceAppComponent.hpp>
 #include <ServerLib/ServerPlanetEnvironment.hpp>
+#include <ServerLib/ServerRecorder.hpp>
 #include <ServerLib/Session/InitialSessionHandler.hpp>
 #include <Nazara/Core/Application.hpp>
 #include <Nazara/Core/Core.hpp>
@@ -30,7 +33,6 @@ int ServerMain(int argc, char* argv[])
 	app.AddComponent<Nz::WebServiceAppComponent>();
 	app.AddComponent<tsom::PlayerTokenAppComponent>();
 	auto& configAppComponent = app.AddComponent<tsom::ServerConfigAppComponent>();
-	auto& serverInstanceAppComponent = app.AddComponent<tsom::ServerInstanceAppComponent>();
 
 	std::filesystem::path scriptPath = Nz::Utf8Path("scripts");
 	if (!std::filesystem::is_directory(scriptPath))
@@ -42,27 +44,87 @@ int ServerMain(int argc, char* argv[])
 	auto& filesystem = app.AddComponent<Nz::FilesystemAppComponent>();
 	filesystem.Mount("scripts", scriptPath);
 
+	tsom::CompressionDictionary::LoadDirectory(Nz::Utf8Path("dictionaries"));
+
 	auto& config = configAppComponent.GetConfig();
 
 	if (Nz::UInt32 maxStuckTime = config.GetIntegerValue<Nz::UInt32>("Server.MaxStuckSeconds"))
 		app.AddComponent<tsom::HealthCheckerAppComponent>(maxStuckTime);
 
 	Nz::UInt16 serverPort = config.GetIntegerValue<Nz::UInt16>("Server.Port");
+	std::size_t reactorCount = config.GetIntegerValue<std::size_t>("Server.ReactorCount");
 	std::filesystem::path saveDirectory = Nz::Utf8Path(config.GetStringValue("Save.Directory"));
+	Nz::UInt32 planetSeed = 42;
 
 	tsom::ServerInstance::Config instanceConfig;
+	instanceConfig.chunkColliderDistance = config.GetFloatValue<float>("Server.ChunkColliderDistance");
+	instanceConfig.maxInputBacklog = config.GetIntegerValue<std::size_t>("Server.MaxInputBacklog");
+	instanceConfig.parallelWorldUpdate = config.GetBoolValue("Server.ParallelWorldUpdate");
 	instanceConfig.pauseWhenEmpty = config.GetBoolValue("Server.SleepWhenEmpty");
 	instanceConfig.saveInterval = Nz::Time::Seconds(config.GetIntegerValue<long long>("Save.Interval"));
+	instanceConfig.scriptCallbackBudget = Nz::Time::Milliseconds(config.GetIntegerValue<long long>("Server.ScriptCallbackBudget"));
 	instanceConfig.connectionTokenEncryptionKey = config.GetConnectionTokenEncryptionKey();
 
-	auto& instance = serverInstanceAppComponent.AddInstance(instanceConfig);
-	auto& sessionManager = instance.AddSessionManager(serverPort);
-	sessionManager.SetDefaultHandler<tsom::InitialSessionHandler>(std::ref(instance));
+	tsom::ServerInstance* instance;
+
+	std::string_view replayPath;
+	bool isReplaying = app.GetCommandLineParameters().GetParameter("replay", &replayPath);
+	if (isReplaying)
+	{
+		std::unique_ptr<tsom::ServerReplayer> replayer;
+		try
+		{
+			replayer = std::make_unique<tsom::ServerReplayer>(Nz::Utf8Path(replayPath));
+		}
+		catch (const std::exception& e)
+		{
+			fmt::print(fg(fmt::color::red), "failed to load recording: {0}\n", e.what());
+			return EXIT_FAILURE;
+		}
+
+		// Start from the save the recording was made with, without touching the real one
+		saveDirectory = std::filesystem::temp_directory_path() / Nz::Utf8Path("tsom_replay");
+		std::filesystem::remove_all(saveDirectory);
+		if (!replayer->ExtractSnapshot(saveDirectory))
+			return EXIT_FAILURE;
 
-	tsom::ServerPlanetEnvironment planet(instance, saveDirectory, 42, Nz::Vector3ui(5), 1.f);
-	instance.SetDefaultSpawnpoint(&planet, Nz::Vector3f::Up() * 100.f + Nz::Vector3f::Backward() * 5.f, Nz::Quaternionf::Identity());
+		planetSeed = replayer->GetSeed();
+
+		auto& replayAppComponent = app.AddComponent<tsom::ServerReplayAppComponent>(std::move(replayer), instanceConfig);
+		instance = &replayAppComponent.GetInstance();
+	}
+	else
+	{
+		auto& serverInstanceAppComponent = app.AddComponent<tsom::ServerInstanceAppComponent>();
+		instance = &serverInstanceAppComponent.AddInstance(instanceConfig);
+
+		auto& sessionManager = instance->AddSessionManager(serverPort, Nz::NetProtocol::Any, tsom::NetworkSessionManager::MaxSessionPerReactor * reactorCount, reactorCount);
+		if (reactorCount > 1)
+			fmt::print("listening on ports {0}-{1} ({2} network reactors, peers connecting to {0} are redirected to the least loaded one)\n", serverPort, serverPort + reactorCount - 1, reactorCount);
+		sessionManager.SetDefaultHandler<tsom::InitialSessionHandler>(std::ref(*instance));
+	}
+
+	tsom::ServerPlanetEnvironment planet(*instance, saveDirectory, planetSeed, Nz::Vector3ui(5), 1.f);
+	instance->SetDefaultSpawnpoint(&planet, Nz::Vector3f::Up() * 100.f + Nz::Vector3f::Backward() * 5.f, Nz::Quaternionf::Identity());
+
+	// Start recording once the planet is loaded, as the recording embeds the save directory
+	if (const std::string& recordFile = config.GetStringValue("Server.RecordFile"); !recordFile.empty() && !isReplaying)
+	{
+		try
+		{
+			instance->SetRecorder(std::make_unique<tsom::ServerRecorder>(Nz::Utf8Path(recordFile), planetSeed, saveDirectory));
+		}
+		catch (const std::exception& e)
+		{
+			fmt::print(fg(fmt::color::red), "failed to start recording: {0}\n", e.what());
+			return EXIT_FAILURE;
+		}
+	}
 
-	fmt::print(fg(fmt::color::lime_green), "server ready.\n");
+	if (isReplaying)
+		fmt::print(fg(fmt::color::lime_green), "replaying {0}...\n", replayPath);
+	else
+		fmt::print(fg(fmt::color::lime_green), "server ready.\n");
 
 	return app.Run();
 }
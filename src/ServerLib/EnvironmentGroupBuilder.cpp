@@ -0,0 +1,66 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <ServerLib/EnvironmentGroupBuilder.hpp>
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace tsom
+{
+	void EnvironmentGroupBuilder::Begin(std::size_t environmentCount)
+	{
+		m_parentIndices.resize(environmentCount);
+		std::iota(m_parentIndices.begin(), m_parentIndices.end(), std::size_t(0));
+
+		for (std::size_t i = 0; i < m_groupCount; ++i)
+			m_groups[i].clear();
+
+		m_groupCount = 0;
+	}
+
+	std::size_t EnvironmentGroupBuilder::Build()
+	{
+		// Group roots are always the lowest index of their group, flatten everything so each environment points directly to it
+		for (std::size_t i = 0; i < m_parentIndices.size(); ++i)
+			m_parentIndices[i] = FindRoot(i);
+
+		// Build groups, keeping environment order inside each of them
+		for (std::size_t i = 0; i < m_parentIndices.size(); ++i)
+		{
+			std::size_t groupRoot = m_parentIndices[i];
+			if (groupRoot == i)
+			{
+				if (m_groupCount >= m_groups.size())
+					m_groups.emplace_back();
+
+				// Roots are visited before the rest of their group, reuse their entry to store the group index
+				m_parentIndices[i] = m_groupCount++;
+				m_groups[m_parentIndices[i]].push_back(i);
+			}
+			else
+				m_groups[m_parentIndices[groupRoot]].push_back(i);
+		}
+
+		return m_groupCount;
+	}
+
+	void EnvironmentGroupBuilder::Link(std::size_t firstEnvironment, std::size_t secondEnvironment)
+	{
+		assert(firstEnvironment < m_parentIndices.size());
+		assert(secondEnvironment < m_parentIndices.size());
+
+		std::size_t firstRoot = FindRoot(firstEnvironment);
+		std::size_t secondRoot = FindRoot(secondEnvironment);
+		m_parentIndices[std::max(firstRoot, secondRoot)] = std::min(firstRoot, secondRoot);
+	}
+
+	std::size_t EnvironmentGroupBuilder::FindRoot(std::size_t environmentIndex)
+	{
+		while (m_parentIndices[environmentIndex] != environmentIndex)
+			environmentIndex = m_parentIndices[environmentIndex] = m_parentIndices[m_parentIndices[environmentIndex]];
+
+		return environmentIndex;
+	}
+}
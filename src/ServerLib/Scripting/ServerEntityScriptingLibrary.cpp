@@ -5,6 +5,8 @@
 #include <ServerLib/Scripting/ServerEntityScriptingLibrary.hpp>
 #include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <CommonLib/Components/ScriptedEntityComponent.hpp>
+#include <CommonLib/Scripting/ScriptProfiler.hpp>
+#include <CommonLib/Scripting/ScriptScheduler.hpp>
 #include <CommonLib/Scripting/ScriptingUtils.hpp>
 #include <ServerLib/ServerPlanetEnvironment.hpp>
 #include <ServerLib/ServerPlayer.hpp>
@@ -59,25 +61,32 @@ namespace tsom
 		});
 	}
 
-	void ServerEntityScriptingLibrary::HandleInit(sol::table classMetatable, entt::handle entity)
+	void ServerEntityScriptingLibrary::HandleInit(const ScriptedClass& scriptedClass, entt::handle entity)
 	{
-		sol::optional<sol::protected_function> interactCallback = classMetatable["_Interact"];
-		if (interactCallback)
+		if (!scriptedClass.interactCallback.function)
+			return;
+
+		auto& entityInteractible = entity.emplace<ServerInteractibleComponent>();
+		entityInteractible.isEnabled = false;
+		entityInteractible.onInteraction = [this](entt::handle entity, ServerPlayer* triggeringPlayer)
 		{
-			auto& entityInteractible = entity.emplace<ServerInteractibleComponent>();
-			entityInteractible.isEnabled = false;
-			entityInteractible.onInteraction = [cb = std::move(*interactCallback)](entt::handle entity, ServerPlayer* triggeringPlayer)
+			auto& entityScripted = entity.get<ScriptedEntityComponent>();
+
+			// Retrieve the callback from the class on each call as it may have been reloaded since
+			const ScriptedClass::Callback& interactCallback = entityScripted.scriptedClass->interactCallback;
+			if (!interactCallback.function)
+				return;
+
+			auto res = GetScheduler().RunAsOwner(entity, [&]
 			{
-				auto& entityScripted = entity.get<ScriptedEntityComponent>();
-
-				auto res = cb(entityScripted.entityTable, (triggeringPlayer) ? triggeringPlayer->CreateHandle() : Nz::ObjectHandle<ServerPlayer>{});
-				if (!res.valid())
-				{
-					sol::error err = res;
-					fmt::print(fg(fmt::color::red), "entity interact event failed: {}\n", err.what());
-				}
-			};
-		}
+				return GetProfiler().Call(interactCallback.profilerIndex, interactCallback.function, entityScripted.entityTable, (triggeringPlayer) ? triggeringPlayer->CreateHandle() : Nz::ObjectHandle<ServerPlayer>{});
+			});
+			if (!res.valid())
+			{
+				sol::error err = res;
+				fmt::print(fg(fmt::color::red), "entity interact event failed: {}\n", err.what());
+			}
+		};
 	}
 
 	bool ServerEntityScriptingLibrary::RegisterEvent(sol::table classMetatable, std::string_view eventName, sol::protected_function callback)
@@ -90,4 +99,15 @@ namespace tsom
 
 		return false;
 	}
+
+	void ServerEntityScriptingLibrary::ResolveCallbacks(std::string_view className, ScriptedClass& scriptedClass)
+	{
+		SharedEntityScriptingLibrary::ResolveCallbacks(className, scriptedClass);
+
+		if (sol::optional<sol::protected_function> interactCallback = scriptedClass.classMetatable["_Interact"])
+		{
+			scriptedClass.interactCallback.function = std::move(*interactCallback);
+			scriptedClass.interactCallback.profilerIndex = GetProfiler().RegisterCallback(className, "interact");
+		}
+	}
 }
@@ -3,16 +3,19 @@
 // For conditions of distribution and use, see copyright notice in LICENSE
 
 #include <ServerLib/ServerEnvironment.hpp>
+#include <CommonLib/TickProfiler.hpp>
 #include <CommonLib/Physics/PhysicsSettings.hpp>
 #include <ServerLib/Systems/EnvironmentProxySystem.hpp>
 #include <ServerLib/Systems/NetworkedEntitiesSystem.hpp>
 #include <Nazara/Physics3D/Systems/Physics3DSystem.hpp>
+#include <cassert>
 
 namespace tsom
 {
 	ServerEnvironment::ServerEnvironment(ServerInstance& serverInstance, ServerEnvironmentType type) :
 	m_type(type),
-	m_serverInstance(serverInstance)
+	m_serverInstance(serverInstance),
+	m_isUpdatingWorld(false)
 	{
 		m_world = m_serverInstance.RegisterEnvironment(this);
 
@@ -77,9 +80,18 @@ namespace tsom
 		return m_world->CreateEntity();
 	}
 
-	void ServerEnvironment::OnTick(Nz::Time elapsedTime)
+	void ServerEnvironment::FlushSerializedCallbacks()
+	{
+		// Callbacks are not updating the world so anything they trigger runs immediately and can't grow the list
+		assert(!m_isUpdatingWorld);
+		for (auto& callback : m_serializedCallbacks)
+			callback();
+
+		m_serializedCallbacks.clear();
+	}
+
+	void ServerEnvironment::OnTick(Nz::Time /*elapsedTime*/)
 	{
-		m_world->Update(elapsedTime);
 	}
 
 	void ServerEnvironment::RegisterPlayer(ServerPlayer* player)
@@ -93,4 +105,14 @@ namespace tsom
 		NazaraAssertMsg(m_registeredPlayers.UnboundedTest(player->GetPlayerIndex()), "player is not registered");
 		m_registeredPlayers.Reset(player->GetPlayerIndex());
 	}
+
+	void ServerEnvironment::UpdateWorld(Nz::Time elapsedTime)
+	{
+		// Also covers systems which aren't ours (such as physics)
+		TickProfiler::Zone zone("ServerEnvironment::UpdateWorld");
+
+		m_isUpdatingWorld = true;
+		m_world->Update(elapsedTime);
+		m_isUpdatingWorld = false;
+	}
 }
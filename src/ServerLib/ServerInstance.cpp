@@ -3,37 +3,83 @@
 // For conditions of distribution and use, see copyright notice in LICENSE
 
 #include <ServerLib/ServerInstance.hpp>
+#include <CommonLib/CharacterController.hpp>
 #include <CommonLib/InternalConstants.hpp>
+#include <CommonLib/ShipController.hpp>
+#include <CommonLib/TickProfiler.hpp>
+#include <CommonLib/Version.hpp>
 #include <CommonLib/Entities/ChunkClassLibrary.hpp>
 #include <CommonLib/Scripting/MathScriptingLibrary.hpp>
 #include <CommonLib/Scripting/SharedScriptingLibrary.hpp>
 #include <ServerLib/ServerPlanetEnvironment.hpp>
+#include <ServerLib/ServerRecorder.hpp>
 #include <ServerLib/Scripting/ServerEntityScriptingLibrary.hpp>
 #include <ServerLib/Scripting/ServerScriptingLibrary.hpp>
 #include <Nazara/Core/ApplicationBase.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/TaskSchedulerAppComponent.hpp>
 #include <Nazara/Physics3D/Systems/Physics3DSystem.hpp>
 #include <fmt/color.h>
 #include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
 #include <memory>
 
 namespace tsom
 {
+	namespace
+	{
+		template<typename T, typename V>
+		void SendPlayerListPacket(NetworkSession& session, const T& packet, std::vector<V> T::* playerList)
+		{
+			if (session.GetProtocolVersion() >= BuildVersion(0, 7, 0))
+			{
+				session.SendPacket(packet);
+				return;
+			}
+
+			// Older clients expect one packet per player
+			T playerPacket;
+			for (const V& playerEntry : packet.*playerList)
+			{
+				(playerPacket.*playerList).assign(1, playerEntry);
+				session.SendPacket(playerPacket);
+			}
+		}
+	}
+
+	struct ServerInstance::NetworkStatisticsDump
+	{
+		static constexpr Nz::Time Timeout = Nz::Time::Seconds(1);
+
+		nlohmann::json doc;
+		std::filesystem::path filePath;
+		std::size_t pendingQueryCount;
+		Nz::MillisecondClock clock;
+	};
+
 	ServerInstance::ServerInstance(Nz::ApplicationBase& application, Config config) :
 	m_connectionTokenEncryptionKey(config.connectionTokenEncryptionKey),
+	m_maxInputBacklog(config.maxInputBacklog),
 	m_players(256),
 	m_saveInterval(config.saveInterval),
 	m_tickAccumulator(Nz::Time::Zero()),
 	m_tickDuration(Constants::TickDuration),
 	m_tickIndex(0),
+	m_chunkColliderDistance(config.chunkColliderDistance),
 	m_application(application),
 	m_scriptingContext(application),
+	m_parallelWorldUpdate(config.parallelWorldUpdate),
 	m_pauseWhenEmpty(config.pauseWhenEmpty)
 	{
 		m_entityRegistry.RegisterClassLibrary<ChunkClassLibrary>(m_application, m_blockLibrary);
 
+		// Abort entity callbacks before a runaway script stalls the whole tick
+		m_scriptingContext.GetProfiler().SetCallbackBudget(config.scriptCallbackBudget);
+
 		m_scriptingContext.RegisterLibrary<MathScriptingLibrary>();
 		m_scriptingContext.RegisterLibrary<SharedScriptingLibrary>();
-		ServerEntityScriptingLibrary& entityScriptingLibrary = m_scriptingContext.RegisterLibrary<ServerEntityScriptingLibrary>(m_entityRegistry);
+		ServerEntityScriptingLibrary& entityScriptingLibrary = m_scriptingContext.RegisterLibrary<ServerEntityScriptingLibrary>(m_entityRegistry, m_scriptingContext.GetProfiler(), m_scriptingContext.GetScheduler());
 		m_scriptingContext.RegisterLibrary<ServerScriptingLibrary>(m_application, entityScriptingLibrary);
 
 		LoadScripts();
@@ -88,6 +134,10 @@ namespace tsom
 		ServerPlayer* player = m_players.Allocate(m_players.DeferConstruct, playerIndex);
 		std::construct_at(player, *this, Nz::SafeCast<PlayerIndex>(playerIndex), session, std::nullopt, std::move(nickname), 0);
 
+		m_playerByNickname.insert_or_assign(player->GetNickname(), Nz::SafeCast<PlayerIndex>(playerIndex));
+		if (session)
+			m_playerBySession.insert_or_assign(session, Nz::SafeCast<PlayerIndex>(playerIndex));
+
 		player->UpdateRootEnvironment(m_defaultSpawnpoint.env);
 		player->Respawn(m_defaultSpawnpoint.env, m_defaultSpawnpoint.position, m_defaultSpawnpoint.rotation);
 
@@ -131,6 +181,12 @@ namespace tsom
 		ServerPlayer* player = m_players.Allocate(m_players.DeferConstruct, playerIndex);
 		std::construct_at(player, *this, Nz::SafeCast<PlayerIndex>(playerIndex), session, uuid, std::move(nickname), permissions);
 
+		// A kicked player with the same uuid (and nickname) may still be alive until next poll, the new one takes over the indexes
+		m_playerByNickname.insert_or_assign(player->GetNickname(), Nz::SafeCast<PlayerIndex>(playerIndex));
+		m_playerByUuid.insert_or_assign(uuid, Nz::SafeCast<PlayerIndex>(playerIndex));
+		if (session)
+			m_playerBySession.insert_or_assign(session, Nz::SafeCast<PlayerIndex>(playerIndex));
+
 		player->UpdateRootEnvironment(m_defaultSpawnpoint.env);
 		player->Respawn(m_defaultSpawnpoint.env, m_defaultSpawnpoint.position, m_defaultSpawnpoint.rotation);
 
@@ -143,12 +199,71 @@ namespace tsom
 	{
 		ServerPlayer* player = m_players.RetrieveFromIndex(playerIndex);
 
+		auto RemoveFromIndex = [&](auto& playerIndices, const auto& key)
+		{
+			// Only remove the entry if it wasn't taken over by another player
+			if (auto it = playerIndices.find(key); it != playerIndices.end() && it->second == playerIndex)
+				playerIndices.erase(it);
+		};
+
+		RemoveFromIndex(m_playerByNickname, player->GetNickname());
+		if (const NetworkSession* session = player->GetSession())
+			RemoveFromIndex(m_playerBySession, session);
+		if (const auto& uuid = player->GetUuid())
+			RemoveFromIndex(m_playerByUuid, *uuid);
+
 		m_disconnectedPlayers.UnboundedSet(playerIndex);
 		m_newPlayers.UnboundedReset(playerIndex);
 
 		m_players.Free(playerIndex);
 	}
 
+	void ServerInstance::DumpNetworkStatistics(std::filesystem::path filePath)
+	{
+		std::shared_ptr<NetworkStatisticsDump> dump = std::make_shared<NetworkStatisticsDump>();
+		dump->filePath = std::move(filePath);
+		dump->doc["total"] = TakeNetworkStatisticsSnapshot().ToJson();
+		dump->doc["sessions"] = nlohmann::json::array();
+
+		std::vector<NetworkSession*> sessions;
+		ForEachPlayer([&](ServerPlayer& serverPlayer)
+		{
+			NetworkSession* session = serverPlayer.GetSession();
+			if (!session || !session->IsConnected())
+				return;
+
+			nlohmann::json sessionDoc = session->GetStatistics().TakeSnapshot().ToJson();
+			sessionDoc["nickname"] = serverPlayer.GetNickname();
+			sessionDoc["peerId"] = session->GetPeerId();
+
+			dump->doc["sessions"].push_back(std::move(sessionDoc));
+			sessions.push_back(session);
+		});
+
+		// Peer infos are queried from reactor threads and answered when polling session managers, the file is written from UpdateNetworkStatisticsDumps
+		dump->pendingQueryCount = sessions.size();
+		for (std::size_t i = 0; i < sessions.size(); ++i)
+		{
+			// If the peer disconnected meanwhile the callback is dropped without being called, the dump will time out
+			sessions[i]->QueryInfo([dump, i](NetworkReactor::PeerInfo& peerInfo)
+			{
+				nlohmann::json& peerDoc = dump->doc["sessions"][i]["peer"];
+				peerDoc["ping"] = peerInfo.ping;
+				peerDoc["timeSinceLastReceive"] = peerInfo.timeSinceLastReceive;
+				peerDoc["totalByteReceived"] = peerInfo.totalByteReceived;
+				peerDoc["totalByteSent"] = peerInfo.totalByteSent;
+				peerDoc["totalPacketLost"] = peerInfo.totalPacketLost;
+				peerDoc["totalPacketReceived"] = peerInfo.totalPacketReceived;
+				peerDoc["totalPacketSent"] = peerInfo.totalPacketSent;
+
+				assert(dump->pendingQueryCount > 0);
+				dump->pendingQueryCount--;
+			});
+		}
+
+		m_pendingNetworkStatisticsDumps.push_back(std::move(dump));
+	}
+
 	std::unique_ptr<Nz::EnttWorld> ServerInstance::RegisterEnvironment(ServerEnvironment* environment)
 	{
 		assert(std::find(m_environments.begin(), m_environments.end(), environment) == m_environments.end());
@@ -165,6 +280,26 @@ namespace tsom
 			return std::make_unique<Nz::EnttWorld>();
 	}
 
+	void ServerInstance::ResetNetworkStatistics()
+	{
+		for (auto&& sessionManagerPtr : m_sessionManagers)
+			sessionManagerPtr->ResetStatistics();
+	}
+
+	void ServerInstance::SetRecorder(std::unique_ptr<ServerRecorder> recorder)
+	{
+		m_recorder = std::move(recorder);
+	}
+
+	NetworkStatistics::Snapshot ServerInstance::TakeNetworkStatisticsSnapshot() const
+	{
+		NetworkStatistics::Snapshot snapshot;
+		for (auto&& sessionManagerPtr : m_sessionManagers)
+			snapshot.Merge(sessionManagerPtr->TakeStatisticsSnapshot());
+
+		return snapshot;
+	}
+
 	void ServerInstance::UnregisterEnvironment(ServerEnvironment* environment, std::unique_ptr<Nz::EnttWorld>&& world)
 	{
 		auto it = std::find(m_environments.begin(), m_environments.end(), environment);
@@ -179,8 +314,14 @@ namespace tsom
 		if (m_saveClock.RestartIfOver(m_saveInterval))
 			OnSave();
 
-		for (auto&& sessionManagerPtr : m_sessionManagers)
-			sessionManagerPtr->Poll();
+		{
+			TickProfiler::Zone zone("NetworkSessionManager::Poll");
+			for (auto&& sessionManagerPtr : m_sessionManagers)
+				sessionManagerPtr->Poll();
+		}
+
+		if (!m_pendingNetworkStatisticsDumps.empty())
+			UpdateNetworkStatisticsDumps();
 
 		// No player? Pause instance for 100ms
 		if (m_pauseWhenEmpty && m_players.begin() == m_players.end())
@@ -217,26 +358,25 @@ namespace tsom
 	void ServerInstance::OnNetworkTick()
 	{
 		// Handle disconnected players
-		for (std::size_t playerIndex : m_disconnectedPlayers.IterBits())
+		if (m_disconnectedPlayers.TestAny())
 		{
 			Packets::PlayerLeave playerLeave;
-			playerLeave.index = Nz::SafeCast<PlayerIndex>(playerIndex);
+			for (std::size_t playerIndex : m_disconnectedPlayers.IterBits())
+				playerLeave.indices.push_back(Nz::SafeCast<PlayerIndex>(playerIndex));
 
 			ForEachPlayer([&](ServerPlayer& serverPlayer)
 			{
 				if (NetworkSession* session = serverPlayer.GetSession())
-					session->SendPacket(playerLeave);
+					SendPlayerListPacket(*session, playerLeave, &Packets::PlayerLeave::indices);
 			});
 
-			for (auto it = m_pendingPlayerRename.begin(); it != m_pendingPlayerRename.end();)
+			std::erase_if(m_pendingPlayerRename, [&](const PlayerRename& playerRename)
 			{
-				if (it->playerIndex == playerLeave.index)
-					it = m_pendingPlayerRename.erase(it);
-				else
-					++it;
-			}
+				return m_disconnectedPlayers.UnboundedTest(playerRename.playerIndex);
+			});
+
+			m_disconnectedPlayers.Clear();
 		}
-		m_disconnectedPlayers.Clear();
 
 		// Handle renaming
 		for (auto&& [playerIndex, newNickname] : m_pendingPlayerRename)
@@ -254,45 +394,48 @@ namespace tsom
 		m_pendingPlayerRename.clear();
 
 		// Handle newly connected players
-		for (std::size_t playerIndex : m_newPlayers.IterBits())
+		if (m_newPlayers.TestAny())
 		{
-			ServerPlayer* player = m_players.RetrieveFromIndex(playerIndex);
+			// Tell existing players who just arrived
+			Packets::PlayerJoin playerJoin;
+			for (std::size_t playerIndex : m_newPlayers.IterBits())
+			{
+				ServerPlayer* player = m_players.RetrieveFromIndex(playerIndex);
+
+				auto& playerData = playerJoin.players.emplace_back();
+				playerData.index = Nz::SafeCast<PlayerIndex>(playerIndex);
+				playerData.nickname = player->GetNickname();
+				playerData.isAuthenticated = player->IsAuthenticated();
+			}
 
-			// Send a packet to existing players telling them someone just arrived
-			Packets::PlayerJoin playerJoined;
-			playerJoined.index = Nz::SafeCast<PlayerIndex>(playerIndex);
-			playerJoined.nickname = player->GetNickname();
-			playerJoined.isAuthenticated = player->IsAuthenticated();
+			// Tell new players about everyone (including themselves)
+			Packets::GameData gameData;
+			gameData.tickIndex = m_tickIndex;
 
 			ForEachPlayer([&](ServerPlayer& serverPlayer)
 			{
-				// Don't send this to player connecting
-				if (m_newPlayers.UnboundedTest(serverPlayer.GetPlayerIndex()))
-					return;
-
-				if (NetworkSession* session = serverPlayer.GetSession())
-					session->SendPacket(playerJoined);
+				auto& playerData = gameData.players.emplace_back();
+				playerData.index = Nz::SafeCast<PlayerIndex>(serverPlayer.GetPlayerIndex());
+				playerData.nickname = serverPlayer.GetNickname();
+				playerData.isAuthenticated = serverPlayer.IsAuthenticated();
 			});
 
-			// Send a packet to the new player containing all existing players
-			if (NetworkSession* session = player->GetSession())
+			ForEachPlayer([&](ServerPlayer& serverPlayer)
 			{
-				Packets::GameData gameData;
-				gameData.tickIndex = m_tickIndex;
+				NetworkSession* session = serverPlayer.GetSession();
+				if (!session)
+					return;
 
-				ForEachPlayer([&](ServerPlayer& serverPlayer)
-				{
-					auto& playerData = gameData.players.emplace_back();
-					playerData.index = Nz::SafeCast<PlayerIndex>(serverPlayer.GetPlayerIndex());
-					playerData.nickname = serverPlayer.GetNickname();
-					playerData.isAuthenticated = serverPlayer.IsAuthenticated();
-				});
+				if (m_newPlayers.UnboundedTest(serverPlayer.GetPlayerIndex()))
+					session->SendPacket(gameData);
+				else
+					SendPlayerListPacket(*session, playerJoin, &Packets::PlayerJoin::players);
+			});
 
-				session->SendPacket(gameData);
-			}
+			m_newPlayers.Clear();
 		}
-		m_newPlayers.Clear();
 
+		TickProfiler::Zone zone("SessionVisibilityHandler::Dispatch");
 		ForEachPlayer([&](ServerPlayer& serverPlayer)
 		{
 			serverPlayer.GetVisibilityHandler().Dispatch(m_tickIndex);
@@ -307,16 +450,157 @@ namespace tsom
 
 	void ServerInstance::OnTick(Nz::Time elapsedTime)
 	{
+		TickProfiler::Zone tickZone("ServerInstance::OnTick");
+
 		m_tickIndex++;
 
+		if (m_recorder)
+			m_recorder->OnTick();
+
+		{
+			TickProfiler::Zone zone("ServerPlayer::Tick");
+			ForEachPlayer([&](ServerPlayer& serverPlayer)
+			{
+				serverPlayer.Tick();
+			});
+		}
+
+		{
+			TickProfiler::Zone zone("ServerEnvironment::OnTick");
+			for (ServerEnvironment* env : m_environments)
+				env->OnTick(elapsedTime);
+		}
+
+		{
+			TickProfiler::Zone zone("ServerInstance::UpdateEnvironmentWorlds");
+			UpdateEnvironmentWorlds(elapsedTime);
+		}
+
+		{
+			TickProfiler::Zone zone("ServerEnvironment::FlushSerializedCallbacks");
+
+			// Apply cross-environment effects in a deterministic order (environments may be created by those)
+			for (std::size_t i = 0; i < m_environments.size(); ++i)
+				m_environments[i]->FlushSerializedCallbacks();
+		}
+
+		{
+			TickProfiler::Zone zone("ScriptScheduler::Tick");
+
+			// Wake up script timers and coroutines due this tick, on the tick thread as the Lua state isn't thread-safe
+			m_scriptingContext.GetScheduler().Tick();
+		}
+
+		TickProfiler::Zone zone("ServerInstance::OnNetworkTick");
+		OnNetworkTick();
+	}
+
+	void ServerInstance::UpdateEnvironmentWorlds(Nz::Time elapsedTime)
+	{
+		if (!m_parallelWorldUpdate || m_environments.size() <= 1)
+		{
+			for (ServerEnvironment* env : m_environments)
+				env->UpdateWorld(elapsedTime);
+
+			return;
+		}
+
+		// Environments can be updated concurrently unless a player acts on a physics world from another one (e.g. piloting a ship from the inside)
+		m_environmentGroupBuilder.Begin(m_environments.size());
+
+		auto GetEnvironmentIndex = [&](const ServerEnvironment* environment)
+		{
+			return static_cast<std::size_t>(std::distance(m_environments.begin(), std::find(m_environments.begin(), m_environments.end(), environment)));
+		};
+
 		ForEachPlayer([&](ServerPlayer& serverPlayer)
 		{
-			serverPlayer.Tick();
+			ServerEnvironment* controlledEnvironment = serverPlayer.GetControlledEntityEnvironment();
+			const std::shared_ptr<CharacterController>& characterController = serverPlayer.GetCharacterController();
+			if (!controlledEnvironment || !characterController)
+				return;
+
+			const std::shared_ptr<ShipController>& shipController = characterController->GetShipController();
+			if (!shipController)
+				return;
+
+			entt::handle shipEntity = shipController->GetEntity();
+			if (!shipEntity)
+				return;
+
+			ServerEnvironment* shipEnvironment = shipEntity.registry()->ctx().get<ServerEnvironment*>();
+			if (shipEnvironment == controlledEnvironment)
+				return;
+
+			m_environmentGroupBuilder.Link(GetEnvironmentIndex(controlledEnvironment), GetEnvironmentIndex(shipEnvironment));
 		});
 
-		for (ServerEnvironment* env : m_environments)
-			env->OnTick(elapsedTime);
+		std::size_t groupCount = m_environmentGroupBuilder.Build();
 
-		OnNetworkTick();
+		struct GroupUpdate
+		{
+			std::atomic_size_t nextGroupIndex = 0;
+			std::atomic_size_t remainingGroupCount;
+		};
+
+		// Workers may only get to run their task once every group has been updated, keep the counters alive until then
+		auto groupUpdate = std::make_shared<GroupUpdate>();
+		groupUpdate->remainingGroupCount = groupCount;
+
+		auto UpdateGroups = [this, elapsedTime, groupCount, groupUpdate]
+		{
+			std::size_t groupIndex;
+			while ((groupIndex = groupUpdate->nextGroupIndex.fetch_add(1)) < groupCount)
+			{
+				for (std::size_t envIndex : m_environmentGroupBuilder.GetGroup(groupIndex))
+					m_environments[envIndex]->UpdateWorld(elapsedTime);
+
+				if (groupUpdate->remainingGroupCount.fetch_sub(1) == 1)
+					groupUpdate->remainingGroupCount.notify_all();
+			}
+		};
+
+		auto& taskScheduler = m_application.GetComponent<Nz::TaskSchedulerAppComponent>();
+		for (std::size_t i = 1; i < groupCount; ++i)
+			taskScheduler.AddTask(UpdateGroups);
+
+		// The tick thread claims groups too, so it only ever waits on groups a worker is already updating
+		UpdateGroups();
+
+		std::size_t remainingGroupCount;
+		while ((remainingGroupCount = groupUpdate->remainingGroupCount.load()) > 0)
+			groupUpdate->remainingGroupCount.wait(remainingGroupCount);
+	}
+
+	void ServerInstance::UpdateNetworkStatisticsDumps()
+	{
+		auto it = std::remove_if(m_pendingNetworkStatisticsDumps.begin(), m_pendingNetworkStatisticsDumps.end(), [](const std::shared_ptr<NetworkStatisticsDump>& dump)
+		{
+			if (dump->pendingQueryCount > 0)
+			{
+				if (dump->clock.GetElapsedTime() < NetworkStatisticsDump::Timeout)
+					return false;
+
+				fmt::print(fg(fmt::color::yellow), "{} peer(s) didn't answer in time, their network statistics will be incomplete\n", dump->pendingQueryCount);
+			}
+
+			std::string content = dump->doc.dump(1, '\t');
+			if (Nz::File::WriteWhole(dump->filePath, content.data(), content.size()))
+				fmt::print("network statistics written to {}\n", Nz::PathToString(dump->filePath));
+			else
+				fmt::print(fg(fmt::color::red), "failed to write network statistics to {}\n", Nz::PathToString(dump->filePath));
+
+			return true;
+		});
+		m_pendingNetworkStatisticsDumps.erase(it, m_pendingNetworkStatisticsDumps.end());
+	}
+
+	void ServerInstance::UpdatePlayerNickname(ServerPlayer& player, std::string_view previousNickname)
+	{
+		PlayerIndex playerIndex = player.GetPlayerIndex();
+		if (auto it = m_playerByNickname.find(previousNickname); it != m_playerByNickname.end() && it->second == playerIndex)
+			m_playerByNickname.erase(it);
+
+		m_playerByNickname.insert_or_assign(player.GetNickname(), playerIndex);
 	}
 }
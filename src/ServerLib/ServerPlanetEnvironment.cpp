@@ -8,7 +8,6 @@
 #include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <CommonLib/Components/PlanetComponent.hpp>
 #include <CommonLib/Systems/GravityPhysicsSystem.hpp>
-#include <CommonLib/Systems/PlanetSystem.hpp>
 #include <ServerLib/ServerInstance.hpp>
 #include <ServerLib/Components/NetworkedComponent.hpp>
 #include <ServerLib/Systems/EnvironmentSwitchSystem.hpp>
@@ -56,6 +55,10 @@ namespace tsom
 		auto& taskScheduler = app.GetComponent<Nz::TaskSchedulerAppComponent>();
 
 		auto& planetComponent = m_planetEntity.get<PlanetComponent>();
+
+		// Only build colliders for chunks close to dynamic bodies
+		planetComponent.planetEntities->SetColliderActivationDistance(serverInstance.GetChunkColliderDistance());
+
 		planetComponent.planet->GenerateChunks(blockLibrary, taskScheduler, seed, chunkCount);
 		planetComponent.planet->GeneratePlatform(blockLibrary, tsom::Direction::Right, { 65, -18, -39 });
 		planetComponent.planet->GeneratePlatform(blockLibrary, tsom::Direction::Back, { -34, 2, 53 });
@@ -72,7 +75,6 @@ namespace tsom
 
 		auto& physicsSystem = m_world->GetSystem<Nz::Physics3DSystem>();
 		m_world->AddSystem<GravityPhysicsSystem>(*planetComponent.planet, physicsSystem.GetPhysWorld());
-		m_world->AddSystem<PlanetSystem>();
 	}
 
 	ServerPlanetEnvironment::~ServerPlanetEnvironment()
@@ -129,6 +131,13 @@ namespace tsom
 		Nz::File::WriteWhole(m_savePath / Nz::Utf8Path("version.txt"), version.data(), version.size());
 	}
 
+	void ServerPlanetEnvironment::OnTick(Nz::Time elapsedTime)
+	{
+		m_planetEntity.get<PlanetComponent>().planetEntities->Update();
+
+		ServerEnvironment::OnTick(elapsedTime);
+	}
+
 	void ServerPlanetEnvironment::LoadFromDirectory()
 	{
 		if (!std::filesystem::is_directory(m_savePath))
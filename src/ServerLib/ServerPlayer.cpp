@@ -16,9 +16,52 @@
 #include <Nazara/Core/Components/NodeComponent.hpp>
 #include <Nazara/Physics3D/Systems/Physics3DSystem.hpp>
 #include <cassert>
+#include <type_traits>
+#include <utility>
 
 namespace tsom
 {
+	namespace
+	{
+		// Merges nextInputs into inputs as if both were applied during the same tick
+		void CoalesceInputs(PlayerInputs& inputs, const PlayerInputs& nextInputs)
+		{
+			inputs.index = nextInputs.index;
+
+			if (inputs.data.index() != nextInputs.data.index())
+			{
+				// Controlled entity changed in-between, older inputs don't make sense anymore
+				inputs.data = nextInputs.data;
+				return;
+			}
+
+			std::visit([&](auto& data)
+			{
+				using T = std::decay_t<decltype(data)>;
+				if constexpr (!std::is_same_v<T, std::monostate>)
+				{
+					const T& nextData = std::get<T>(nextInputs.data);
+
+					// Rotations are deltas and must be accumulated, held keys are taken from the most recent inputs
+					Nz::RadianAnglef pitch = data.pitch + nextData.pitch;
+					Nz::RadianAnglef yaw = data.yaw + nextData.yaw;
+
+					if constexpr (std::is_same_v<T, PlayerInputs::Character>)
+					{
+						bool jump = data.jump; //< don't lose jumps
+						data = nextData;
+						data.jump |= jump;
+					}
+					else
+						data = nextData;
+
+					data.pitch = pitch;
+					data.yaw = yaw;
+				}
+			}, inputs.data);
+		}
+	}
+
 	ServerPlayer::ServerPlayer(ServerInstance& instance, PlayerIndex playerIndex, NetworkSession* session, const std::optional<Nz::Uuid>& uuid, std::string nickname, PlayerPermissionFlags permissions) :
 	m_uuid(uuid),
 	m_nickname(std::move(nickname)),
@@ -135,7 +178,16 @@ namespace tsom
 
 	void ServerPlayer::PushInputs(const PlayerInputs& inputs)
 	{
-		m_inputQueue.push_back(inputs);
+		if (!m_inputQueue.IsEmpty() && !IsInputMoreRecent(inputs.index, m_inputQueue.Back().index))
+			return; //< duplicate or outdated inputs
+
+		if (m_inputQueue.IsFull())
+		{
+			CoalesceInputs(m_inputQueue.Back(), inputs);
+			return;
+		}
+
+		m_inputQueue.PushBack(inputs);
 	}
 
 	void ServerPlayer::RemoveFromEnvironment(ServerEnvironment* environment)
@@ -195,17 +247,20 @@ namespace tsom
 
 	void ServerPlayer::Tick()
 	{
-		if (!m_inputQueue.empty())
-		{
-			const PlayerInputs& inputs = m_inputQueue.front();
+		if (m_inputQueue.IsEmpty())
+			return;
 
-			m_visibilityHandler.UpdateLastInputIndex(inputs.index);
+		PlayerInputs inputs = m_inputQueue.PopFront();
 
-			if (m_controller)
-				m_controller->SetInputs(inputs);
+		// A client falling behind would otherwise see its latency grow with its backlog, catch up by merging the stale inputs into this tick
+		std::size_t maxInputBacklog = m_serverInstance.GetMaxInputBacklog();
+		while (m_inputQueue.GetSize() > maxInputBacklog)
+			CoalesceInputs(inputs, m_inputQueue.PopFront());
 
-			m_inputQueue.erase(m_inputQueue.begin());
-		}
+		m_visibilityHandler.UpdateLastInputIndex(inputs.index);
+
+		if (m_controller)
+			m_controller->SetInputs(inputs);
 	}
 
 	std::string ServerPlayer::ToString() const
@@ -262,6 +317,7 @@ namespace tsom
 
 	void ServerPlayer::UpdateNickname(std::string nickname)
 	{
-		m_nickname = std::move(nickname);
+		std::string previousNickname = std::exchange(m_nickname, std::move(nickname));
+		m_serverInstance.UpdatePlayerNickname(*this, previousNickname);
 	}
 }
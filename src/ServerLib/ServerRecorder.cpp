@@ -0,0 +1,140 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <ServerLib/ServerRecorder.hpp>
+#include <CommonLib/Version.hpp>
+#include <CommonLib/Protocol/CompressedInteger.hpp>
+#include <ServerLib/ServerPlayer.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <NazaraUtils/PathUtils.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace tsom
+{
+	ServerRecorder::ServerRecorder(const std::filesystem::path& filePath, Nz::UInt32 seed, const std::filesystem::path& saveDirectory) :
+	m_bufferStream(&m_buffer, Nz::OpenMode::Write),
+	m_file(filePath, Nz::OpenMode::Write | Nz::OpenMode::Truncate),
+	m_lastEventTick(0),
+	m_tickCount(0)
+	{
+		if (!m_file.IsOpen())
+			throw std::runtime_error(fmt::format("failed to open {}", Nz::PathToString(filePath)));
+
+		m_bufferStream << FileMagic << FileVersion << GameVersion << seed;
+
+		// The server keeps saving over its save directory, embed it as it was when the recording started
+		std::vector<std::filesystem::path> saveFiles;
+		if (std::filesystem::is_directory(saveDirectory))
+		{
+			for (const auto& entry : std::filesystem::directory_iterator(saveDirectory))
+			{
+				if (entry.is_regular_file())
+					saveFiles.push_back(entry.path());
+			}
+
+			// Keep recordings of the same save identical
+			std::sort(saveFiles.begin(), saveFiles.end());
+		}
+
+		m_bufferStream << CompressedUnsigned<Nz::UInt32>(Nz::SafeCaster(saveFiles.size()));
+		for (const std::filesystem::path& saveFile : saveFiles)
+		{
+			std::optional<std::vector<Nz::UInt8>> content = Nz::File::ReadWhole(saveFile);
+			if (!content)
+				throw std::runtime_error(fmt::format("failed to read save file {}", Nz::PathToString(saveFile)));
+
+			m_bufferStream << Nz::PathToString(saveFile.filename());
+			m_bufferStream << CompressedUnsigned<Nz::UInt32>(Nz::SafeCaster(content->size()));
+			m_bufferStream.Write(content->data(), content->size());
+		}
+
+		Flush();
+
+		fmt::print("recording server to {} ({} save files)\n", Nz::PathToString(filePath), saveFiles.size());
+	}
+
+	ServerRecorder::~ServerRecorder()
+	{
+		// Trailing ticks without any event are replayed as well
+		BeginEvent(EventType::End, 0);
+		Flush();
+	}
+
+	void ServerRecorder::Flush()
+	{
+		if (m_buffer.IsEmpty())
+			return;
+
+		if (m_file.Write(m_buffer.GetConstBuffer(), m_buffer.GetSize()) != m_buffer.GetSize())
+			fmt::print(fg(fmt::color::red), "failed to write server recording\n");
+
+		m_file.Flush();
+
+		m_buffer.Clear();
+		m_bufferStream.GetStream()->SetCursorPos(0);
+
+		m_flushClock.Restart();
+	}
+
+	void ServerRecorder::OnTick()
+	{
+		// Writing to the file every tick is too costly, but a crashing server should still leave a usable recording
+		if (m_buffer.GetSize() >= FlushSize || m_flushClock.GetElapsedTime() >= FlushInterval)
+			Flush();
+
+		m_tickCount++;
+	}
+
+	void ServerRecorder::RecordPacket(std::size_t peerId, const Nz::ByteArray& packet)
+	{
+		BeginEvent(EventType::Packet, peerId);
+		m_bufferStream << CompressedUnsigned<Nz::UInt32>(Nz::SafeCaster(packet.GetSize()));
+		m_bufferStream.Write(packet.GetConstBuffer(), packet.GetSize());
+	}
+
+	void ServerRecorder::RecordPlayerJoin(std::size_t peerId, const ServerPlayer& player, Nz::UInt32 protocolVersion)
+	{
+		// Connection tokens expire, store what the server extracted from them instead of the auth request
+		RecordPlayerJoin(peerId, player.GetNickname(), player.GetUuid(), player.GetPermissions(), protocolVersion);
+	}
+
+	void ServerRecorder::RecordPlayerJoin(std::size_t peerId, const std::string& nickname, const std::optional<Nz::Uuid>& uuid, PlayerPermissionFlags permissions, Nz::UInt32 protocolVersion)
+	{
+		BeginEvent(EventType::PlayerJoin, peerId);
+		m_bufferStream << CompressedUnsigned<Nz::UInt32>(protocolVersion);
+		m_bufferStream << nickname;
+
+		m_bufferStream << Nz::UInt8((uuid.has_value()) ? 1 : 0);
+		if (uuid)
+			m_bufferStream << *uuid;
+
+		Nz::UInt8 permissionMask = 0;
+		for (std::size_t i = 0; i <= static_cast<std::size_t>(PlayerPermission::Max); ++i)
+		{
+			if (permissions.Test(static_cast<PlayerPermission>(i)))
+				permissionMask |= Nz::UInt8(1u << i);
+		}
+
+		m_bufferStream << permissionMask;
+	}
+
+	void ServerRecorder::RecordPlayerLeave(std::size_t peerId)
+	{
+		BeginEvent(EventType::PlayerLeave, peerId);
+	}
+
+	void ServerRecorder::BeginEvent(EventType eventType, std::size_t peerId)
+	{
+		// Ticks are stored relative to the previous event, most events happen in the same tick or close to it
+		m_bufferStream << static_cast<Nz::UInt8>(eventType);
+		m_bufferStream << CompressedUnsigned<Nz::UInt64>(m_tickCount - m_lastEventTick);
+		m_bufferStream << CompressedUnsigned<Nz::UInt32>(Nz::SafeCaster(peerId));
+
+		m_lastEventTick = m_tickCount;
+	}
+}
@@ -0,0 +1,164 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <ServerLib/ServerRecordingReader.hpp>
+#include <CommonLib/Version.hpp>
+#include <CommonLib/Protocol/CompressedInteger.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/File.hpp>
+#include <NazaraUtils/PathUtils.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#include <stdexcept>
+
+namespace tsom
+{
+	ServerRecordingReader::ServerRecordingReader(const std::filesystem::path& filePath) :
+	m_seed(0),
+	m_lastEventTick(0)
+	{
+		std::optional<std::vector<Nz::UInt8>> content = Nz::File::ReadWhole(filePath);
+		if (!content)
+			throw std::runtime_error(fmt::format("failed to read {}", Nz::PathToString(filePath)));
+
+		m_content = std::move(*content);
+		m_stream.emplace(m_content.data(), m_content.size());
+
+		Nz::ErrorFlags errFlags(Nz::ErrorMode::Silent | Nz::ErrorMode::ThrowException);
+
+		Nz::UInt32 magic;
+		Nz::UInt16 fileVersion;
+		*m_stream >> magic >> fileVersion;
+
+		if (magic != ServerRecorder::FileMagic)
+			throw std::runtime_error(fmt::format("{} is not a server recording", Nz::PathToString(filePath)));
+
+		if (fileVersion > ServerRecorder::FileVersion)
+			throw std::runtime_error(fmt::format("unsupported recording version {}", fileVersion));
+
+		Nz::UInt32 gameVersion;
+		*m_stream >> gameVersion >> m_seed;
+
+		if (gameVersion != GameVersion)
+		{
+			std::uint32_t majorVersion, minorVersion, patchVersion;
+			DecodeVersion(gameVersion, majorVersion, minorVersion, patchVersion);
+
+			fmt::print(fg(fmt::color::yellow), "recording was made with version {}.{}.{}, replay may diverge\n", majorVersion, minorVersion, patchVersion);
+		}
+
+		CompressedUnsigned<Nz::UInt32> saveFileCount;
+		*m_stream >> saveFileCount;
+
+		m_saveFiles.reserve(saveFileCount);
+		for (Nz::UInt32 i = 0; i < saveFileCount; ++i)
+		{
+			CompressedUnsigned<Nz::UInt32> fileSize;
+
+			SaveFile& saveFile = m_saveFiles.emplace_back();
+			*m_stream >> saveFile.filename >> fileSize;
+
+			saveFile.offset = m_stream->GetStream()->GetCursorPos();
+			saveFile.size = fileSize;
+			if (saveFile.offset + saveFile.size > m_content.size())
+				throw std::runtime_error("recording is truncated");
+
+			m_stream->GetStream()->SetCursorPos(saveFile.offset + saveFile.size);
+		}
+	}
+
+	bool ServerRecordingReader::ExtractSaveFiles(const std::filesystem::path& directory) const
+	{
+		std::filesystem::create_directories(directory);
+
+		for (const SaveFile& saveFile : m_saveFiles)
+		{
+			// Don't let a recording write outside of the directory
+			std::filesystem::path filePath = directory / Nz::Utf8Path(saveFile.filename).filename();
+			if (!Nz::File::WriteWhole(filePath, m_content.data() + saveFile.offset, saveFile.size))
+			{
+				fmt::print(fg(fmt::color::red), "failed to extract {}\n", Nz::PathToString(filePath));
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void ServerRecordingReader::ReadEvent(Event& event)
+	{
+		// A crashed server doesn't get to record the end of the session, stop after the last event
+		if (m_stream->GetStream()->EndOfStream())
+		{
+			event.type = ServerRecorder::EventType::End;
+			event.tick = m_lastEventTick;
+			event.peerId = 0;
+			return;
+		}
+
+		Nz::ErrorFlags errFlags(Nz::ErrorMode::Silent | Nz::ErrorMode::ThrowException);
+
+		Nz::UInt8 eventType;
+		CompressedUnsigned<Nz::UInt64> tickDelta;
+		CompressedUnsigned<Nz::UInt32> peerId;
+		*m_stream >> eventType >> tickDelta >> peerId;
+
+		if (eventType > static_cast<Nz::UInt8>(ServerRecorder::EventType::PlayerLeave))
+			throw std::runtime_error(fmt::format("unknown event type {}", +eventType));
+
+		m_lastEventTick += tickDelta;
+
+		event.type = static_cast<ServerRecorder::EventType>(eventType);
+		event.tick = m_lastEventTick;
+		event.peerId = peerId;
+
+		switch (event.type)
+		{
+			case ServerRecorder::EventType::End:
+			case ServerRecorder::EventType::PlayerLeave:
+				break;
+
+			case ServerRecorder::EventType::Packet:
+			{
+				CompressedUnsigned<Nz::UInt32> packetSize;
+				*m_stream >> packetSize;
+
+				std::size_t offset = m_stream->GetStream()->GetCursorPos();
+				if (offset + packetSize > m_content.size())
+					throw std::runtime_error("recording is truncated");
+
+				event.packet = Nz::ByteArray(m_content.data() + offset, packetSize);
+				m_stream->GetStream()->SetCursorPos(offset + packetSize);
+				break;
+			}
+
+			case ServerRecorder::EventType::PlayerJoin:
+			{
+				CompressedUnsigned<Nz::UInt32> protocolVersion;
+				Nz::UInt8 hasUuid;
+				*m_stream >> protocolVersion >> event.nickname >> hasUuid;
+
+				event.protocolVersion = protocolVersion;
+
+				event.uuid.reset();
+				if (hasUuid)
+					*m_stream >> event.uuid.emplace();
+
+				Nz::UInt8 permissionMask;
+				*m_stream >> permissionMask;
+
+				PlayerPermissionFlags permissions;
+				for (std::size_t i = 0; i <= static_cast<std::size_t>(PlayerPermission::Max); ++i)
+				{
+					if (permissionMask & (1u << i))
+						permissions |= static_cast<PlayerPermission>(i);
+				}
+
+				event.permissions = permissions;
+
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,125 @@
+// Copyright (C) 2024 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "This Space Of Mine" project
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <ServerLib/ServerReplayer.hpp>
+#include <ServerLib/ServerInstance.hpp>
+#include <ServerLib/Session/PlayerSessionHandler.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace tsom
+{
+	ServerReplayer::ServerReplayer(const std::filesystem::path& filePath) :
+	m_replayedTickCount(0),
+	m_reader(filePath),
+	m_reactor(0, Nz::NetProtocol::IPv4, 0, MaxSession)
+	{
+		m_sessions.resize(MaxSession);
+
+		m_reader.ReadEvent(m_nextEvent);
+	}
+
+	bool ServerReplayer::ExtractSnapshot(const std::filesystem::path& directory) const
+	{
+		return m_reader.ExtractSaveFiles(directory);
+	}
+
+	bool ServerReplayer::Tick(ServerInstance& instance)
+	{
+		try
+		{
+			// Apply everything the server received before this tick started
+			while (m_nextEvent.type != ServerRecorder::EventType::End && m_nextEvent.tick <= m_replayedTickCount)
+			{
+				ApplyEvent(instance);
+				m_reader.ReadEvent(m_nextEvent);
+			}
+		}
+		catch (const std::exception& e)
+		{
+			fmt::print(fg(fmt::color::red), "failed to replay event at tick {}: {}\n", m_nextEvent.tick, e.what());
+
+			m_nextEvent.type = ServerRecorder::EventType::End;
+			m_nextEvent.tick = m_replayedTickCount;
+		}
+
+		if (m_nextEvent.type == ServerRecorder::EventType::End && m_replayedTickCount >= m_nextEvent.tick)
+			return false;
+
+		instance.OnTick(instance.GetTickDuration());
+		m_replayedTickCount++;
+
+		return true;
+	}
+
+	void ServerReplayer::ApplyEvent(ServerInstance& instance)
+	{
+		switch (m_nextEvent.type)
+		{
+			case ServerRecorder::EventType::End:
+				break;
+
+			case ServerRecorder::EventType::Packet:
+			{
+				auto it = m_sessionByPeerId.find(m_nextEvent.peerId);
+				if (it == m_sessionByPeerId.end())
+					break; //< player creation failed
+
+				m_sessions[it->second]->HandlePacket(std::move(m_nextEvent.packet));
+				break;
+			}
+
+			case ServerRecorder::EventType::PlayerJoin:
+			{
+				// Recorded peer ids depend on the reactor count of the server, replay sessions use their own indices
+				auto sessionIt = std::find_if(m_sessions.begin(), m_sessions.end(), [](const std::optional<NetworkSession>& session) { return !session.has_value(); });
+				if (sessionIt == m_sessions.end())
+					throw std::runtime_error("too many sessions");
+
+				std::size_t sessionIndex = static_cast<std::size_t>(std::distance(m_sessions.begin(), sessionIt));
+
+				NetworkSession& session = sessionIt->emplace(m_reactor, sessionIndex, Nz::IpAddress::LoopbackIpV4);
+				session.SetProtocolVersion(m_nextEvent.protocolVersion);
+
+				// Same as InitialSessionHandler
+				auto& stringStore = session.GetStringStore();
+				instance.GetEntityRegistry().ForEachClass([&](const std::string& className, const EntityClass& /*entityClass*/)
+				{
+					stringStore.RegisterString(className);
+				});
+
+				ServerPlayer* player;
+				if (m_nextEvent.uuid.has_value())
+					player = instance.CreateAuthenticatedPlayer(&session, *m_nextEvent.uuid, std::move(m_nextEvent.nickname), m_nextEvent.permissions);
+				else
+					player = instance.CreateAnonymousPlayer(&session, std::move(m_nextEvent.nickname));
+
+				if (!player)
+				{
+					fmt::print(fg(fmt::color::red), "failed to create player of peer {}\n", m_nextEvent.peerId);
+					sessionIt->reset();
+					break;
+				}
+
+				session.SetupHandler<PlayerSessionHandler>(player);
+
+				m_sessionByPeerId[m_nextEvent.peerId] = sessionIndex;
+				break;
+			}
+
+			case ServerRecorder::EventType::PlayerLeave:
+			{
+				auto it = m_sessionByPeerId.find(m_nextEvent.peerId);
+				if (it == m_sessionByPeerId.end())
+					break;
+
+				m_sessions[it->second].reset();
+				m_sessionByPeerId.erase(it);
+				break;
+			}
+		}
+	}
+}
@@ -4,11 +4,15 @@
 
 #include <ServerLib/ServerShipEnvironment.hpp>
 #include <CommonLib/ChunkEntities.hpp>
+#include <CommonLib/InternalConstants.hpp>
 #include <CommonLib/PhysicsConstants.hpp>
 #include <CommonLib/Ship.hpp>
+#include <CommonLib/TickProfiler.hpp>
 #include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <CommonLib/Components/ShipComponent.hpp>
-#include <CommonLib/Systems/ShipSystem.hpp>
+#include <CommonLib/Systems/GravityPhysicsSystem.hpp>
+#include <CommonLib/Utility/BinaryCompressor.hpp>
+#include <CommonLib/Utility/CompressionDictionary.hpp>
 #include <ServerLib/PlayerTokenAppComponent.hpp>
 #include <ServerLib/ServerInstance.hpp>
 #include <ServerLib/Components/EnvironmentEnterTriggerComponent.hpp>
@@ -40,7 +44,6 @@ namespace tsom
 		auto& app = serverInstance.GetApplication();
 		auto& blockLibrary = serverInstance.GetBlockLibrary();
 
-		m_world->AddSystem<ShipSystem>();
 		m_world->GetRegistry().ctx().emplace<ServerShipEnvironment*>(this);
 
 		m_shipEntity = CreateEntity();
@@ -55,6 +58,9 @@ namespace tsom
 		shipClass->ActivateEntity(m_shipEntity);
 
 		auto& shipComponent = m_shipEntity.get<ShipComponent>();
+
+		auto& physicsSystem = m_world->GetSystem<Nz::Physics3DSystem>();
+		m_world->AddSystem<GravityPhysicsSystem>(*shipComponent.ship, physicsSystem.GetPhysWorld());
 		shipComponent.ship->OnChunkAdded.Connect([this](ChunkContainer*, Chunk* chunk)
 		{
 			auto& chunkData = m_chunkData[chunk->GetIndices()];
@@ -186,6 +192,14 @@ namespace tsom
 			if (chunks.empty())
 				return Nz::Err("no chunk in ship save");
 
+			const CompressionDictionary* dictionary = nullptr;
+			if (Nz::UInt32 dictionaryId = data.value("chunk_dictionary", Nz::UInt32(0)); dictionaryId != 0)
+			{
+				dictionary = CompressionDictionary::Get(CompressionDictionaryType::ChunkSave);
+				if (!dictionary || dictionary->GetId() != dictionaryId)
+					return Nz::Err(fmt::format("ship was saved using chunk dictionary #{} which is not available", dictionaryId));
+			}
+
 			for (const nlohmann::json& chunkDoc : chunks)
 			{
 				ChunkIndices chunkIndices;
@@ -199,7 +213,7 @@ namespace tsom
 				using base64 = cppcodec::base64_rfc4648;
 				std::vector<Nz::UInt8> compressedData = base64::decode(chunkData);
 				std::vector<Nz::UInt8> decompressedData(chunkDataSize);
-				std::optional compressedDataOpt = binaryCompressor.Decompress(compressedData.data(), compressedData.size(), decompressedData.data(), decompressedData.size());
+				std::optional compressedDataOpt = binaryCompressor.Decompress(compressedData.data(), compressedData.size(), decompressedData.data(), decompressedData.size(), dictionary);
 				if (!compressedDataOpt)
 					return Nz::Err("chunk decompression failed");
 
@@ -227,6 +241,11 @@ namespace tsom
 
 		nlohmann::json chunks;
 
+		// Saves are not time-critical, favor compression ratio
+		CompressionSettings compressionSettings;
+		compressionSettings.dictionary = CompressionDictionary::Get(CompressionDictionaryType::ChunkSave);
+		compressionSettings.highCompressionLevel = Constants::ChunkSaveCompressionLevel;
+
 		BinaryCompressor& binaryCompressor = BinaryCompressor::GetThreadCompressor();
 		Nz::ByteArray byteArray;
 		GetShip().ForEachChunk([&](const ChunkIndices& chunkIndices, const Chunk& chunk)
@@ -240,7 +259,7 @@ namespace tsom
 			Nz::ByteStream byteStream(&byteArray);
 			chunk.Serialize(byteStream);
 
-			std::optional compressedDataOpt = binaryCompressor.Compress(byteArray.GetBuffer(), byteArray.GetSize());
+			std::optional compressedDataOpt = binaryCompressor.Compress(byteArray.GetBuffer(), byteArray.GetSize(), compressionSettings);
 			if NAZARA_UNLIKELY(!compressedDataOpt)
 				throw std::runtime_error("chunk compression failed");
 
@@ -254,6 +273,8 @@ namespace tsom
 		nlohmann::json shipData;
 		shipData["chunks"] = std::move(chunks);
 		shipData["version"] = Nz::UInt32(1);
+		if (compressionSettings.dictionary)
+			shipData["chunk_dictionary"] = compressionSettings.dictionary->GetId();
 
 		nlohmann::json body;
 		body["data"] = shipData.dump();
@@ -273,6 +294,8 @@ namespace tsom
 
 	void ServerShipEnvironment::OnTick(Nz::Time elapsedTime)
 	{
+		m_shipEntity.get<ShipComponent>().shipEntities->Update();
+
 		// Check and apply chunk areas update
 		for (auto it = m_areaUpdateJobs.begin(); it != m_areaUpdateJobs.end();)
 		{
@@ -389,11 +412,11 @@ namespace tsom
 			StartTriggerUpdate(*chunkPtr, chunkData.areas);
 		};
 
-		taskScheduler.AddTask([updateJob, chunkPtr = chunk.shared_from_this()]
+		taskScheduler.AddTask([updateJob, blocks = chunk.GetBlocks()]
 		{
-			chunkPtr->LockRead();
-			updateJob->chunkArea = GenerateChunkAreas(*chunkPtr, updateJob->isCancelled);
-			chunkPtr->UnlockRead();
+			TickProfiler::Zone zone("ServerShipEnvironment::GenerateChunkAreas");
+
+			updateJob->chunkArea = GenerateChunkAreas(*blocks, updateJob->isCancelled);
 
 			updateJob->isFinished = true;
 		});
@@ -451,10 +474,10 @@ namespace tsom
 
 		taskScheduler.AddTask([areaList, updateJob, chunkPtr = chunk.shared_from_this()]
 		{
-			chunkPtr->LockRead();
+			TickProfiler::Zone zone("ServerShipEnvironment::BuildTriggerCollider");
+
 			updateJob->collider = BuildTriggerCollider(*chunkPtr, *areaList, Nz::Vector3f::Zero(), updateJob->isCancelled);
 			updateJob->expandedCollider = BuildTriggerCollider(*chunkPtr, *areaList, Nz::Vector3f(chunkPtr->GetBlockSize() * 2.f), updateJob->isCancelled);
-			chunkPtr->UnlockRead();
 
 			updateJob->isFinished = true;
 		});
@@ -508,7 +531,7 @@ namespace tsom
 		rigidBody.SetMass(fullBlockCount);
 	}
 
-	auto ServerShipEnvironment::BuildArea(const Chunk& chunk, std::size_t firstBlockIndex, Nz::Bitset<Nz::UInt64>& remainingBlocks) -> Area
+	auto ServerShipEnvironment::BuildArea(const ChunkBlocks& blocks, std::size_t firstBlockIndex, Nz::Bitset<Nz::UInt64>& remainingBlocks) -> Area
 	{
 		Nz::Bitset<Nz::UInt64> areaBlocks(ShipChunkBlockCount, false);
 
@@ -524,20 +547,20 @@ namespace tsom
 
 			remainingBlocks[blockIndex] = false;
 
-			Nz::Vector3ui chunkSize = chunk.GetSize();
+			Nz::Vector3ui chunkSize = blocks.GetSize();
 
-			BlockIndex block = chunk.GetBlockContent(blockIndex);
+			BlockIndex block = blocks.GetBlockContent(blockIndex);
 			bool isEmpty = block == EmptyBlockIndex;
 
 			auto AddCandidateBlock = [&](const Nz::Vector3ui& blockIndices)
 			{
-				std::size_t blockIndex = chunk.GetBlockLocalIndex(blockIndices);
+				std::size_t blockIndex = blocks.GetBlockLocalIndex(blockIndices);
 				if (remainingBlocks[blockIndex])
 				{
 					if (!isEmpty)
 					{
 						// Non-empty blocks can look at other non-empty blocks
-						if (chunk.GetBlockContent(blockIndex) != EmptyBlockIndex)
+						if (blocks.GetBlockContent(blockIndex) != EmptyBlockIndex)
 							candidateBlocks.push_back(blockIndex);
 					}
 					else
@@ -545,7 +568,7 @@ namespace tsom
 				}
 			};
 
-			Nz::Vector3ui blockIndices = chunk.GetBlockLocalIndices(blockIndex);
+			Nz::Vector3ui blockIndices = blocks.GetBlockLocalIndices(blockIndex);
 			for (int zOffset = -1; zOffset <= 1; ++zOffset)
 			{
 				for (int yOffset = -1; yOffset <= 1; ++yOffset)
@@ -598,14 +621,14 @@ namespace tsom
 		return std::make_shared<Nz::CompoundCollider3D>(std::move(childColliders));
 	}
 
-	auto ServerShipEnvironment::GenerateChunkAreas(const Chunk& chunk, std::atomic_bool& isCancelled) -> std::shared_ptr<AreaList>
+	auto ServerShipEnvironment::GenerateChunkAreas(const ChunkBlocks& blocks, std::atomic_bool& isCancelled) -> std::shared_ptr<AreaList>
 	{
 		Nz::Bitset<Nz::UInt64> remainingBlocks(ShipChunkBlockCount, true);
 
 		// Find first candidate (= a random empty block)
 		auto FindFirstCandidate = [&]
 		{
-			const Nz::Bitset<Nz::UInt64>& collisionCellMask = chunk.GetCollisionCellMask();
+			const Nz::Bitset<Nz::UInt64>& collisionCellMask = blocks.GetCollisionCellMask();
 			for (std::size_t i = 0; i < collisionCellMask.GetBlockCount(); ++i)
 			{
 				Nz::UInt64 mask = collisionCellMask.GetBlock(i);
@@ -630,14 +653,14 @@ namespace tsom
 			if (isCancelled)
 				return {};
 
-			Area outside = BuildArea(chunk, firstCandidate, remainingBlocks);
+			Area outside = BuildArea(blocks, firstCandidate, remainingBlocks);
 
 			while (remainingBlocks.TestAny())
 			{
 				if (isCancelled)
 					return {};
 
-				chunkArea->areas.push_back(BuildArea(chunk, remainingBlocks.FindFirst(), remainingBlocks));
+				chunkArea->areas.push_back(BuildArea(blocks, remainingBlocks.FindFirst(), remainingBlocks));
 			}
 		}
 
@@ -10,14 +10,17 @@
 #include <CommonLib/PhysicsConstants.hpp>
 #include <CommonLib/Planet.hpp>
 #include <CommonLib/Ship.hpp>
+#include <CommonLib/TickProfiler.hpp>
 #include <CommonLib/Components/ChunkComponent.hpp>
 #include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <CommonLib/Components/PlanetComponent.hpp>
 #include <CommonLib/Components/ShipComponent.hpp>
+#include <CommonLib/Scripting/ScriptProfiler.hpp>
 #include <ServerLib/PlayerTokenAppComponent.hpp>
 #include <ServerLib/ServerEnvironment.hpp>
 #include <ServerLib/ServerInstance.hpp>
 #include <ServerLib/ServerPlanetEnvironment.hpp>
+#include <ServerLib/ServerRecorder.hpp>
 #include <ServerLib/ServerShipEnvironment.hpp>
 #include <ServerLib/Components/EnvironmentEnterTriggerComponent.hpp>
 #include <ServerLib/Components/EnvironmentProxyComponent.hpp>
@@ -44,6 +47,7 @@ namespace tsom
 		{ PacketIndex<Packets::DebugDrawLineList>,       { .channel = 0, .flags = Nz::ENetPacketFlag::Reliable } },
 		{ PacketIndex<Packets::EntitiesCreation>,        { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
 		{ PacketIndex<Packets::EntitiesDelete>,          { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
+		{ PacketIndex<Packets::EntitiesPropertyUpdate>,  { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
 		{ PacketIndex<Packets::EntitiesStateUpdate>,     { .channel = 1, .flags = Nz::ENetPacketFlag_Unreliable } },
 		{ PacketIndex<Packets::EntityEnvironmentUpdate>, { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
 		{ PacketIndex<Packets::EntityProcedureCall>,     { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
@@ -52,6 +56,7 @@ namespace tsom
 		{ PacketIndex<Packets::EnvironmentDestroy>,      { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
 		{ PacketIndex<Packets::EnvironmentUpdate>,       { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
 		{ PacketIndex<Packets::GameData>,                { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
+		{ PacketIndex<Packets::InputAck>,                { .channel = 1, .flags = Nz::ENetPacketFlag_Unreliable } },
 		{ PacketIndex<Packets::PlayerJoin>,              { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
 		{ PacketIndex<Packets::PlayerLeave>,             { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
 		{ PacketIndex<Packets::PlayerNameUpdate>,        { .channel = 1, .flags = Nz::ENetPacketFlag::Reliable } },
@@ -64,13 +69,27 @@ namespace tsom
 	{
 		SetupHandlerTable(this);
 		SetupAttributeTable(s_packetAttributes);
+
+		if (ServerRecorder* recorder = m_player->GetServerInstance().GetRecorder())
+			recorder->RecordPlayerJoin(session->GetPeerId(), *m_player, session->GetProtocolVersion());
 	}
 
 	PlayerSessionHandler::~PlayerSessionHandler()
 	{
+		if (ServerRecorder* recorder = m_player->GetServerInstance().GetRecorder())
+			recorder->RecordPlayerLeave(GetSession()->GetPeerId());
+
 		m_player->Destroy();
 	}
 
+	void PlayerSessionHandler::HandlePacket(Nz::ByteArray&& byteArray)
+	{
+		if (ServerRecorder* recorder = m_player->GetServerInstance().GetRecorder())
+			recorder->RecordPacket(GetSession()->GetPeerId(), byteArray);
+
+		SessionHandler::HandlePacket(std::move(byteArray));
+	}
+
 	void PlayerSessionHandler::HandlePacket(Packets::ExitShipControl&& exitShipControl)
 	{
 		m_player->GetCharacterController()->SetShipController(nullptr);
@@ -110,9 +129,7 @@ namespace tsom
 		if (!CheckCanMineBlock(chunk, voxelLoc))
 			return;
 
-		chunk->LockWrite();
 		chunk->UpdateBlock(voxelLoc, EmptyBlockIndex);
-		chunk->UnlockWrite();
 	}
 
 	void PlayerSessionHandler::HandlePacket(Packets::PlaceBlock&& placeBlock)
@@ -131,9 +148,7 @@ namespace tsom
 		if (!CheckCanPlaceBlock(environment, chunk, voxelLoc))
 			return;
 
-		chunk->LockWrite();
 		chunk->UpdateBlock(voxelLoc, static_cast<BlockIndex>(placeBlock.newContent));
-		chunk->UnlockWrite();
 	}
 
 	void PlayerSessionHandler::HandlePacket(Packets::SendChatMessage&& playerChat)
@@ -292,6 +307,55 @@ namespace tsom
 			}
 			return;
 		}
+		else if ((message == "/scriptstats" || message == "/scriptstats reset") && m_player->HasPermission(PlayerPermission::Admin))
+		{
+			ScriptProfiler& scriptProfiler = m_player->GetServerInstance().GetScriptingContext().GetProfiler();
+			if (message == "/scriptstats reset")
+			{
+				scriptProfiler.ResetStats();
+				m_player->SendChatMessage("script stats reset");
+				return;
+			}
+
+			SendReport(scriptProfiler.BuildReport());
+			return;
+		}
+		else if ((message == "/netstats" || message == "/netstats dump" || message == "/netstats reset") && m_player->HasPermission(PlayerPermission::Admin))
+		{
+			ServerInstance& serverInstance = m_player->GetServerInstance();
+			if (message == "/netstats dump")
+			{
+				serverInstance.DumpNetworkStatistics("netstats.json");
+				m_player->SendChatMessage("writing network statistics to netstats.json");
+				return;
+			}
+			else if (message == "/netstats reset")
+			{
+				serverInstance.ResetNetworkStatistics();
+				m_player->SendChatMessage("network stats reset");
+				return;
+			}
+
+			SendReport(serverInstance.TakeNetworkStatisticsSnapshot().BuildReport(8));
+			return;
+		}
+		else if ((message == "/tickstats" || message == "/tickstats trace") && m_player->HasPermission(PlayerPermission::Admin))
+		{
+			if (message == "/tickstats trace")
+			{
+				if (!TickProfiler::DumpChromeTrace("tick_trace.json"))
+				{
+					m_player->SendChatMessage("failed to write tick_trace.json");
+					return;
+				}
+
+				m_player->SendChatMessage("tick trace written to tick_trace.json");
+				return;
+			}
+
+			SendReport(TickProfiler::BuildReport(Nz::Time::Seconds(10)));
+			return;
+		}
 		else if (message == "/spawncomputer")
 		{
 			entt::handle playerEntity = m_player->GetControlledEntity();
@@ -538,4 +602,23 @@ namespace tsom
 
 		return true;
 	}
+
+	void PlayerSessionHandler::SendReport(std::string_view report)
+	{
+		fmt::print("{}", report);
+
+		// Send the report line by line as chat messages are limited in size
+		while (!report.empty())
+		{
+			std::size_t lineEnd = report.find('\n');
+			std::string_view line = report.substr(0, lineEnd);
+			if (!line.empty())
+				m_player->SendChatMessage(std::string(line));
+
+			if (lineEnd == report.npos)
+				break;
+
+			report.remove_prefix(lineEnd + 1);
+		}
+	}
 }
@@ -7,6 +7,7 @@
 #include <CommonLib/ChunkContainer.hpp>
 #include <CommonLib/EntityClass.hpp>
 #include <CommonLib/NetworkSession.hpp>
+#include <CommonLib/Version.hpp>
 #include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <CommonLib/Components/PlanetComponent.hpp>
 #include <CommonLib/Components/ShipComponent.hpp>
@@ -167,18 +168,20 @@ namespace tsom
 		if (m_movingEntities.erase(oldEntity) > 0)
 			m_movingEntities.insert(newEntity);
 
-		// Property update
+		// Property update (inserting can rehash and invalidate the iterator, erase first)
 		if (auto it = m_propertyUpdatedEntities.find(oldEntity); it != m_propertyUpdatedEntities.end())
 		{
-			m_propertyUpdatedEntities[newEntity] = it->second;
+			Nz::Bitset<Nz::UInt64> updatedProperties = std::move(it.value());
 			m_propertyUpdatedEntities.erase(it);
+			m_propertyUpdatedEntities.insert_or_assign(newEntity, std::move(updatedProperties));
 		}
 
 		// RPCs
 		if (auto it = m_triggeredEntitiesRpc.find(oldEntity); it != m_triggeredEntitiesRpc.end())
 		{
-			m_triggeredEntitiesRpc[newEntity] = std::move(it.value());
+			std::vector<Nz::UInt32> triggeredRpcs = std::move(it.value());
 			m_triggeredEntitiesRpc.erase(it);
+			m_triggeredEntitiesRpc.insert_or_assign(newEntity, std::move(triggeredRpcs));
 		}
 
 		// Entity indices
@@ -452,13 +455,27 @@ namespace tsom
 
 				auto& entityData = creationPacket.entities.emplace_back();
 				if (data.entityClass)
+				{
 					entityData.entityClass = m_networkSession->GetStringStore().CheckStringIndex(data.entityClass->GetName());
+
+					// Let the packet serializer read property values from the entity, instead of copying them first
+					if (const ClassInstanceComponent* entityInstance = (handle.valid()) ? handle.try_get<ClassInstanceComponent>() : nullptr)
+						entityData.propertySource = entityInstance;
+					else
+					{
+						for (Nz::UInt32 i = 0; i < data.entityClass->GetPropertyCount(); ++i)
+						{
+							const auto& property = data.entityClass->GetProperty(i);
+							if (property.isNetworked)
+								entityData.properties.push_back(property.defaultValue);
+						}
+					}
+				}
 				entityData.entityId = Nz::SafeCast<EntityId>(entityIndex);
 				entityData.environmentId = envIndex;
 				entityData.initialStates.position = data.initialPosition;
 				entityData.initialStates.rotation = data.initialRotation;
 				entityData.playerControlled = std::move(data.playerControlledData);
-				entityData.properties = std::move(data.entityProperties);
 			}
 
 			m_networkSession->SendPacket(creationPacket);
@@ -484,26 +501,47 @@ namespace tsom
 
 		if (!m_propertyUpdatedEntities.empty())
 		{
-			for (auto&& [entity, propertyFlags] : m_propertyUpdatedEntities)
+			if (m_networkSession->GetProtocolVersion() >= BuildVersion(0, 7, 0))
 			{
-				EntityId entityIndex = Nz::Retrieve(m_entityIndices, entity);
+				// Send every property changed during the tick in a single packet
+				Packets::EntitiesPropertyUpdate propertyUpdatePacket;
+				propertyUpdatePacket.tickIndex = tickIndex;
+
+				for (auto&& [entity, propertyMask] : m_propertyUpdatedEntities)
+				{
+					auto& entityInstance = entity.get<ClassInstanceComponent>();
 
-				auto& entityInstance = entity.get<ClassInstanceComponent>();
+					auto& entityData = propertyUpdatePacket.entities.emplace_back();
+					entityData.entityId = Nz::Retrieve(m_entityIndices, entity);
 
-				Nz::UInt32 propertyBits = propertyFlags;
-				while (Nz::UInt32 propertyIndex = Nz::FindFirstBit(propertyBits))
+					// Only send property indices, the packet serializer reads values from the entity
+					entityData.propertySource = &entityInstance;
+
+					entityData.properties.reserve(propertyMask.Count());
+					for (std::size_t propertyIndex = propertyMask.FindFirst(); propertyIndex != propertyMask.npos; propertyIndex = propertyMask.FindNext(propertyIndex))
+						entityData.properties.emplace_back().propertyIndex = Nz::SafeCast<Nz::UInt32>(propertyIndex);
+				}
+
+				m_networkSession->SendPacket(propertyUpdatePacket);
+			}
+			else
+			{
+				for (auto&& [entity, propertyMask] : m_propertyUpdatedEntities)
 				{
-					propertyIndex--; //< FFB returns 0 if no bit was found
+					EntityId entityIndex = Nz::Retrieve(m_entityIndices, entity);
 
-					Packets::EntityPropertyUpdate propertyUpdatePacket;
-					propertyUpdatePacket.entity = entityIndex;
-					propertyUpdatePacket.propertyIndex = propertyIndex;
-					propertyUpdatePacket.propertyValue = entityInstance.GetProperty(propertyIndex);
-					propertyUpdatePacket.tickIndex = tickIndex;
+					auto& entityInstance = entity.get<ClassInstanceComponent>();
 
-					m_networkSession->SendPacket(propertyUpdatePacket);
+					for (std::size_t propertyIndex = propertyMask.FindFirst(); propertyIndex != propertyMask.npos; propertyIndex = propertyMask.FindNext(propertyIndex))
+					{
+						Packets::EntityPropertyUpdate propertyUpdatePacket;
+						propertyUpdatePacket.entity = entityIndex;
+						propertyUpdatePacket.propertyIndex = Nz::SafeCast<Nz::UInt32>(propertyIndex);
+						propertyUpdatePacket.propertySource = &entityInstance;
+						propertyUpdatePacket.tickIndex = tickIndex;
 
-					propertyBits = Nz::ClearBit(propertyBits, propertyIndex);
+						m_networkSession->SendPacket(propertyUpdatePacket);
+					}
 				}
 			}
 			m_propertyUpdatedEntities.clear();
@@ -557,7 +595,20 @@ namespace tsom
 		}
 
 		if (!stateUpdate.entities.empty() || stateUpdate.controlledCharacter.has_value())
+		{
 			m_networkSession->SendPacket(stateUpdate);
+			m_hasUnacknowledgedInput = false;
+		}
+		else if (m_hasUnacknowledgedInput && m_networkSession->GetProtocolVersion() >= BuildVersion(0, 7, 0))
+		{
+			// Nothing moved but the client still needs to know which inputs were processed to trim its prediction history
+			Packets::InputAck inputAck;
+			inputAck.tickIndex = tickIndex;
+			inputAck.lastInputIndex = m_lastInputIndex;
+
+			m_networkSession->SendPacket(inputAck);
+			m_hasUnacknowledgedInput = false;
+		}
 	}
 
 	void SessionVisibilityHandler::DispatchEnvironments(Nz::UInt16 tickIndex)
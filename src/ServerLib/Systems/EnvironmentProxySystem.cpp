@@ -4,6 +4,7 @@
 
 #include <ServerLib/Systems/EnvironmentProxySystem.hpp>
 #include <CommonLib/EnvironmentTransform.hpp>
+#include <CommonLib/TickProfiler.hpp>
 #include <CommonLib/Components/ShipComponent.hpp>
 #include <ServerLib/ServerEnvironment.hpp>
 #include <ServerLib/ServerPlayer.hpp>
@@ -15,6 +16,8 @@ namespace tsom
 {
 	void EnvironmentProxySystem::Update(Nz::Time elapsedTime)
 	{
+		TickProfiler::Zone zone("EnvironmentProxySystem::Update");
+
 		auto view = m_registry.view<Nz::NodeComponent, EnvironmentProxyComponent>();
 		for (entt::entity entity : view)
 		{
@@ -22,15 +25,20 @@ namespace tsom
 			auto& proxyComponent = view.get<EnvironmentProxyComponent>(entity);
 
 			EnvironmentTransform relativeTransform(nodeComponent.GetPosition(), nodeComponent.GetRotation());
-			if (proxyComponent.fromEnv->CompareAndUpdateConnectedTransform(*proxyComponent.toEnv, relativeTransform))
+
+			// Both environments and their players are touched, which cannot happen while other environments are updating
+			proxyComponent.fromEnv->ExecuteSerialized([fromEnv = proxyComponent.fromEnv, toEnv = proxyComponent.toEnv, relativeTransform]
 			{
-				proxyComponent.toEnv->UpdateConnectedTransform(*proxyComponent.fromEnv, -relativeTransform);
+				if (!fromEnv->CompareAndUpdateConnectedTransform(*toEnv, relativeTransform))
+					return;
+
+				toEnv->UpdateConnectedTransform(*fromEnv, -relativeTransform);
 
-				proxyComponent.fromEnv->ForEachPlayer([&](ServerPlayer& player)
+				fromEnv->ForEachPlayer([&](ServerPlayer& player)
 				{
-					player.GetVisibilityHandler().MoveEnvironment(*proxyComponent.toEnv, relativeTransform);
+					player.GetVisibilityHandler().MoveEnvironment(*toEnv, relativeTransform);
 				});
-			}
+			});
 		}
 	}
 }
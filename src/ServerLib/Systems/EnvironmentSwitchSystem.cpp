@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in LICENSE
 
 #include <ServerLib/Systems/EnvironmentSwitchSystem.hpp>
+#include <CommonLib/TickProfiler.hpp>
 #include <ServerLib/ServerEnvironment.hpp>
 #include <ServerLib/ServerInstance.hpp>
 #include <ServerLib/ServerPlayer.hpp>
@@ -15,6 +16,8 @@ namespace tsom
 {
 	void EnvironmentSwitchSystem::Update(Nz::Time elapsedTime)
 	{
+		TickProfiler::Zone zone("EnvironmentSwitchSystem::Update");
+
 		auto view = m_registry.view<Nz::NodeComponent, EnvironmentEnterTriggerComponent>();
 
 		for (entt::entity entity : view)
@@ -41,7 +44,16 @@ namespace tsom
 				{
 					localPlayerPos -= enterTrigger.entryTrigger->GetCenterOfMass(); //< https://jrouwe.github.io/JoltPhysics/index.html#center-of-mass
 					if (enterTrigger.entryTrigger->CollisionQuery(localPlayerPos))
-						player.MoveEntityToEnvironment(enterTrigger.targetEnvironment, Nz::Vector3f::Zero());
+					{
+						m_ownerEnvironment->ExecuteSerialized([this, playerPtr = &player, targetEnvironment = enterTrigger.targetEnvironment]
+						{
+							// Another environment may have moved the player in the meantime
+							if (playerPtr->GetControlledEntityEnvironment() != m_ownerEnvironment)
+								return;
+
+							playerPtr->MoveEntityToEnvironment(targetEnvironment, Nz::Vector3f::Zero());
+						});
+					}
 				}
 			});
 		}
@@ -4,6 +4,7 @@
 
 #include <ServerLib/Systems/NetworkedEntitiesSystem.hpp>
 #include <CommonLib/Planet.hpp>
+#include <CommonLib/TickProfiler.hpp>
 #include <CommonLib/Components/ClassInstanceComponent.hpp>
 #include <CommonLib/Components/PlanetComponent.hpp>
 #include <CommonLib/Components/ShipComponent.hpp>
@@ -51,51 +52,15 @@ namespace tsom
 		m_networkedEntities.erase(entity);
 	}
 
-	void NetworkedEntitiesSystem::Update(Nz::Time elapsedTime)
+	void NetworkedEntitiesSystem::Update(Nz::Time /*elapsedTime*/)
 	{
-		m_networkedConstructObserver.each([&](entt::entity entity)
-		{
-			assert(!m_networkedEntities.contains(entity));
-			EntityData& entityData = m_networkedEntities[entity];
-
-			if (ClassInstanceComponent* entityInstance = m_registry.try_get<ClassInstanceComponent>(entity))
-			{
-				entityData.onClientRpc.Connect(entityInstance->OnClientRpc, [this, entity](ClassInstanceComponent* emitter, Nz::UInt32 rpcIndex, ServerPlayer* targetPlayer)
-				{
-					entt::handle handle(m_registry, entity);
-					if (targetPlayer)
-						targetPlayer->GetVisibilityHandler().TriggerEntityRpc(handle, rpcIndex);
-					else
-					{
-						ForEachVisibility([&](SessionVisibilityHandler& visibility)
-						{
-							visibility.TriggerEntityRpc(handle, rpcIndex);
-						});
-					}
-				});
-
-				entityData.onPropertyUpdate.Connect(entityInstance->OnPropertyUpdate, [this, entity](ClassInstanceComponent* emitter, Nz::UInt32 propertyIndex, const EntityProperty& /*newValue*/)
-				{
-					if (!emitter->GetClass()->GetProperty(propertyIndex).isNetworked)
-						return;
-
-					entt::handle handle(m_registry, entity);
-					ForEachVisibility([&](SessionVisibilityHandler& visibility)
-					{
-						visibility.UpdateEntityProperty(handle, propertyIndex);
-					});
-				});
-			}
+		TickProfiler::Zone zone("NetworkedEntitiesSystem::Update");
 
-			auto& entityNetwork = m_registry.get<NetworkedComponent>(entity);
-			if (!entityNetwork.ShouldSignalCreation())
-				return;
-
-			SessionVisibilityHandler::CreateEntityData createData = BuildCreateEntityData(entity);
-			ForEachVisibility([&](SessionVisibilityHandler& visibility)
-			{
-				CreateEntity(visibility, entt::handle(m_registry, entity), createData);
-			});
+		// Visibility handlers are shared by all environments a player sees, only fill them during the serial phase of the tick
+		m_environment.ExecuteSerialized([this]
+		{
+			HandleNewEntities();
+			FlushPropertyUpdates();
 		});
 	}
 
@@ -116,16 +81,6 @@ namespace tsom
 		createData.initialRotation = entityNode.GetRotation();
 		createData.isMoving = isMoving;
 
-		if (entityInstance)
-		{
-			createData.entityProperties.reserve(createData.entityClass->GetPropertyCount());
-			for (std::size_t i = 0; i < createData.entityClass->GetPropertyCount(); ++i)
-			{
-				if (entityInstance->GetClass()->GetProperty(i).isNetworked)
-					createData.entityProperties.emplace_back(entityInstance->GetProperty(i));
-			}
-		}
-
 		if (auto* playerControlled = m_registry.try_get<ServerPlayerControlledComponent>(entity))
 		{
 			if (ServerPlayer* controllingPlayer = playerControlled->GetPlayer())
@@ -160,6 +115,83 @@ namespace tsom
 		}
 	}
 
+	void NetworkedEntitiesSystem::FlushPropertyUpdates()
+	{
+		for (entt::entity entity : m_propertyUpdatedEntities)
+		{
+			// Entity may have been destroyed (or disabled and enabled again) since its properties changed
+			auto it = m_networkedEntities.find(entity);
+			if (it == m_networkedEntities.end())
+				continue;
+
+			Nz::Bitset<Nz::UInt64>& dirtyProperties = it.value().dirtyProperties;
+			if (dirtyProperties.TestNone())
+				continue;
+
+			ForEachVisibility([&](SessionVisibilityHandler& visibility)
+			{
+				visibility.UpdateEntityProperties(entt::handle(m_registry, entity), dirtyProperties);
+			});
+
+			dirtyProperties.Clear();
+		}
+		m_propertyUpdatedEntities.clear();
+	}
+
+	void NetworkedEntitiesSystem::HandleNewEntities()
+	{
+		m_networkedConstructObserver.each([&](entt::entity entity)
+		{
+			assert(!m_networkedEntities.contains(entity));
+			EntityData& entityData = m_networkedEntities[entity];
+
+			if (ClassInstanceComponent* entityInstance = m_registry.try_get<ClassInstanceComponent>(entity))
+			{
+				entityData.onClientRpc.Connect(entityInstance->OnClientRpc, [this, entity](ClassInstanceComponent* emitter, Nz::UInt32 rpcIndex, ServerPlayer* targetPlayer)
+				{
+					m_environment.ExecuteSerialized([this, handle = entt::handle(m_registry, entity), rpcIndex, targetPlayer]
+					{
+						if (targetPlayer)
+							targetPlayer->GetVisibilityHandler().TriggerEntityRpc(handle, rpcIndex);
+						else
+						{
+							ForEachVisibility([&](SessionVisibilityHandler& visibility)
+							{
+								visibility.TriggerEntityRpc(handle, rpcIndex);
+							});
+						}
+					});
+				});
+
+				entityData.onPropertyUpdate.Connect(entityInstance->OnPropertyUpdate, [this, entity](ClassInstanceComponent* emitter, Nz::UInt32 propertyIndex, const EntityProperty& /*newValue*/)
+				{
+					if (!emitter->GetClass()->GetProperty(propertyIndex).isNetworked)
+						return;
+
+					// Only mark the property as dirty, all changes of the tick are sent at once by FlushPropertyUpdates
+					auto it = m_networkedEntities.find(entity);
+					assert(it != m_networkedEntities.end());
+
+					Nz::Bitset<Nz::UInt64>& dirtyProperties = it.value().dirtyProperties;
+					if (dirtyProperties.TestNone())
+						m_propertyUpdatedEntities.push_back(entity);
+
+					dirtyProperties.UnboundedSet(propertyIndex);
+				});
+			}
+
+			auto& entityNetwork = m_registry.get<NetworkedComponent>(entity);
+			if (!entityNetwork.ShouldSignalCreation())
+				return;
+
+			SessionVisibilityHandler::CreateEntityData createData = BuildCreateEntityData(entity);
+			ForEachVisibility([&](SessionVisibilityHandler& visibility)
+			{
+				CreateEntity(visibility, entt::handle(m_registry, entity), createData);
+			});
+		});
+	}
+
 	void NetworkedEntitiesSystem::OnNetworkedDestroy([[maybe_unused]] entt::registry& registry, entt::entity entity)
 	{
 		assert(&m_registry == &registry);
@@ -169,9 +201,13 @@ namespace tsom
 
 		m_networkedEntities.erase(entity);
 
-		ForEachVisibility([&](SessionVisibilityHandler& visibility)
+		// Visibility handlers only use the handle as a key, it doesn't matter if the entity is gone by the time this runs
+		m_environment.ExecuteSerialized([this, handle = entt::handle(m_registry, entity)]
 		{
-			visibility.DestroyEntity(entt::handle(m_registry, entity));
+			ForEachVisibility([&](SessionVisibilityHandler& visibility)
+			{
+				visibility.DestroyEntity(handle);
+			});
 		});
 	}
 }
@@ -0,0 +1,88 @@
+#include "BenchmarkUtils.hpp"
+#include <cstdlib>
+#include <new>
+
+// Replacing the global allocation functions counts allocations made by the benchmark executable,
+// this includes shared libraries on platforms with symbol interposition (but not Windows DLLs)
+
+namespace
+{
+	void* Allocate(std::size_t size)
+	{
+		tsom::Benchmarks::AllocationCounters& counters = tsom::Benchmarks::GetAllocationCounters();
+		counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+		counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+		if (void* ptr = std::malloc((size > 0) ? size : 1))
+			return ptr;
+
+		throw std::bad_alloc();
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	return Allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+	return Allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	try
+	{
+		return Allocate(size);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return nullptr;
+	}
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+namespace tsom::Benchmarks
+{
+	AllocationCounters& GetAllocationCounters()
+	{
+		// Never destroyed, allocations may happen during static destruction
+		static AllocationCounters* counters = new (std::malloc(sizeof(AllocationCounters))) AllocationCounters;
+		return *counters;
+	}
+}
@@ -0,0 +1,46 @@
+#include "BenchmarkUtils.hpp"
+#include <CommonLib/Utility/CompressionDictionary.hpp>
+#include <Nazara/Core/Modules.hpp>
+#include <Nazara/Physics3D/Physics3D.hpp>
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <filesystem>
+#include <optional>
+
+namespace tsom::Benchmarks
+{
+	// Colliders require the physics module
+	class BenchmarkListener : public Catch::EventListenerBase
+	{
+		public:
+			using EventListenerBase::EventListenerBase;
+
+			void benchmarkEnded(const Catch::BenchmarkStats<>& benchmarkStats) override
+			{
+				const OperationInfo& operation = GetCurrentOperation();
+				if (benchmarkStats.info.name != operation.name)
+					return;
+
+				double runTime = benchmarkStats.mean.point.count() / 1'000'000'000.0;
+				fmt::print("{}: {:.1f} runs/s, {:.2f} Mblocks/s, {} allocations ({} bytes) per run\n", operation.name, 1.0 / runTime, operation.blockCount / runTime / 1'000'000.0, operation.allocationStats.allocationCount, operation.allocationStats.allocatedBytes);
+			}
+
+			void testRunStarting(const Catch::TestRunInfo& /*testRunInfo*/) override
+			{
+				m_modules.emplace();
+
+				if (std::filesystem::is_directory("dictionaries"))
+					CompressionDictionary::LoadDirectory("dictionaries");
+			}
+
+			void testRunEnded(const Catch::TestRunStats& /*testRunStats*/) override
+			{
+				m_modules.reset();
+			}
+
+		private:
+			std::optional<Nz::Modules<Nz::Physics3D>> m_modules;
+	};
+}
+
+CATCH_REGISTER_LISTENER(tsom::Benchmarks::BenchmarkListener)
@@ -0,0 +1,96 @@
+#include "BenchmarkUtils.hpp"
+#include <random>
+#include <stdexcept>
+
+namespace tsom::Benchmarks
+{
+	ChunkFixtures::ChunkFixtures() :
+	planet(1.f, 16.f, 9.81f),
+	ship(1.f)
+	{
+		constexpr Nz::Vector3ui PlanetChunkCount(5);
+
+		BlockIndex dirtIndex = blockLibrary.GetBlockIndex("dirt");
+		BlockIndex grassIndex = blockLibrary.GetBlockIndex("grass");
+		BlockIndex stoneIndex = blockLibrary.GetBlockIndex("stone");
+
+		// Chunks inside the planet are not deformed
+		chunks[Nz::UnderlyingCast(Type::Empty)] = &planet.AddChunk(blockLibrary, { 1, 0, 0 }, [&](BlockIndex* blocks)
+		{
+			std::fill_n(blocks, Planet::ChunkSize * Planet::ChunkSize * Planet::ChunkSize, EmptyBlockIndex);
+		});
+
+		chunks[Nz::UnderlyingCast(Type::Full)] = &planet.AddChunk(blockLibrary, { -1, 0, 0 }, [&](BlockIndex* blocks)
+		{
+			std::fill_n(blocks, Planet::ChunkSize * Planet::ChunkSize * Planet::ChunkSize, stoneIndex);
+		});
+
+		// Worst case for meshing and colliders, half of the blocks are empty
+		chunks[Nz::UnderlyingCast(Type::Noisy)] = &planet.AddChunk(blockLibrary, { 0, 0, 1 }, [&](BlockIndex* blocks)
+		{
+			std::minstd_rand rand(Seed);
+			std::array<BlockIndex, 6> blockTypes = { EmptyBlockIndex, EmptyBlockIndex, EmptyBlockIndex, dirtIndex, grassIndex, stoneIndex };
+			std::uniform_int_distribution<std::size_t> dis(0, blockTypes.size() - 1);
+
+			for (std::size_t i = 0; i < Planet::ChunkSize * Planet::ChunkSize * Planet::ChunkSize; ++i)
+				blocks[i] = blockTypes[dis(rand)];
+		});
+
+		Chunk& terrainChunk = planet.AddChunk(blockLibrary, { 0, 2, 0 });
+		planet.GenerateChunk(blockLibrary, terrainChunk, Seed, PlanetChunkCount);
+		chunks[Nz::UnderlyingCast(Type::Terrain)] = &terrainChunk;
+
+		Chunk& cornerChunk = planet.AddChunk(blockLibrary, { 2, 2, 2 });
+		planet.GenerateChunk(blockLibrary, cornerChunk, Seed, PlanetChunkCount);
+		chunks[Nz::UnderlyingCast(Type::TerrainCorner)] = &cornerChunk;
+
+		ship.Generate(blockLibrary, false);
+		chunks[Nz::UnderlyingCast(Type::ShipHull)] = ship.GetChunk({ 0, 0, 0 });
+
+		for (Type type : AllTypes)
+		{
+			Chunk* chunk = chunks[Nz::UnderlyingCast(type)];
+			if (!chunk || !chunk->HasContent())
+				throw std::runtime_error(fmt::format("failed to build {} chunk fixture", ToString(type)));
+		}
+	}
+
+	const Chunk& ChunkFixtures::GetChunk(Type type) const
+	{
+		return *chunks[Nz::UnderlyingCast(type)];
+	}
+
+	Nz::Vector3f ChunkFixtures::GetMeshCenter(Type type) const
+	{
+		const Chunk& chunk = GetChunk(type);
+		const ChunkContainer& container = chunk.GetContainer();
+		return container.GetCenter() - container.GetChunkOffset(chunk.GetIndices());
+	}
+
+	std::string_view ChunkFixtures::ToString(Type type)
+	{
+		switch (type)
+		{
+			case Type::Empty:         return "empty";
+			case Type::Full:          return "full";
+			case Type::Noisy:         return "noisy";
+			case Type::ShipHull:      return "ship hull";
+			case Type::Terrain:       return "terrain";
+			case Type::TerrainCorner: return "terrain corner";
+		}
+
+		NAZARA_UNREACHABLE();
+	}
+
+	const ChunkFixtures& ChunkFixtures::Get()
+	{
+		static ChunkFixtures fixtures;
+		return fixtures;
+	}
+
+	OperationInfo& GetCurrentOperation()
+	{
+		static OperationInfo operation;
+		return operation;
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <CommonLib/BlockLibrary.hpp>
+#include <CommonLib/Chunk.hpp>
+#include <CommonLib/Planet.hpp>
+#include <CommonLib/Ship.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <fmt/format.h>
+#include <array>
+#include <atomic>
+#include <string>
+
+namespace tsom::Benchmarks
+{
+	// Allocations made since program start, counted by the global operator new replacement (see AllocationTracker.cpp)
+	struct AllocationCounters
+	{
+		std::atomic<std::size_t> allocationCount = 0;
+		std::atomic<std::size_t> allocatedBytes = 0;
+	};
+
+	AllocationCounters& GetAllocationCounters();
+
+	struct AllocationStats
+	{
+		std::size_t allocationCount;
+		std::size_t allocatedBytes;
+	};
+
+	template<typename F>
+	AllocationStats CountAllocations(F&& func)
+	{
+		AllocationCounters& counters = GetAllocationCounters();
+		std::size_t allocationCount = counters.allocationCount.load();
+		std::size_t allocatedBytes = counters.allocatedBytes.load();
+
+		func();
+
+		return { counters.allocationCount.load() - allocationCount, counters.allocatedBytes.load() - allocatedBytes };
+	}
+
+	// Reproducible chunks shared by all benchmarks, built on first use
+	struct ChunkFixtures
+	{
+		ChunkFixtures();
+
+		enum class Type
+		{
+			Empty,
+			Full,
+			Noisy,
+			ShipHull,
+			Terrain,
+			TerrainCorner, //< deformed chunk
+
+			Max = TerrainCorner
+		};
+
+		const Chunk& GetChunk(Type type) const;
+		Nz::Vector3f GetMeshCenter(Type type) const;
+
+		static std::string_view ToString(Type type);
+
+		static const ChunkFixtures& Get();
+
+		static constexpr std::array<Type, 6> AllTypes = { Type::Empty, Type::Full, Type::Noisy, Type::ShipHull, Type::Terrain, Type::TerrainCorner };
+		static constexpr Nz::UInt32 Seed = 42;
+
+		BlockLibrary blockLibrary;
+		Planet planet;
+		Ship ship;
+		std::array<Chunk*, 6> chunks;
+	};
+
+	// Operation being benchmarked, its throughput is printed from Catch2 measurements by BenchmarkListener
+	struct OperationInfo
+	{
+		std::string name;
+		std::size_t blockCount;
+		AllocationStats allocationStats;
+	};
+
+	OperationInfo& GetCurrentOperation();
+
+	// Counts allocations of a single run then lets Catch2 measure it
+	template<typename F>
+	void MeasureOperation(const std::string& name, std::size_t blockCount, F&& func)
+	{
+		OperationInfo& operation = GetCurrentOperation();
+		operation.name = name;
+		operation.blockCount = blockCount;
+		operation.allocationStats = CountAllocations(func);
+
+		BENCHMARK(name)
+		{
+			return func();
+		};
+	}
+}
@@ -0,0 +1,122 @@
+#include "../BenchmarkUtils.hpp"
+#include <CommonLib/Chunk.hpp>
+#include <CommonLib/Ship.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Physics3D/Collider3D.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include <vector>
+
+using namespace tsom;
+using namespace tsom::Benchmarks;
+
+TEST_CASE("Chunk meshing", "[Chunks]")
+{
+	const ChunkFixtures& fixtures = ChunkFixtures::Get();
+	for (ChunkFixtures::Type type : ChunkFixtures::AllTypes)
+	{
+		const Chunk& chunk = fixtures.GetChunk(type);
+		Chunk::Snapshot snapshot = chunk.TakeSnapshot();
+		Nz::Vector3f center = fixtures.GetMeshCenter(type);
+
+		for (unsigned int lodLevel : { 0u, 2u })
+		{
+			MeasureOperation(fmt::format("Chunk::BuildMesh ({}, lod {})", ChunkFixtures::ToString(type), lodLevel), chunk.GetBlockCount(), [&]
+			{
+				// Same vertex layout as the client chunk meshes
+				struct Vertex
+				{
+					Nz::Vector3f position;
+					Nz::Vector3f normal;
+					Nz::Vector3f tangent;
+					Nz::Vector3f uvw;
+				};
+
+				std::vector<Nz::UInt32> indices;
+				std::vector<Vertex> vertices;
+
+				auto AddVertices = [&](const Nz::Vector3ui& /*blockIndices*/, Direction /*direction*/)
+				{
+					Chunk::VertexAttributes vertexAttributes;
+
+					vertexAttributes.firstIndex = Nz::SafeCast<Nz::UInt32>(vertices.size());
+					vertices.resize(vertices.size() + 4);
+					vertexAttributes.position = Nz::SparsePtr<Nz::Vector3f>(&vertices[vertexAttributes.firstIndex].position, sizeof(Vertex));
+					vertexAttributes.normal = Nz::SparsePtr<Nz::Vector3f>(&vertices[vertexAttributes.firstIndex].normal, sizeof(Vertex));
+					vertexAttributes.tangent = Nz::SparsePtr<Nz::Vector3f>(&vertices[vertexAttributes.firstIndex].tangent, sizeof(Vertex));
+					vertexAttributes.uv = Nz::SparsePtr<Nz::Vector3f>(&vertices[vertexAttributes.firstIndex].uvw, sizeof(Vertex));
+
+					return vertexAttributes;
+				};
+
+				chunk.BuildMesh(snapshot, lodLevel, indices, center, AddVertices);
+				return indices.size();
+			});
+		}
+	}
+}
+
+TEST_CASE("Chunk colliders", "[Chunks]")
+{
+	const ChunkFixtures& fixtures = ChunkFixtures::Get();
+	for (ChunkFixtures::Type type : ChunkFixtures::AllTypes)
+	{
+		const Chunk& chunk = fixtures.GetChunk(type);
+		Chunk::Snapshot snapshot = chunk.TakeSnapshot();
+
+		std::string_view className = (type == ChunkFixtures::Type::TerrainCorner) ? "DeformedChunk" : "FlatChunk";
+		MeasureOperation(fmt::format("{}::BuildCollider ({})", className, ChunkFixtures::ToString(type)), chunk.GetBlockCount(), [&]
+		{
+			return chunk.BuildCollider(snapshot);
+		});
+	}
+}
+
+TEST_CASE("Chunk serialization", "[Chunks]")
+{
+	const ChunkFixtures& fixtures = ChunkFixtures::Get();
+
+	// Deserialization target, so fixtures are never modified (ship and planet chunks have the same size)
+	Ship scratchShip(1.f);
+	Chunk& scratchChunk = scratchShip.AddChunk(fixtures.blockLibrary, { 0, 0, 0 });
+
+	for (ChunkFixtures::Type type : ChunkFixtures::AllTypes)
+	{
+		const Chunk& chunk = fixtures.GetChunk(type);
+
+		MeasureOperation(fmt::format("Chunk::Serialize ({})", ChunkFixtures::ToString(type)), chunk.GetBlockCount(), [&]
+		{
+			Nz::ByteArray data;
+			Nz::ByteStream stream(&data, Nz::OpenMode::Write);
+			chunk.Serialize(stream);
+
+			return data.GetSize();
+		});
+
+		Nz::ByteArray serializedData;
+		{
+			Nz::ByteStream stream(&serializedData, Nz::OpenMode::Write);
+			chunk.Serialize(stream);
+		}
+
+		fmt::print("{} chunk serialized size: {} bytes\n", ChunkFixtures::ToString(type), serializedData.GetSize());
+
+		MeasureOperation(fmt::format("Chunk::Deserialize ({})", ChunkFixtures::ToString(type)), chunk.GetBlockCount(), [&]
+		{
+			Nz::ByteStream stream(&serializedData, Nz::OpenMode::Read);
+			scratchChunk.Deserialize(stream);
+
+			return scratchChunk.GetBlockCount();
+		});
+
+		Nz::ByteArray reserializedData;
+		{
+			Nz::ByteStream stream(&reserializedData, Nz::OpenMode::Write);
+			scratchChunk.Serialize(stream);
+		}
+
+		CHECK(reserializedData == serializedData);
+	}
+}
@@ -0,0 +1,65 @@
+#include "../BenchmarkUtils.hpp"
+#include <CommonLib/Utility/BinaryCompressor.hpp>
+#include <CommonLib/Utility/CompressionDictionary.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace tsom;
+using namespace tsom::Benchmarks;
+
+TEST_CASE("Chunk content compression", "[Compression]")
+{
+	struct CompressionMode
+	{
+		std::string_view name;
+		CompressionSettings settings;
+	};
+
+	// Dictionaries are only available when running from the game directory
+	std::vector<CompressionMode> compressionModes;
+	compressionModes.push_back({ "fast", CompressionSettings{} });
+	compressionModes.push_back({ "high compression", CompressionSettings{ .highCompressionLevel = 9 } });
+	if (const CompressionDictionary* dictionary = CompressionDictionary::Get(CompressionDictionaryType::ChunkContent))
+		compressionModes.push_back({ "fast + dictionary", CompressionSettings{ .dictionary = dictionary } });
+
+	const ChunkFixtures& fixtures = ChunkFixtures::Get();
+	for (ChunkFixtures::Type type : ChunkFixtures::AllTypes)
+	{
+		const Chunk& chunk = fixtures.GetChunk(type);
+		const BlockIndex* content = chunk.GetContent();
+		std::size_t contentSize = chunk.GetBlockCount() * sizeof(BlockIndex);
+
+		for (const CompressionMode& compressionMode : compressionModes)
+		{
+			BinaryCompressor compressor;
+
+			MeasureOperation(fmt::format("BinaryCompressor::Compress ({}, {})", ChunkFixtures::ToString(type), compressionMode.name), chunk.GetBlockCount(), [&]
+			{
+				std::optional<std::span<Nz::UInt8>> compressedData = compressor.Compress(content, contentSize, compressionMode.settings);
+				if (!compressedData)
+					throw std::runtime_error("failed to compress chunk content");
+
+				return compressedData->size();
+			});
+
+			std::optional<std::span<Nz::UInt8>> compressedSpan = compressor.Compress(content, contentSize, compressionMode.settings);
+			REQUIRE(compressedSpan);
+
+			std::vector<Nz::UInt8> compressedData(compressedSpan->begin(), compressedSpan->end());
+			fmt::print("{} chunk compressed size ({}): {} bytes ({:.1f}%)\n", ChunkFixtures::ToString(type), compressionMode.name, compressedData.size(), compressedData.size() * 100.0 / contentSize);
+
+			std::vector<BlockIndex> decompressedContent(chunk.GetBlockCount());
+			MeasureOperation(fmt::format("BinaryCompressor::Decompress ({}, {})", ChunkFixtures::ToString(type), compressionMode.name), chunk.GetBlockCount(), [&]
+			{
+				return compressor.Decompress(compressedData.data(), compressedData.size(), decompressedContent.data(), contentSize, compressionMode.settings.dictionary);
+			});
+
+			CHECK(std::equal(decompressedContent.begin(), decompressedContent.end(), content));
+		}
+	}
+}
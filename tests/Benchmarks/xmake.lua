@@ -0,0 +1,8 @@
+add_requires("catch2 >=3.x")
+
+-- Run with `xmake run Benchmarks` in release mode, use `-- [Chunks]` or other tags to select benchmarks
+target("Benchmarks", function ()
+    add_deps("CommonLib")
+    add_packages("catch2")
+    add_files("**.cpp")
+end)
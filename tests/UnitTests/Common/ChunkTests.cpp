@@ -1,7 +1,16 @@
+#include <CommonLib/BlockLibrary.hpp>
 #include <CommonLib/Chunk.hpp>
 #include <CommonLib/ChunkContainer.hpp>
+#include <CommonLib/FlatChunk.hpp>
 #include <CommonLib/Planet.hpp>
+#include <CommonLib/Ship.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 using namespace tsom;
 
@@ -44,3 +53,301 @@ TEST_CASE("Block positions", "[Chunks]")
 		}
 	}
 }
+
+TEST_CASE("Chunk snapshots", "[Chunks]")
+{
+	BlockLibrary blockLibrary;
+	BlockIndex dirtBlock = blockLibrary.GetBlockIndex("dirt");
+	BlockIndex stoneBlock = blockLibrary.GetBlockIndex("stone");
+
+	constexpr std::size_t BlockCount = Ship::ChunkSize * Ship::ChunkSize * Ship::ChunkSize;
+
+	Ship ship(1.f);
+	FlatChunk& chunk = ship.AddChunk(blockLibrary, { 0, 0, 0 }, [&](BlockIndex* blocks)
+	{
+		std::fill_n(blocks, BlockCount, dirtBlock);
+	});
+
+	FlatChunk& neighborChunk = ship.AddChunk(blockLibrary, { 1, 0, 0 }, [&](BlockIndex* blocks)
+	{
+		std::fill_n(blocks, BlockCount, dirtBlock);
+	});
+
+	Chunk::Snapshot snapshot = chunk.TakeSnapshot();
+	REQUIRE(snapshot.blocks);
+
+	SECTION("Snapshots share blocks until the chunk is edited")
+	{
+		CHECK(snapshot.blocks == chunk.GetBlocks());
+		CHECK(std::count(snapshot.neighborBlocks.begin(), snapshot.neighborBlocks.end(), neighborChunk.GetBlocks()) == 1);
+	}
+
+	SECTION("Updating a block doesn't change snapshots")
+	{
+		chunk.UpdateBlock({ 1, 2, 3 }, stoneBlock);
+		neighborChunk.UpdateBlock({ 0, 0, 0 }, EmptyBlockIndex);
+
+		CHECK(chunk.GetBlockContent({ 1, 2, 3 }) == stoneBlock);
+		CHECK(snapshot.blocks != chunk.GetBlocks());
+		CHECK(snapshot.blocks->GetBlockContent({ 1, 2, 3 }) == dirtBlock);
+		CHECK(snapshot.blocks->GetCollisionCellMask().Test(snapshot.blocks->GetBlockLocalIndex({ 1, 2, 3 })));
+
+		CHECK(neighborChunk.GetBlockContent({ 0, 0, 0 }) == EmptyBlockIndex);
+		for (const auto& neighborBlocks : snapshot.neighborBlocks)
+		{
+			if (neighborBlocks)
+				CHECK(neighborBlocks->GetBlockContent({ 0, 0, 0 }) == dirtBlock);
+		}
+
+		SECTION("Unreferenced blocks are updated in place")
+		{
+			snapshot = {};
+
+			std::shared_ptr<const ChunkBlocks> blocks = chunk.GetBlocks();
+			const ChunkBlocks* blocksPtr = blocks.get();
+			blocks.reset();
+
+			chunk.UpdateBlock({ 1, 2, 3 }, dirtBlock);
+			CHECK(chunk.GetBlocks().get() == blocksPtr);
+			CHECK(chunk.GetBlockContent({ 1, 2, 3 }) == dirtBlock);
+		}
+	}
+
+	SECTION("Resetting the chunk doesn't change snapshots")
+	{
+		chunk.Reset([&](BlockIndex* blocks)
+		{
+			std::fill_n(blocks, BlockCount, stoneBlock);
+		});
+
+		CHECK(chunk.GetBlockContent({ 0, 0, 0 }) == stoneBlock);
+		CHECK(snapshot.blocks->GetBlockContent({ 0, 0, 0 }) == dirtBlock);
+	}
+}
+
+TEST_CASE("Chunk meshing", "[Chunks]")
+{
+	BlockLibrary blockLibrary;
+	BlockIndex dirtBlock = blockLibrary.GetBlockIndex("dirt");
+	BlockIndex stoneBlock = blockLibrary.GetBlockIndex("stone");
+
+	Ship ship(1.f);
+	FlatChunk& chunk = ship.AddChunk(blockLibrary, { 0, 0, 0 }, [&](BlockIndex* /*blocks*/) {});
+
+	struct Face
+	{
+		std::array<Nz::Vector3f, 4> positions;
+		Nz::Vector3ui blockIndices;
+		Direction direction;
+		float textureSlice;
+	};
+
+	auto BuildMesh = [&](unsigned int lodLevel)
+	{
+		std::vector<Face> faces;
+		std::vector<Nz::Vector3f> positions;
+		std::vector<Nz::Vector3f> uvs;
+		std::vector<Nz::UInt32> indices;
+
+		chunk.BuildMesh(chunk.TakeSnapshot(), lodLevel, indices, ship.GetCenter(), [&](const Nz::Vector3ui& blockIndices, Direction direction)
+		{
+			// Previous face attributes have been written at this point
+			if (!faces.empty())
+			{
+				Face& previousFace = faces.back();
+				std::copy_n(positions.end() - 4, 4, previousFace.positions.begin());
+				previousFace.textureSlice = uvs.back().z;
+			}
+
+			faces.push_back({ {}, blockIndices, direction, 0.f });
+
+			Chunk::VertexAttributes vertexAttributes;
+			vertexAttributes.firstIndex = Nz::SafeCast<Nz::UInt32>(positions.size());
+
+			positions.resize(positions.size() + 4);
+			uvs.resize(uvs.size() + 4);
+
+			vertexAttributes.position = Nz::SparsePtr<Nz::Vector3f>(&positions[vertexAttributes.firstIndex]);
+			vertexAttributes.uv = Nz::SparsePtr<Nz::Vector3f>(&uvs[vertexAttributes.firstIndex]);
+
+			return vertexAttributes;
+		});
+
+		if (!faces.empty())
+		{
+			Face& lastFace = faces.back();
+			std::copy_n(positions.end() - 4, 4, lastFace.positions.begin());
+			lastFace.textureSlice = uvs.back().z;
+		}
+
+		CHECK(indices.size() == faces.size() * 6);
+		return faces;
+	};
+
+	auto GetTextureSlice = [&](BlockIndex blockIndex)
+	{
+		return float(blockLibrary.GetBlockData(blockIndex).texIndices[Direction::Up]);
+	};
+
+	SECTION("LOD 0 draws every visible block face")
+	{
+		Nz::Vector3ui blockIndices(3, 4, 5);
+		chunk.UpdateBlock(blockIndices, stoneBlock);
+
+		std::vector<Face> faces = BuildMesh(0);
+		REQUIRE(faces.size() == 6);
+
+		// Each face is made of the block corners, each corner being shared by three faces
+		auto corners = chunk.ComputeVoxelCorners(blockIndices);
+		std::array<unsigned int, 8> cornerUseCount = {};
+
+		DirectionMask directions;
+		for (const Face& face : faces)
+		{
+			CHECK(face.blockIndices == blockIndices);
+			CHECK(face.textureSlice == GetTextureSlice(stoneBlock));
+			directions |= face.direction;
+
+			for (const Nz::Vector3f& position : face.positions)
+			{
+				auto it = std::find_if(corners.begin(), corners.end(), [&](const Nz::Vector3f& corner) { return corner.ApproxEqual(position); });
+				REQUIRE(it != corners.end());
+				cornerUseCount[std::distance(corners.begin(), it)]++;
+			}
+		}
+
+		CHECK(directions == DirectionMask_All);
+		CHECK(std::all_of(cornerUseCount.begin(), cornerUseCount.end(), [](unsigned int useCount) { return useCount == 3; }));
+
+		SECTION("Faces between blocks are hidden")
+		{
+			chunk.UpdateBlock({ 4, 4, 5 }, dirtBlock);
+
+			faces = BuildMesh(0);
+			CHECK(faces.size() == 10);
+			CHECK(std::count_if(faces.begin(), faces.end(), [&](const Face& face) { return face.textureSlice == GetTextureSlice(dirtBlock); }) == 5);
+		}
+	}
+
+	SECTION("LOD cells use their most common block")
+	{
+		// Fill the first 2x2x2 cell with five stone and three dirt blocks
+		for (unsigned int z = 0; z < 2; ++z)
+		{
+			for (unsigned int y = 0; y < 2; ++y)
+			{
+				for (unsigned int x = 0; x < 2; ++x)
+					chunk.UpdateBlock({ x, y, z }, (x + y + z < 2 || x + y + z == 3) ? stoneBlock : dirtBlock);
+			}
+		}
+
+		// A single block is enough for a cell not to be empty
+		chunk.UpdateBlock({ 5, 5, 5 }, dirtBlock);
+
+		std::vector<Face> faces = BuildMesh(1);
+		REQUIRE(faces.size() == 12);
+
+		// Cell corners are the outermost corners of its blocks
+		Nz::Vector3f cellMin(std::numeric_limits<float>::max());
+		Nz::Vector3f cellMax(std::numeric_limits<float>::lowest());
+		for (const Nz::Vector3ui& blockIndices : { Nz::Vector3ui(0, 0, 0), Nz::Vector3ui(1, 1, 1) })
+		{
+			for (const Nz::Vector3f& corner : chunk.ComputeVoxelCorners(blockIndices))
+			{
+				for (std::size_t axis = 0; axis < 3; ++axis)
+				{
+					cellMin[axis] = std::min(cellMin[axis], corner[axis]);
+					cellMax[axis] = std::max(cellMax[axis], corner[axis]);
+				}
+			}
+		}
+
+		for (const Face& face : faces)
+		{
+			if (face.blockIndices == Nz::Vector3ui(0, 0, 0))
+			{
+				CHECK(face.textureSlice == GetTextureSlice(stoneBlock));
+
+				// Cell faces cover the whole cell
+				for (const Nz::Vector3f& position : face.positions)
+				{
+					INFO("Position: " << position << ", cell min: " << cellMin << ", cell max: " << cellMax);
+					for (std::size_t axis = 0; axis < 3; ++axis)
+						CHECK((Nz::NumberEquals(position[axis], cellMin[axis], 0.0001f) || Nz::NumberEquals(position[axis], cellMax[axis], 0.0001f)));
+				}
+
+				CHECK_THAT(face.positions[0].Distance(face.positions[3]), Catch::Matchers::WithinAbs(std::sqrt(8.f), 0.0001f));
+			}
+			else
+			{
+				CHECK(face.blockIndices == Nz::Vector3ui(4, 4, 4));
+				CHECK(face.textureSlice == GetTextureSlice(dirtBlock));
+			}
+		}
+	}
+}
+
+TEST_CASE("Chunk face connectivity", "[Chunks]")
+{
+	BlockLibrary blockLibrary;
+	BlockIndex stoneBlock = blockLibrary.GetBlockIndex("stone");
+
+	Ship ship(1.f);
+	FlatChunk& chunk = ship.AddChunk(blockLibrary, { 0, 0, 0 }, [&](BlockIndex* /*blocks*/) {});
+
+	SECTION("Every face of an open chunk sees the others")
+	{
+		auto faceConnectivity = chunk.ComputeFaceConnectivity(chunk.TakeSnapshot());
+		for (auto&& [face, connectedFaces] : faceConnectivity.iter_kv())
+		{
+			INFO("Face: " << static_cast<int>(face));
+			CHECK(connectedFaces == DirectionMask_All);
+		}
+	}
+
+	SECTION("A solid chunk connects nothing")
+	{
+		chunk.Reset([&](BlockIndex* blocks)
+		{
+			std::fill_n(blocks, chunk.GetBlockCount(), stoneBlock);
+		});
+
+		auto faceConnectivity = chunk.ComputeFaceConnectivity(chunk.TakeSnapshot());
+		for (auto&& [face, connectedFaces] : faceConnectivity.iter_kv())
+		{
+			INFO("Face: " << static_cast<int>(face));
+			CHECK(connectedFaces == DirectionMask{});
+		}
+	}
+
+	SECTION("A solid wall splits the chunk in two")
+	{
+		// Horizontal wall in the middle of the chunk, between the up and down faces
+		constexpr unsigned int WallHeight = Ship::ChunkSize / 2;
+		for (unsigned int y = 0; y < Ship::ChunkSize; ++y)
+		{
+			for (unsigned int x = 0; x < Ship::ChunkSize; ++x)
+				chunk.UpdateBlock({ x, y, WallHeight }, stoneBlock);
+		}
+
+		auto faceConnectivity = chunk.ComputeFaceConnectivity(chunk.TakeSnapshot());
+		CHECK(faceConnectivity[Direction::Up] == (DirectionMask_All & ~DirectionMask(Direction::Down)));
+		CHECK(faceConnectivity[Direction::Down] == (DirectionMask_All & ~DirectionMask(Direction::Up)));
+
+		// Side faces touch both halves
+		for (Direction face : { Direction::Back, Direction::Front, Direction::Left, Direction::Right })
+		{
+			INFO("Face: " << static_cast<int>(face));
+			CHECK(faceConnectivity[face] == DirectionMask_All);
+		}
+
+		SECTION("A hole in the wall connects both halves")
+		{
+			chunk.UpdateBlock({ 3, 7, WallHeight }, EmptyBlockIndex);
+
+			faceConnectivity = chunk.ComputeFaceConnectivity(chunk.TakeSnapshot());
+			CHECK(faceConnectivity[Direction::Up] == DirectionMask_All);
+			CHECK(faceConnectivity[Direction::Down] == DirectionMask_All);
+		}
+	}
+}
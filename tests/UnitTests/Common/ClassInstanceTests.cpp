@@ -0,0 +1,124 @@
+#include <CommonLib/EntityClass.hpp>
+#include <CommonLib/Components/ClassInstanceComponent.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace tsom;
+
+namespace
+{
+	template<EntityPropertyType Property>
+	EntityPropertyArrayValue<Property> BuildArray(std::vector<EntityPropertyUnderlyingType_t<Property>> values)
+	{
+		EntityPropertyArrayValue<Property> container(values.size());
+		for (std::size_t i = 0; i < values.size(); ++i)
+			container[i] = std::move(values[i]);
+
+		return container;
+	}
+
+	template<EntityPropertyType Property>
+	std::vector<EntityPropertyUnderlyingType_t<Property>> GetArray(const ClassInstanceComponent& classInstance, std::string_view propertyName)
+	{
+		auto values = classInstance.GetPropertyArray<Property>(classInstance.GetPropertyIndex(propertyName));
+		return std::vector<EntityPropertyUnderlyingType_t<Property>>(values.begin(), values.end());
+	}
+}
+
+TEST_CASE("Class instance properties", "[Entities]")
+{
+	std::vector<EntityClass::Property> properties;
+	properties.push_back({ .name = "health", .type = EntityPropertyType::Integer, .defaultValue = EntityPropertySingleValue<EntityPropertyType::Integer>(100), .isArray = false, .isNetworked = true });
+	properties.push_back({ .name = "items", .type = EntityPropertyType::Integer, .defaultValue = BuildArray<EntityPropertyType::Integer>({}), .isArray = true, .isNetworked = true });
+	properties.push_back({ .name = "name", .type = EntityPropertyType::String, .defaultValue = EntityPropertySingleValue<EntityPropertyType::String>("crate"), .isArray = false, .isNetworked = true });
+	properties.push_back({ .name = "positions", .type = EntityPropertyType::FloatPosition3D, .defaultValue = BuildArray<EntityPropertyType::FloatPosition3D>({ Nz::Vector3f::UnitX() }), .isArray = true, .isNetworked = false });
+	properties.push_back({ .name = "tags", .type = EntityPropertyType::String, .defaultValue = BuildArray<EntityPropertyType::String>({ "a", "b" }), .isArray = true, .isNetworked = true });
+
+	auto entityClass = std::make_shared<EntityClass>("test", std::move(properties), EntityClass::Callbacks{}, std::vector<EntityClass::RemoteProcedureCall>{});
+
+	ClassInstanceComponent classInstance(entityClass);
+
+	SECTION("Instances start with the default values")
+	{
+		CHECK(classInstance.GetProperty<EntityPropertyType::Integer>("health") == 100);
+		CHECK(classInstance.GetProperty<EntityPropertyType::String>("name") == "crate");
+		CHECK(GetArray<EntityPropertyType::Integer>(classInstance, "items").empty());
+		CHECK(GetArray<EntityPropertyType::FloatPosition3D>(classInstance, "positions") == std::vector{ Nz::Vector3f::UnitX() });
+		CHECK(GetArray<EntityPropertyType::String>(classInstance, "tags") == std::vector<std::string>{ "a", "b" });
+	}
+
+	SECTION("Listeners are notified before the new value is stored")
+	{
+		Nz::Int64 previousHealth = 0;
+		Nz::Int64 newHealth = 0;
+
+		NazaraSlot(ClassInstanceComponent, OnPropertyUpdate, onPropertyUpdate);
+		onPropertyUpdate.Connect(classInstance.OnPropertyUpdate, [&](ClassInstanceComponent* instance, Nz::UInt32 /*propertyIndex*/, const EntityProperty& newValue)
+		{
+			previousHealth = instance->GetProperty<EntityPropertyType::Integer>("health");
+			newHealth = std::get<EntityPropertySingleValue<EntityPropertyType::Integer>>(newValue).value;
+		});
+
+		classInstance.UpdateProperty<EntityPropertyType::Integer>("health", 42);
+		CHECK(previousHealth == 100);
+		CHECK(newHealth == 42);
+		CHECK(classInstance.GetProperty<EntityPropertyType::Integer>("health") == 42);
+
+		// Values of the wrong type are rejected before listeners are notified
+		CHECK_THROWS(classInstance.UpdateProperty<EntityPropertyType::String>("health", "oops"));
+		CHECK(newHealth == 42);
+	}
+
+	SECTION("Arrays can change size")
+	{
+		Nz::UInt32 itemsIndex = classInstance.GetPropertyIndex("items");
+		Nz::UInt32 tagsIndex = classInstance.GetPropertyIndex("tags");
+
+		// Grow and shrink arrays several times, moving them around their storage
+		for (std::size_t size : { 3, 1, 8, 0, 20, 2, 64 })
+		{
+			INFO("Size: " << size);
+
+			std::vector<Nz::Int64> items;
+			std::vector<std::string> tags;
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				items.push_back(static_cast<Nz::Int64>(i * size));
+				tags.push_back("tag" + std::to_string(i));
+			}
+
+			classInstance.UpdateProperty(itemsIndex, BuildArray<EntityPropertyType::Integer>(items));
+			classInstance.UpdateProperty(tagsIndex, BuildArray<EntityPropertyType::String>(tags));
+
+			CHECK(GetArray<EntityPropertyType::Integer>(classInstance, "items") == items);
+			CHECK(GetArray<EntityPropertyType::String>(classInstance, "tags") == tags);
+
+			// Other properties are left untouched
+			CHECK(classInstance.GetProperty<EntityPropertyType::Integer>("health") == 100);
+			CHECK(classInstance.GetProperty<EntityPropertyType::String>("name") == "crate");
+			CHECK(GetArray<EntityPropertyType::FloatPosition3D>(classInstance, "positions") == std::vector{ Nz::Vector3f::UnitX() });
+		}
+	}
+
+	SECTION("Reloading the class keeps matching values")
+	{
+		classInstance.UpdateProperty<EntityPropertyType::Integer>("health", 42);
+		classInstance.UpdateProperty(classInstance.GetPropertyIndex("items"), BuildArray<EntityPropertyType::Integer>({ 1, 2, 3 }));
+		classInstance.UpdateProperty(classInstance.GetPropertyIndex("tags"), BuildArray<EntityPropertyType::String>({ "x" }));
+
+		std::vector<EntityClass::Property> newProperties;
+		newProperties.push_back({ .name = "tags", .type = EntityPropertyType::String, .defaultValue = BuildArray<EntityPropertyType::String>({}), .isArray = true, .isNetworked = true });
+		newProperties.push_back({ .name = "items", .type = EntityPropertyType::Integer, .defaultValue = BuildArray<EntityPropertyType::Integer>({ 7 }), .isArray = true, .isNetworked = true });
+		newProperties.push_back({ .name = "health", .type = EntityPropertyType::Float, .defaultValue = EntityPropertySingleValue<EntityPropertyType::Float>(1.f), .isArray = false, .isNetworked = true });
+
+		classInstance.UpdateClass(std::make_shared<EntityClass>("test", std::move(newProperties), EntityClass::Callbacks{}, std::vector<EntityClass::RemoteProcedureCall>{}));
+
+		CHECK(GetArray<EntityPropertyType::Integer>(classInstance, "items") == std::vector<Nz::Int64>{ 1, 2, 3 });
+		CHECK(GetArray<EntityPropertyType::String>(classInstance, "tags") == std::vector<std::string>{ "x" });
+
+		// Type changed, back to the default value
+		CHECK(classInstance.GetProperty<EntityPropertyType::Float>("health") == 1.f);
+	}
+}
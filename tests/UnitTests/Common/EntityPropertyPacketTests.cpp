@@ -0,0 +1,144 @@
+#include <CommonLib/EntityClass.hpp>
+#include <CommonLib/Version.hpp>
+#include <CommonLib/Components/ClassInstanceComponent.hpp>
+#include <CommonLib/Protocol/Packets.hpp>
+#include <CommonLib/Protocol/PacketSerializer.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace tsom;
+
+namespace
+{
+	template<typename T>
+	Nz::ByteArray WritePacket(const T& packet, Nz::UInt32 protocolVersion)
+	{
+		Nz::ByteArray packetData;
+		Nz::ByteStream packetStream(&packetData, Nz::OpenMode::Write);
+
+		PacketSerializer serializer(packetStream, true, protocolVersion);
+		Packets::Serialize(serializer, const_cast<T&>(packet));
+		packetStream.FlushBits();
+
+		return packetData;
+	}
+
+	template<typename T>
+	T ReadPacket(const Nz::ByteArray& packetData, Nz::UInt32 protocolVersion)
+	{
+		Nz::ByteStream packetStream(packetData.GetConstBuffer(), packetData.GetSize());
+
+		T packet;
+		PacketSerializer serializer(packetStream, false, protocolVersion);
+		Packets::Serialize(serializer, packet);
+
+		return packet;
+	}
+
+	Nz::Int64 GetInteger(const EntityProperty& property)
+	{
+		return std::get<EntityPropertySingleValue<EntityPropertyType::Integer>>(property).value;
+	}
+
+	std::vector<std::string> GetStrings(const EntityProperty& property)
+	{
+		const auto& values = std::get<EntityPropertyArrayValue<EntityPropertyType::String>>(property);
+
+		std::vector<std::string> strings;
+		for (std::size_t i = 0; i < values.GetSize(); ++i)
+			strings.push_back(values[i]);
+
+		return strings;
+	}
+}
+
+TEST_CASE("Entity property packets", "[Network]")
+{
+	constexpr Nz::UInt32 ProtocolVersion = BuildVersion(0, 7, 0);
+	constexpr Nz::UInt32 LegacyProtocolVersion = BuildVersion(0, 6, 0);
+
+	EntityPropertyArrayValue<EntityPropertyType::String> tags(2);
+	tags[0] = "a";
+	tags[1] = "bc";
+
+	std::vector<EntityClass::Property> properties;
+	properties.push_back({ .name = "health", .type = EntityPropertyType::Integer, .defaultValue = EntityPropertySingleValue<EntityPropertyType::Integer>(100), .isArray = false, .isNetworked = true });
+	properties.push_back({ .name = "tags", .type = EntityPropertyType::String, .defaultValue = tags, .isArray = true, .isNetworked = true });
+
+	auto entityClass = std::make_shared<EntityClass>("test", std::move(properties), EntityClass::Callbacks{}, std::vector<EntityClass::RemoteProcedureCall>{});
+
+	ClassInstanceComponent classInstance(entityClass);
+	classInstance.UpdateProperty<EntityPropertyType::Integer>("health", 42);
+
+	Nz::UInt32 healthIndex = classInstance.GetPropertyIndex("health");
+	Nz::UInt32 tagsIndex = classInstance.GetPropertyIndex("tags");
+
+	SECTION("Batched property updates round-trip")
+	{
+		Packets::EntitiesPropertyUpdate propertyUpdate;
+		propertyUpdate.tickIndex = 1234;
+
+		auto& firstEntity = propertyUpdate.entities.emplace_back();
+		firstEntity.entityId = 7;
+		firstEntity.properties.push_back({ CompressedUnsigned<Nz::UInt32>(healthIndex), EntityPropertySingleValue<EntityPropertyType::Integer>(42) });
+		firstEntity.properties.push_back({ CompressedUnsigned<Nz::UInt32>(tagsIndex), tags });
+
+		auto& secondEntity = propertyUpdate.entities.emplace_back();
+		secondEntity.entityId = 500;
+
+		Nz::ByteArray packetData = WritePacket(propertyUpdate, ProtocolVersion);
+		auto receivedUpdate = ReadPacket<Packets::EntitiesPropertyUpdate>(packetData, ProtocolVersion);
+
+		CHECK(receivedUpdate.tickIndex == 1234);
+		REQUIRE(receivedUpdate.entities.size() == 2);
+
+		CHECK(receivedUpdate.entities[0].entityId == 7);
+		REQUIRE(receivedUpdate.entities[0].properties.size() == 2);
+		CHECK(receivedUpdate.entities[0].properties[0].propertyIndex == healthIndex);
+		CHECK(GetInteger(receivedUpdate.entities[0].properties[0].propertyValue) == 42);
+		CHECK(receivedUpdate.entities[0].properties[1].propertyIndex == tagsIndex);
+		CHECK(GetStrings(receivedUpdate.entities[0].properties[1].propertyValue) == std::vector<std::string>{ "a", "bc" });
+
+		CHECK(receivedUpdate.entities[1].entityId == 500);
+		CHECK(receivedUpdate.entities[1].properties.empty());
+
+		SECTION("Properties serialized from the entity are read the same way")
+		{
+			// Only property indices are read from the packet
+			for (auto& property : firstEntity.properties)
+				property.propertyValue = EntityPropertySingleValue<EntityPropertyType::Integer>(0);
+
+			firstEntity.propertySource = &classInstance;
+
+			CHECK(WritePacket(propertyUpdate, ProtocolVersion) == packetData);
+		}
+	}
+
+	SECTION("Legacy clients get one packet per property")
+	{
+		Packets::EntityPropertyUpdate propertyUpdate;
+		propertyUpdate.tickIndex = 42;
+		propertyUpdate.entity = 7;
+		propertyUpdate.propertyIndex = tagsIndex;
+		propertyUpdate.propertyValue = tags;
+
+		Nz::ByteArray packetData = WritePacket(propertyUpdate, LegacyProtocolVersion);
+		auto receivedUpdate = ReadPacket<Packets::EntityPropertyUpdate>(packetData, LegacyProtocolVersion);
+
+		CHECK(receivedUpdate.tickIndex == 42);
+		CHECK(receivedUpdate.entity == 7);
+		CHECK(receivedUpdate.propertyIndex == tagsIndex);
+		CHECK(GetStrings(receivedUpdate.propertyValue) == std::vector<std::string>{ "a", "bc" });
+
+		SECTION("Properties serialized from the entity are read the same way")
+		{
+			propertyUpdate.propertyValue = EntityPropertySingleValue<EntityPropertyType::Integer>(0);
+			propertyUpdate.propertySource = &classInstance;
+
+			CHECK(WritePacket(propertyUpdate, LegacyProtocolVersion) == packetData);
+		}
+	}
+}
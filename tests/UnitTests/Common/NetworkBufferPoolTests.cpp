@@ -0,0 +1,107 @@
+#include <CommonLib/NetworkBufferPool.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace tsom;
+
+TEST_CASE("Network buffer pool", "[Network]")
+{
+	NetworkBufferPool bufferPool(2);
+
+	SECTION("Acquired buffers are empty and big enough")
+	{
+		for (std::size_t sizeHint : { 0, 1, 64, 65, 1000, 65536 })
+		{
+			INFO("Size hint: " << sizeHint);
+
+			Nz::ByteArray buffer = bufferPool.Acquire(sizeHint);
+			CHECK(buffer.IsEmpty());
+			CHECK(buffer.GetCapacity() >= sizeHint);
+		}
+	}
+
+	SECTION("Released buffers are reused")
+	{
+		Nz::ByteArray buffer = bufferPool.Acquire(200);
+		buffer.Resize(200);
+		const Nz::UInt8* data = buffer.GetConstBuffer();
+		std::size_t capacity = buffer.GetCapacity();
+
+		bufferPool.Release(std::move(buffer));
+
+		Nz::ByteArray reusedBuffer = bufferPool.Acquire(100);
+		CHECK(reusedBuffer.IsEmpty());
+		CHECK(reusedBuffer.GetCapacity() == capacity);
+		CHECK(reusedBuffer.GetConstBuffer() == data);
+	}
+
+	SECTION("Bigger buffers are used when no buffer of the right size is available")
+	{
+		Nz::ByteArray buffer = bufferPool.Acquire(4000);
+		const Nz::UInt8* data = buffer.GetConstBuffer();
+		bufferPool.Release(std::move(buffer));
+
+		Nz::ByteArray reusedBuffer = bufferPool.Acquire(10);
+		CHECK(reusedBuffer.GetConstBuffer() == data);
+	}
+
+	SECTION("Smaller buffers are never returned")
+	{
+		Nz::ByteArray buffer = bufferPool.Acquire(64);
+		const Nz::UInt8* data = buffer.GetConstBuffer();
+		bufferPool.Release(std::move(buffer));
+
+		Nz::ByteArray biggerBuffer = bufferPool.Acquire(1000);
+		CHECK(biggerBuffer.GetConstBuffer() != data);
+		CHECK(biggerBuffer.GetCapacity() >= 1000);
+	}
+
+	SECTION("Pool keeps at most maxBufferPerClass buffers per size class")
+	{
+		std::vector<Nz::ByteArray> buffers;
+		for (std::size_t i = 0; i < 3; ++i)
+			buffers.push_back(bufferPool.Acquire(256));
+
+		std::vector<const Nz::UInt8*> bufferData;
+		for (Nz::ByteArray& buffer : buffers)
+		{
+			bufferData.push_back(buffer.GetConstBuffer());
+			bufferPool.Release(std::move(buffer));
+		}
+
+		// The third one was dropped, only the first two can be reused
+		for (std::size_t i = 0; i < 2; ++i)
+		{
+			Nz::ByteArray buffer = bufferPool.Acquire(256);
+			CHECK(std::find(bufferData.begin(), bufferData.begin() + 2, buffer.GetConstBuffer()) != bufferData.begin() + 2);
+			buffers[i] = std::move(buffer);
+		}
+	}
+
+	SECTION("Size hints are kept per buffer type and decay")
+	{
+		CHECK(bufferPool.GetSizeHint(0) == 0);
+
+		bufferPool.UpdateSizeHint(0, 100);
+		bufferPool.UpdateSizeHint(1, 4000);
+		CHECK(bufferPool.GetSizeHint(0) == 100);
+		CHECK(bufferPool.GetSizeHint(1) == 4000);
+
+		// Bigger sizes are taken immediately, smaller ones progressively
+		bufferPool.UpdateSizeHint(0, 60000);
+		CHECK(bufferPool.GetSizeHint(0) == 60000);
+
+		bufferPool.UpdateSizeHint(0, 100);
+		CHECK(bufferPool.GetSizeHint(0) < 60000);
+		CHECK(bufferPool.GetSizeHint(0) > 100);
+
+		for (std::size_t i = 0; i < 64; ++i)
+			bufferPool.UpdateSizeHint(0, 100);
+
+		CHECK(bufferPool.GetSizeHint(0) == 100);
+
+		// Other types are unaffected
+		CHECK(bufferPool.GetSizeHint(1) == 4000);
+	}
+}
@@ -0,0 +1,48 @@
+#include <CommonLib/NetworkSessionManager.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <optional>
+#include <vector>
+
+using namespace tsom;
+
+TEST_CASE("Network session manager", "[Network]")
+{
+	SECTION("Redirection data round-trips")
+	{
+		for (Nz::UInt16 portOffset : { 0, 1, 15, 0xFFFF })
+		{
+			INFO("Port offset: " << portOffset);
+
+			std::optional<Nz::UInt16> extractedOffset = NetworkSessionManager::ExtractRedirectPortOffset(NetworkSessionManager::BuildRedirectData(portOffset));
+			REQUIRE(extractedOffset);
+			CHECK(*extractedOffset == portOffset);
+		}
+
+		// Regular disconnections are not redirections
+		CHECK_FALSE(NetworkSessionManager::ExtractRedirectPortOffset(0));
+		CHECK_FALSE(NetworkSessionManager::ExtractRedirectPortOffset(42));
+	}
+
+	SECTION("Peers are spread between reactors")
+	{
+		// Simulate peers connecting one after the other, each one going to the reactor picked for it
+		std::vector<std::size_t> sessionCounts(4, 0);
+		for (std::size_t i = 0; i < 40; ++i)
+			sessionCounts[NetworkSessionManager::PickReactor(sessionCounts)]++;
+
+		CHECK(sessionCounts == std::vector<std::size_t>{ 10, 10, 10, 10 });
+
+		// Disconnections free slots which are filled first
+		sessionCounts[2] -= 3;
+		CHECK(NetworkSessionManager::PickReactor(sessionCounts) == 2);
+	}
+
+	SECTION("Peers stay on the first reactor on ties")
+	{
+		std::vector<std::size_t> sessionCounts = { 3, 3, 3 };
+		CHECK(NetworkSessionManager::PickReactor(sessionCounts) == 0);
+
+		sessionCounts = { 4, 3, 3 };
+		CHECK(NetworkSessionManager::PickReactor(sessionCounts) == 1);
+	}
+}
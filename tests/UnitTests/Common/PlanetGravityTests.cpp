@@ -0,0 +1,54 @@
+#include <CommonLib/Planet.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <vector>
+
+using namespace tsom;
+
+TEST_CASE("Planet up direction", "[Gravity]")
+{
+	Planet planet(1.f, 16.f, 9.81f);
+	Nz::Vector3f center = planet.GetCenter();
+
+	// More positions than a single batch, including the planet center and positions close to the inner box edges
+	std::vector<Nz::Vector3f> positions = {
+		center,
+		center + Nz::Vector3f(0.f, 100.f, 0.f),
+		center + Nz::Vector3f(0.f, -100.f, 0.f),
+		center + Nz::Vector3f(1.f, 0.f, 0.f),
+		center + Nz::Vector3f(16.f, 16.f, 16.f),
+		center + Nz::Vector3f(100.f, 90.f, -95.f),
+		center + Nz::Vector3f(-300.f, 2.f, 17.f)
+	};
+
+	for (int i = 0; i < 150; ++i)
+	{
+		float t = float(i);
+		positions.push_back(center + Nz::Vector3f(std::sin(t) * t, std::cos(t * 0.7f) * 2.f * t, (t - 75.f) * 1.5f));
+	}
+
+	std::vector<Nz::Vector3f> upDirections(positions.size());
+	planet.ComputeUpDirectionBatch(positions, upDirections);
+
+	for (std::size_t i = 0; i < positions.size(); ++i)
+	{
+		INFO("Position #" << i << ": " << positions[i]);
+
+		Nz::Vector3f expected = planet.ComputeUpDirection(positions[i]);
+		const Nz::Vector3f& upDirection = upDirections[i];
+
+		CHECK_FALSE(std::isnan(upDirection.x));
+		CHECK_FALSE(std::isnan(upDirection.y));
+		CHECK_FALSE(std::isnan(upDirection.z));
+
+		CHECK_THAT(upDirection.x, Catch::Matchers::WithinAbs(expected.x, 0.0001f));
+		CHECK_THAT(upDirection.y, Catch::Matchers::WithinAbs(expected.y, 0.0001f));
+		CHECK_THAT(upDirection.z, Catch::Matchers::WithinAbs(expected.z, 0.0001f));
+	}
+
+	SECTION("Center has no up direction")
+	{
+		CHECK(upDirections[0] == Nz::Vector3f::Zero());
+	}
+}
@@ -0,0 +1,123 @@
+#include <CommonLib/Utility/RingBuffer.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+using namespace tsom;
+
+TEST_CASE("Ring buffer", "[Utility]")
+{
+	RingBuffer<int, 4> ringBuffer;
+
+	SECTION("Empty buffer")
+	{
+		CHECK(ringBuffer.IsEmpty());
+		CHECK_FALSE(ringBuffer.IsFull());
+		CHECK(ringBuffer.GetSize() == 0);
+		CHECK(ringBuffer.GetCapacity() == 4);
+	}
+
+	SECTION("Values are popped in FIFO order")
+	{
+		ringBuffer.PushBack(1);
+		ringBuffer.PushBack(2);
+		ringBuffer.PushBack(3);
+
+		CHECK(ringBuffer.GetSize() == 3);
+		CHECK(ringBuffer.Front() == 1);
+		CHECK(ringBuffer.Back() == 3);
+		CHECK(ringBuffer[1] == 2);
+
+		CHECK(ringBuffer.PopFront() == 1);
+		CHECK(ringBuffer.PopFront() == 2);
+		CHECK(ringBuffer.PopFront() == 3);
+		CHECK(ringBuffer.IsEmpty());
+	}
+
+	SECTION("Full buffer")
+	{
+		for (int i = 0; i < 4; ++i)
+			ringBuffer.PushBack(i);
+
+		CHECK(ringBuffer.IsFull());
+		CHECK_FALSE(ringBuffer.IsEmpty());
+		CHECK(ringBuffer.GetSize() == 4);
+		CHECK(ringBuffer.Front() == 0);
+		CHECK(ringBuffer.Back() == 3);
+
+		// Freeing a single slot is enough to push again
+		CHECK(ringBuffer.PopFront() == 0);
+		CHECK_FALSE(ringBuffer.IsFull());
+
+		ringBuffer.PushBack(4);
+		CHECK(ringBuffer.IsFull());
+		CHECK(ringBuffer.Front() == 1);
+		CHECK(ringBuffer.Back() == 4);
+	}
+
+	SECTION("Wraparound")
+	{
+		// Move the first element around the whole storage several times
+		int nextPushed = 0;
+		int nextPopped = 0;
+		for (int i = 0; i < 10; ++i)
+		{
+			ringBuffer.PushBack(nextPushed++);
+			ringBuffer.PushBack(nextPushed++);
+			ringBuffer.PushBack(nextPushed++);
+
+			CHECK(ringBuffer.GetSize() == 3);
+			for (std::size_t j = 0; j < ringBuffer.GetSize(); ++j)
+			{
+				INFO("Iteration " << i << ", index " << j);
+				CHECK(ringBuffer[j] == nextPopped + static_cast<int>(j));
+			}
+
+			CHECK(ringBuffer.Back() == nextPushed - 1);
+
+			CHECK(ringBuffer.PopFront() == nextPopped++);
+			CHECK(ringBuffer.PopFront() == nextPopped++);
+			CHECK(ringBuffer.PopFront() == nextPopped++);
+			CHECK(ringBuffer.IsEmpty());
+		}
+	}
+
+	SECTION("Values can be modified in place")
+	{
+		ringBuffer.PushBack(1);
+		ringBuffer.PushBack(2);
+
+		ringBuffer.Front() = 10;
+		ringBuffer.Back() += 10;
+		ringBuffer[0] += 1;
+
+		CHECK(ringBuffer.PopFront() == 11);
+		CHECK(ringBuffer.PopFront() == 12);
+	}
+
+	SECTION("Clear")
+	{
+		for (int i = 0; i < 4; ++i)
+			ringBuffer.PushBack(i);
+
+		ringBuffer.Clear();
+		CHECK(ringBuffer.IsEmpty());
+		CHECK(ringBuffer.GetSize() == 0);
+
+		ringBuffer.PushBack(42);
+		CHECK(ringBuffer.Front() == 42);
+		CHECK(ringBuffer.Back() == 42);
+	}
+
+	SECTION("Move-only values")
+	{
+		RingBuffer<std::unique_ptr<int>, 2> pointerBuffer;
+		for (int i = 0; i < 5; ++i)
+		{
+			pointerBuffer.PushBack(std::make_unique<int>(i));
+
+			std::unique_ptr<int> value = pointerBuffer.PopFront();
+			REQUIRE(value);
+			CHECK(*value == i);
+		}
+	}
+}
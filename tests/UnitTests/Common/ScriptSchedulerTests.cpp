@@ -0,0 +1,158 @@
+#include <CommonLib/Scripting/ScriptProfiler.hpp>
+#include <CommonLib/Scripting/ScriptScheduler.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <entt/entt.hpp>
+
+using namespace tsom;
+
+TEST_CASE("Script scheduler", "[Scripting]")
+{
+	sol::state state;
+	state.open_libraries(sol::lib::base, sol::lib::coroutine);
+
+	ScriptProfiler profiler(state.lua_state());
+	ScriptScheduler scheduler(profiler);
+	scheduler.Register(state);
+
+	state["callCount"] = 0;
+	sol::protected_function incrementCallCount = state.load("callCount = callCount + 1").get<sol::protected_function>();
+
+	auto GetCallCount = [&] { return state.get<int>("callCount"); };
+
+	SECTION("Timers longer than the wheel wait for the right rotation")
+	{
+		constexpr Nz::UInt32 Delay = ScriptScheduler::WheelSize * 2 + 10;
+		scheduler.ScheduleTimer(incrementCallCount, Delay);
+
+		// The timer shares its slot with ticks 10 and 266, it must only fire on the last rotation
+		for (Nz::UInt32 i = 0; i < Delay - 1; ++i)
+			scheduler.Tick();
+
+		CHECK(GetCallCount() == 0);
+		CHECK(scheduler.GetPendingTaskCount() == 1);
+
+		scheduler.Tick();
+		CHECK(GetCallCount() == 1);
+		CHECK(scheduler.GetPendingTaskCount() == 0);
+	}
+
+	SECTION("Repeating timers keep their interval across rotations")
+	{
+		constexpr Nz::UInt32 Interval = 100;
+		scheduler.ScheduleTimer(incrementCallCount, Interval, Interval);
+
+		for (Nz::UInt32 i = 0; i < ScriptScheduler::WheelSize * 4; ++i)
+			scheduler.Tick();
+
+		CHECK(GetCallCount() == ScriptScheduler::WheelSize * 4 / Interval);
+		CHECK(scheduler.GetPendingTaskCount() == 1);
+	}
+
+	SECTION("A timer can cancel itself while firing")
+	{
+		state.script(R"(
+			timerId = Scheduler.Every(0, function()
+				callCount = callCount + 1
+				cancelled = Scheduler.Cancel(timerId)
+			end)
+		)");
+
+		CHECK(scheduler.GetPendingTaskCount() == 1);
+
+		for (Nz::UInt32 i = 0; i < ScriptScheduler::WheelSize + 1; ++i)
+			scheduler.Tick();
+
+		CHECK(GetCallCount() == 1);
+		CHECK(state.get<bool>("cancelled"));
+		CHECK(scheduler.GetPendingTaskCount() == 0);
+
+		// The task was freed, its id is not valid anymore even if its slot gets reused
+		ScriptScheduler::TaskId timerId = static_cast<ScriptScheduler::TaskId>(state.get<Nz::Int64>("timerId"));
+		scheduler.ScheduleTimer(incrementCallCount, 1);
+		CHECK_FALSE(scheduler.Cancel(timerId));
+		CHECK(scheduler.GetPendingTaskCount() == 1);
+	}
+
+	SECTION("A timer cancelled by another one firing on the same tick doesn't run")
+	{
+		// Timers of a slot run in scheduling order, the first one cancels the second one before it runs
+		scheduler.ScheduleTimer(state.load("cancelled = Scheduler.Cancel(otherTimerId)").get<sol::protected_function>(), 5);
+		state["otherTimerId"] = static_cast<Nz::Int64>(scheduler.ScheduleTimer(incrementCallCount, 5));
+
+		for (Nz::UInt32 i = 0; i < 10; ++i)
+			scheduler.Tick();
+
+		CHECK(state.get<bool>("cancelled"));
+		CHECK(GetCallCount() == 0);
+		CHECK(scheduler.GetPendingTaskCount() == 0);
+	}
+
+	SECTION("Coroutines spawned from a callback are subject to the budget")
+	{
+		profiler.SetCallbackBudget(Nz::Time::Milliseconds(10));
+
+		state.script(R"(
+			Scheduler.After(0, function()
+				Scheduler.Spawn(function()
+					while true do end
+				end)
+				callCount = callCount + 1
+			end)
+		)");
+
+		scheduler.Tick();
+
+		const ScriptProfiler::CallbackStats& coroutineStats = profiler.GetCallbackStats(profiler.RegisterCallback("scheduler", "coroutine"));
+		CHECK(coroutineStats.callCount == 1);
+		CHECK(coroutineStats.abortCount == 1);
+		CHECK(scheduler.GetPendingTaskCount() == 0);
+	}
+
+	SECTION("Tasks scheduled from an entity callback are cancelled with the entity")
+	{
+		entt::registry registry;
+		entt::handle entity(registry, registry.create());
+
+		state["otherCount"] = 0;
+		state["nestedCount"] = 0;
+		scheduler.ScheduleTimer(state.load("otherCount = otherCount + 1").get<sol::protected_function>(), 1, 1);
+
+		scheduler.RunAsOwner(entity, [&]
+		{
+			state.script(R"(
+				Scheduler.Every(0, function()
+					callCount = callCount + 1
+				end)
+
+				-- Tasks scheduled by an owned task belong to the same entity
+				Scheduler.After(0, function()
+					Scheduler.Every(0, function()
+						nestedCount = nestedCount + 1
+					end)
+				end)
+			)");
+		});
+
+		CHECK(!scheduler.GetCurrentOwner());
+		CHECK(scheduler.GetPendingTaskCount() == 3);
+
+		scheduler.Tick();
+		scheduler.Tick();
+
+		CHECK(GetCallCount() == 2);
+		CHECK(state.get<int>("nestedCount") == 1);
+		CHECK(state.get<int>("otherCount") == 2);
+		CHECK(scheduler.GetPendingTaskCount() == 3);
+
+		scheduler.CancelOwnedTasks(entity);
+		CHECK(scheduler.GetPendingTaskCount() == 1);
+
+		for (Nz::UInt32 i = 0; i < 10; ++i)
+			scheduler.Tick();
+
+		CHECK(GetCallCount() == 2);
+		CHECK(state.get<int>("nestedCount") == 1);
+		CHECK(state.get<int>("otherCount") == 12);
+		CHECK(scheduler.GetPendingTaskCount() == 1);
+	}
+}
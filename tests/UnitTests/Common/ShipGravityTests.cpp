@@ -0,0 +1,65 @@
+#include <CommonLib/CharacterController.hpp>
+#include <CommonLib/GameConstants.hpp>
+#include <CommonLib/InternalConstants.hpp>
+#include <CommonLib/PhysicsConstants.hpp>
+#include <CommonLib/Ship.hpp>
+#include <CommonLib/Physics/PhysicsSettings.hpp>
+#include <CommonLib/Systems/GravityPhysicsSystem.hpp>
+#include <Nazara/Core/EnttWorld.hpp>
+#include <Nazara/Core/Modules.hpp>
+#include <Nazara/Core/Components/NodeComponent.hpp>
+#include <Nazara/Physics3D/Collider3D.hpp>
+#include <Nazara/Physics3D/Physics3D.hpp>
+#include <Nazara/Physics3D/Components/PhysCharacter3DComponent.hpp>
+#include <Nazara/Physics3D/Systems/Physics3DSystem.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <memory>
+#include <utility>
+
+using namespace tsom;
+
+TEST_CASE("Ship gravity", "[Gravity]")
+{
+	Nz::Modules<Nz::Physics3D> nazara;
+
+	Ship ship(1.f);
+
+	// Same setup as a ship environment
+	Nz::EnttWorld world;
+
+	Nz::Physics3DSystem::Settings physSettings = Physics::BuildSettings();
+	physSettings.stepSize = Constants::TickDuration;
+
+	auto& physicsSystem = world.AddSystem<Nz::Physics3DSystem>(std::move(physSettings));
+	world.AddSystem<GravityPhysicsSystem>(ship, physicsSystem.GetPhysWorld());
+
+	SECTION("A character falls at ship gravity")
+	{
+		auto controller = std::make_shared<CharacterController>();
+		controller->SetGravityController(&ship);
+
+		// Nothing to stand on, the character is in free fall
+		Nz::PhysCharacter3DComponent::Settings characterSettings;
+		characterSettings.collider = std::make_shared<Nz::CapsuleCollider3D>(Constants::PlayerCapsuleHeight, Constants::PlayerColliderRadius);
+		characterSettings.objectLayer = Constants::ObjectLayerPlayer;
+
+		entt::handle entity = world.CreateEntity();
+		entity.emplace<Nz::NodeComponent>();
+
+		auto& characterComponent = entity.emplace<Nz::PhysCharacter3DComponent>(std::move(characterSettings));
+		characterComponent.SetImpl(controller);
+		characterComponent.DisableSleeping();
+
+		constexpr std::size_t TickCount = 30;
+		for (std::size_t i = 0; i < TickCount; ++i)
+			world.Update(Constants::TickDuration);
+
+		float elapsedTime = Constants::TickDuration.AsSeconds() * TickCount;
+		Nz::Vector3f velocity = characterComponent.GetLinearVelocity();
+
+		CHECK_THAT(velocity.y, Catch::Matchers::WithinAbs(-Constants::ShipGravityAcceleration * elapsedTime, 0.05f));
+		CHECK_THAT(velocity.x, Catch::Matchers::WithinAbs(0.f, 0.001f));
+		CHECK_THAT(velocity.z, Catch::Matchers::WithinAbs(0.f, 0.001f));
+	}
+}
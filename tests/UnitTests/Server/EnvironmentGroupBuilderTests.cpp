@@ -0,0 +1,55 @@
+#include <ServerLib/EnvironmentGroupBuilder.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+using namespace tsom;
+
+TEST_CASE("Environment groups", "[Server]")
+{
+	EnvironmentGroupBuilder groupBuilder;
+
+	auto GetGroup = [&](std::size_t groupIndex)
+	{
+		std::span<const std::size_t> group = groupBuilder.GetGroup(groupIndex);
+		return std::vector<std::size_t>(group.begin(), group.end());
+	};
+
+	SECTION("Unlinked environments are updated separately")
+	{
+		groupBuilder.Begin(3);
+		CHECK(groupBuilder.Build() == 3);
+		CHECK(GetGroup(0) == std::vector<std::size_t>{ 0 });
+		CHECK(GetGroup(1) == std::vector<std::size_t>{ 1 });
+		CHECK(GetGroup(2) == std::vector<std::size_t>{ 2 });
+	}
+
+	SECTION("Ship pilots merge their environment with the ship one, keeping environment order")
+	{
+		// Player in environment 4 pilots a ship living in environment 1, player in environment 3 pilots a ship in environment 4
+		groupBuilder.Begin(6);
+		groupBuilder.Link(4, 1);
+		groupBuilder.Link(3, 4);
+		CHECK(groupBuilder.Build() == 4);
+		CHECK(GetGroup(0) == std::vector<std::size_t>{ 0 });
+		CHECK(GetGroup(1) == std::vector<std::size_t>{ 1, 3, 4 });
+		CHECK(GetGroup(2) == std::vector<std::size_t>{ 2 });
+		CHECK(GetGroup(3) == std::vector<std::size_t>{ 5 });
+	}
+
+	SECTION("Groups are rebuilt from scratch each time")
+	{
+		groupBuilder.Begin(4);
+		groupBuilder.Link(0, 3);
+		groupBuilder.Link(1, 2);
+		CHECK(groupBuilder.Build() == 2);
+		CHECK(GetGroup(0) == std::vector<std::size_t>{ 0, 3 });
+		CHECK(GetGroup(1) == std::vector<std::size_t>{ 1, 2 });
+
+		groupBuilder.Begin(3);
+		groupBuilder.Link(2, 2);
+		CHECK(groupBuilder.Build() == 3);
+		CHECK(GetGroup(0) == std::vector<std::size_t>{ 0 });
+		CHECK(GetGroup(1) == std::vector<std::size_t>{ 1 });
+		CHECK(GetGroup(2) == std::vector<std::size_t>{ 2 });
+	}
+}
@@ -0,0 +1,87 @@
+#include <ServerLib/ServerRecorder.hpp>
+#include <ServerLib/ServerRecordingReader.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <filesystem>
+
+using namespace tsom;
+
+TEST_CASE("Server recording", "[Server]")
+{
+	std::filesystem::path recordingPath = std::filesystem::temp_directory_path() / "tsom_server_recording_test.rec";
+
+	Nz::Uuid uuid = Nz::Uuid::Generate();
+
+	std::array<Nz::UInt8, 3> firstPacketData = { 1, 2, 3 };
+	Nz::ByteArray firstPacket(firstPacketData.data(), firstPacketData.size());
+
+	std::array<Nz::UInt8, 1> secondPacketData = { 42 };
+	Nz::ByteArray secondPacket(secondPacketData.data(), secondPacketData.size());
+
+	// Events are recorded at the tick the server received them, OnTick ends the current tick
+	{
+		ServerRecorder recorder(recordingPath, 1337, recordingPath.parent_path() / "tsom_missing_save_directory");
+		recorder.RecordPlayerJoin(3, "Lynix", uuid, PlayerPermission::Admin, 7);
+		recorder.OnTick();
+
+		recorder.RecordPacket(3, firstPacket);
+		recorder.RecordPlayerJoin(5, "bot", std::nullopt, PlayerPermissionFlags{}, 8);
+		recorder.OnTick();
+		recorder.OnTick();
+
+		recorder.RecordPacket(5, secondPacket);
+		recorder.RecordPlayerLeave(3);
+
+		// Trailing ticks are kept as well
+		for (std::size_t i = 0; i < 300; ++i)
+			recorder.OnTick();
+
+		CHECK(recorder.GetTickCount() == 303);
+	}
+
+	ServerRecordingReader reader(recordingPath);
+	CHECK(reader.GetSeed() == 1337);
+
+	ServerRecordingReader::Event event;
+
+	reader.ReadEvent(event);
+	CHECK(event.type == ServerRecorder::EventType::PlayerJoin);
+	CHECK(event.tick == 0);
+	CHECK(event.peerId == 3);
+	CHECK(event.nickname == "Lynix");
+	CHECK(event.uuid == uuid);
+	CHECK(event.permissions == PlayerPermissionFlags(PlayerPermission::Admin));
+	CHECK(event.protocolVersion == 7);
+
+	reader.ReadEvent(event);
+	CHECK(event.type == ServerRecorder::EventType::Packet);
+	CHECK(event.tick == 1);
+	CHECK(event.peerId == 3);
+	CHECK(event.packet == firstPacket);
+
+	reader.ReadEvent(event);
+	CHECK(event.type == ServerRecorder::EventType::PlayerJoin);
+	CHECK(event.tick == 1);
+	CHECK(event.peerId == 5);
+	CHECK(event.nickname == "bot");
+	CHECK_FALSE(event.uuid.has_value());
+	CHECK(event.permissions == PlayerPermissionFlags{});
+	CHECK(event.protocolVersion == 8);
+
+	reader.ReadEvent(event);
+	CHECK(event.type == ServerRecorder::EventType::Packet);
+	CHECK(event.tick == 3);
+	CHECK(event.peerId == 5);
+	CHECK(event.packet == secondPacket);
+
+	reader.ReadEvent(event);
+	CHECK(event.type == ServerRecorder::EventType::PlayerLeave);
+	CHECK(event.tick == 3);
+	CHECK(event.peerId == 3);
+
+	reader.ReadEvent(event);
+	CHECK(event.type == ServerRecorder::EventType::End);
+	CHECK(event.tick == 303);
+
+	std::filesystem::remove(recordingPath);
+}
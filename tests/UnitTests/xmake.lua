@@ -6,7 +6,7 @@ target("UnitTests", function ()
         add_defines("CATCH_CONFIG_NO_POSIX_SIGNALS")
     end
 
-    add_deps("CommonLib")
+    add_deps("CommonLib", "ServerLib")
     add_packages("catch2")
     add_files("**.cpp")
 end)
@@ -255,6 +255,7 @@ target("TSOMGame", function ()
 	add_headerfiles("src/Game/**.hpp", "src/Game/**.inl")
 	add_files("src/Game/**.cpp")
 	add_installfiles("gameconfig.lua.default", { prefixdir = "bin" })
+	add_installfiles("(dictionaries/*.dict)", { prefixdir = "bin" })
 	add_installfiles("(scripts/**.lua)", { prefixdir = "bin" })
 
 	if is_plat("windows", "mingw") then
@@ -293,9 +294,25 @@ target("TSOMServer", function ()
 	add_headerfiles("src/Server/**.hpp", "src/Server/**.inl")
 	add_files("src/Server/**.cpp")
 	add_installfiles("serverconfig.lua.default", { prefixdir = "bin" })
+	add_installfiles("(dictionaries/*.dict)", { prefixdir = "bin" })
 	add_installfiles("(scripts/**.lua)", { prefixdir = "bin" })
 
 	add_rpathdirs("@executable_path")
 end)
 
+target("TSOMBot", function ()
+	set_group("Executable")
+	set_basename("ThisBotOfMine")
+	add_deps("CommonLib", "Main")
+	add_rules("inherit_version")
+
+	add_defines("TSOM_BOT_BUILD")
+
+	add_headerfiles("src/Bot/**.hpp", "src/Bot/**.inl")
+	add_files("src/Bot/**.cpp")
+	add_installfiles("(dictionaries/*.dict)", { prefixdir = "bin" })
+
+	add_rpathdirs("@executable_path")
+end)
+
 includes("tests/xmake.lua")
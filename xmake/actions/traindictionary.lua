@@ -0,0 +1,53 @@
+local dictionaries = {
+	chunkcontent = "ChunkContentDictionaryVersion",
+	chunksave = "ChunkSaveDictionaryVersion"
+}
+
+task("train-dictionary")
+
+set_menu({
+	-- Settings menu usage
+	usage = "xmake train-dictionary [options] samples",
+	description = "Train a LZ4 compression dictionary from a directory of representative samples (requires zstd)",
+	options =
+	{
+		{'t', "type", "kv", "chunkcontent", "Dictionary type", " - chunkcontent (raw block indices, used by ChunkReset)", " - chunksave (serialized chunks, used by ship saves)" },
+		{nil, "maxsize", "kv", "65536", "Maximum dictionary size (LZ4 only uses the last 64KiB)" },
+		{nil, "samples", "v", nil, "Directory containing one file per sample" }
+	}
+})
+
+on_run(function ()
+	import("core.base.option")
+	import("lib.detect.find_tool")
+
+	local dictType = option.get("type")
+	local versionConstant = dictionaries[dictType]
+	if not versionConstant then
+		os.raise("unknown dictionary type %s", dictType)
+	end
+
+	local sampleDir = option.get("samples")
+	if not sampleDir or not os.isdir(sampleDir) then
+		os.raise("missing sample directory")
+	end
+
+	-- Dictionaries are versioned with the protocol, fetch the current version from the constants
+	local constants = io.readfile("include/CommonLib/InternalConstants.hpp")
+	local version = constants:match(versionConstant .. "%s*=%s*(%d+)")
+	if not version then
+		os.raise("failed to find %s", versionConstant)
+	end
+
+	-- zstd dictionaries are raw content dictionaries, which LZ4 can use as-is
+	local zstd = find_tool("zstd")
+	if not zstd then
+		os.raise("zstd not found")
+	end
+
+	local outputFile = path.join("dictionaries", string.format("%s_v%s.dict", dictType, version))
+	os.mkdir("dictionaries")
+	os.execv(zstd.program, { "--train", "-r", sampleDir, "--maxdict=" .. option.get("maxsize"), "-o", outputFile })
+
+	print(string.format("%s written, remember to bump %s if this dictionary replaces a released one", outputFile, versionConstant))
+end)